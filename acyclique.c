@@ -0,0 +1,429 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2014, 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "acyclique.h"
+#include "ensemble.h"
+#include "outils.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <assert.h>
+
+typedef struct {
+	unsigned char lettre;
+	int fin;
+} Arc;
+
+typedef struct {
+	int final;
+	int nb_arcs;
+	int capacite_arcs;
+	Arc * arcs; //!< Triés par lettre croissante.
+	int nb_entrants; //!< Nombre de transitions qui mènent à l'état.
+	int enregistre; //!< 1 si l'état est dans le registre.
+	uint64_t empreinte; //!< Empreinte de l'état, calculée à l'enregistrement.
+} Etat_acyclique;
+
+struct Constructeur_acyclique {
+	int nb_etats; //!< Nombre de cases utilisées dans le tableau des états.
+	int capacite_etats;
+	Etat_acyclique * etats;
+	int nb_libres;
+	int * libres; //!< Cases des états détruits, à réutiliser.
+	// Registre des états minimisés : table de hachage à adressage ouvert,
+	// dont une case vaut -1 ou le numéro d'un état.
+	int taille_registre;
+	int capacite_registre; //!< Une puissance de 2.
+	int * registre;
+	// Le chemin du dernier mot ajouté : chemin[i] est l'état atteint après
+	// la lecture des i premières lettres. Les états chemin[0], ...,
+	// chemin[longueur_attente] ne sont pas dans le registre.
+	char * dernier;
+	int * chemin;
+	int capacite_chemin;
+	int longueur_attente;
+};
+
+static int nouvel_etat( Constructeur_acyclique * c ){
+	int e;
+	if( c->nb_libres > 0 ){
+		e = c->libres[ --c->nb_libres ];
+	}else{
+		if( c->nb_etats == c->capacite_etats ){
+			c->capacite_etats *= 2;
+			c->etats = xrealloc(
+				c->etats, sizeof(Etat_acyclique) * c->capacite_etats
+			);
+			c->libres = xrealloc( c->libres, sizeof(int) * c->capacite_etats );
+		}
+		e = c->nb_etats++;
+		c->etats[e].capacite_arcs = 0;
+		c->etats[e].arcs = NULL;
+	}
+	c->etats[e].final = 0;
+	c->etats[e].nb_arcs = 0;
+	c->etats[e].nb_entrants = 0;
+	c->etats[e].enregistre = 0;
+	return e;
+}
+
+static void detruire_etat( Constructeur_acyclique * c, int e ){
+	Etat_acyclique * etat = &c->etats[e];
+	int i;
+	assert( ! etat->enregistre );
+	for( i=0; i<etat->nb_arcs; i++ ){
+		c->etats[ etat->arcs[i].fin ].nb_entrants--;
+	}
+	etat->nb_arcs = 0;
+	c->libres[ c->nb_libres++ ] = e;
+}
+
+/*
+ * Renvoie l'indice de l'arc qui part de l'état e avec la lettre, ou bien
+ * -1-i si l'arc n'existe pas et doit être inséré à l'indice i.
+ */
+static int trouver_arc( const Constructeur_acyclique * c, int e, unsigned char lettre ){
+	const Etat_acyclique * etat = &c->etats[e];
+	int debut = 0, fin = etat->nb_arcs;
+	while( debut < fin ){
+		int milieu = ( debut + fin ) / 2;
+		if( etat->arcs[milieu].lettre < lettre ){
+			debut = milieu + 1;
+		}else{
+			fin = milieu;
+		}
+	}
+	if( debut < etat->nb_arcs && etat->arcs[debut].lettre == lettre ){
+		return debut;
+	}
+	return -1 - debut;
+}
+
+static void ajouter_arc(
+	Constructeur_acyclique * c, int e, unsigned char lettre, int fin
+){
+	int i = -1 - trouver_arc( c, e, lettre );
+	Etat_acyclique * etat = &c->etats[e];
+	assert( i >= 0 );
+	if( etat->nb_arcs == etat->capacite_arcs ){
+		etat->capacite_arcs = etat->capacite_arcs ? 2 * etat->capacite_arcs : 1;
+		etat->arcs = xrealloc( etat->arcs, sizeof(Arc) * etat->capacite_arcs );
+	}
+	memmove(
+		&etat->arcs[i+1], &etat->arcs[i], sizeof(Arc) * ( etat->nb_arcs - i )
+	);
+	etat->arcs[i].lettre = lettre;
+	etat->arcs[i].fin = fin;
+	etat->nb_arcs++;
+	c->etats[fin].nb_entrants++;
+}
+
+static void rediriger_arc(
+	Constructeur_acyclique * c, int e, unsigned char lettre, int fin
+){
+	int i = trouver_arc( c, e, lettre );
+	Arc * arc = &c->etats[e].arcs[i];
+	assert( i >= 0 );
+	c->etats[ arc->fin ].nb_entrants--;
+	arc->fin = fin;
+	c->etats[fin].nb_entrants++;
+}
+
+static int cloner_etat( Constructeur_acyclique * c, int e ){
+	int clone = nouvel_etat( c );
+	int i;
+	for( i=0; i<c->etats[e].nb_arcs; i++ ){
+		Arc arc = c->etats[e].arcs[i];
+		ajouter_arc( c, clone, arc.lettre, arc.fin );
+	}
+	c->etats[clone].final = c->etats[e].final;
+	return clone;
+}
+
+/*
+ * Deux états sont équivalents s'ils ont la même finalité et les mêmes arcs :
+ * leurs successeurs sont déjà minimisés.
+ */
+static uint64_t empreinte_etat( const Etat_acyclique * etat ){
+	uint64_t h = empreinte_element( etat->final );
+	int i;
+	for( i=0; i<etat->nb_arcs; i++ ){
+		h = empreinte_element(
+			(intptr_t) ( h + ( (uint64_t) etat->arcs[i].lettre << 32 )
+				+ (uint64_t) etat->arcs[i].fin )
+		);
+	}
+	return h;
+}
+
+static int sont_equivalents_etats(
+	const Etat_acyclique * etat_1, const Etat_acyclique * etat_2
+){
+	int i;
+	if( etat_1->final != etat_2->final || etat_1->nb_arcs != etat_2->nb_arcs ){
+		return 0;
+	}
+	for( i=0; i<etat_1->nb_arcs; i++ ){
+		if(
+			etat_1->arcs[i].lettre != etat_2->arcs[i].lettre
+			|| etat_1->arcs[i].fin != etat_2->arcs[i].fin
+		){
+			return 0;
+		}
+	}
+	return 1;
+}
+
+static void agrandir_registre( Constructeur_acyclique * c ){
+	int * registre = c->registre;
+	int capacite = c->capacite_registre;
+	int masque, i;
+
+	c->capacite_registre *= 2;
+	masque = c->capacite_registre - 1;
+	c->registre = xmalloc( sizeof(int) * c->capacite_registre );
+	for( i=0; i<c->capacite_registre; i++ ){
+		c->registre[i] = -1;
+	}
+	for( i=0; i<capacite; i++ ){
+		if( registre[i] != -1 ){
+			int j = c->etats[ registre[i] ].empreinte & masque;
+			while( c->registre[j] != -1 ){
+				j = ( j + 1 ) & masque;
+			}
+			c->registre[j] = registre[i];
+		}
+	}
+	xfree( registre );
+}
+
+/*
+ * Renvoie l'état du registre équivalent à l'état e s'il en existe un.
+ * Sinon, ajoute e au registre et le renvoie.
+ */
+static int remplacer_ou_enregistrer( Constructeur_acyclique * c, int e ){
+	Etat_acyclique * etat = &c->etats[e];
+	int masque = c->capacite_registre - 1;
+	int i;
+
+	etat->empreinte = empreinte_etat( etat );
+	for(
+		i = etat->empreinte & masque;
+		c->registre[i] != -1;
+		i = ( i + 1 ) & masque
+	){
+		Etat_acyclique * autre = &c->etats[ c->registre[i] ];
+		if( autre->empreinte == etat->empreinte
+			&& sont_equivalents_etats( autre, etat )
+		){
+			return c->registre[i];
+		}
+	}
+	c->registre[i] = e;
+	etat->enregistre = 1;
+	if( 2 * ++c->taille_registre > c->capacite_registre ){
+		agrandir_registre( c );
+	}
+	return e;
+}
+
+/*
+ * Retire un état du registre, en décalant les cases suivantes de la même
+ * séquence de sondage pour ne pas y laisser de trou.
+ */
+static void desenregistrer( Constructeur_acyclique * c, int e ){
+	int masque = c->capacite_registre - 1;
+	int i = c->etats[e].empreinte & masque;
+	int j;
+
+	while( c->registre[i] != e ){
+		i = ( i + 1 ) & masque;
+	}
+	for( j = ( i + 1 ) & masque; c->registre[j] != -1; j = ( j + 1 ) & masque ){
+		int k = c->etats[ c->registre[j] ].empreinte & masque;
+		// La case j peut combler le trou i si sa case d'origine k n'est pas
+		// strictement entre i et j (dans l'ordre cyclique).
+		if( i <= j ? ( k <= i || k > j ) : ( k <= i && k > j ) ){
+			c->registre[i] = c->registre[j];
+			i = j;
+		}
+	}
+	c->registre[i] = -1;
+	c->etats[e].enregistre = 0;
+	c->taille_registre--;
+}
+
+/*
+ * Minimise les états chemin[longueur_attente], ..., chemin[k+1] du chemin
+ * du dernier mot, du plus profond au moins profond.
+ */
+static void minimiser_chemin( Constructeur_acyclique * c, int k ){
+	int i;
+	for( i = c->longueur_attente; i > k; i-- ){
+		int e = c->chemin[i];
+		int r = remplacer_ou_enregistrer( c, e );
+		if( r != e ){
+			rediriger_arc( c, c->chemin[i-1], c->dernier[i-1], r );
+			detruire_etat( c, e );
+			c->chemin[i] = r;
+		}
+	}
+	if( k < c->longueur_attente ){
+		c->longueur_attente = k;
+	}
+}
+
+Constructeur_acyclique * creer_constructeur_acyclique(){
+	Constructeur_acyclique * res = xmalloc( sizeof(Constructeur_acyclique) );
+	int i;
+	res->nb_etats = 0;
+	res->capacite_etats = 16;
+	res->etats = xmalloc( sizeof(Etat_acyclique) * res->capacite_etats );
+	res->nb_libres = 0;
+	res->libres = xmalloc( sizeof(int) * res->capacite_etats );
+	res->taille_registre = 0;
+	res->capacite_registre = 16;
+	res->registre = xmalloc( sizeof(int) * res->capacite_registre );
+	for( i=0; i<res->capacite_registre; i++ ){
+		res->registre[i] = -1;
+	}
+	res->capacite_chemin = 16;
+	res->dernier = xmalloc( res->capacite_chemin );
+	res->dernier[0] = '\0';
+	res->chemin = xmalloc( sizeof(int) * res->capacite_chemin );
+	res->chemin[0] = nouvel_etat( res );
+	res->longueur_attente = 0;
+	return res;
+}
+
+void liberer_constructeur_acyclique( Constructeur_acyclique * constructeur ){
+	int i;
+	assert( constructeur );
+	for( i=0; i<constructeur->nb_etats; i++ ){
+		xfree( constructeur->etats[i].arcs );
+	}
+	xfree( constructeur->etats );
+	xfree( constructeur->libres );
+	xfree( constructeur->registre );
+	xfree( constructeur->dernier );
+	xfree( constructeur->chemin );
+	xfree( constructeur );
+}
+
+int ajouter_mot_acyclique(
+	Constructeur_acyclique * constructeur, const char * mot
+){
+	Constructeur_acyclique * c = constructeur;
+	int n = strlen( mot );
+	int k, i;
+
+	// Seuls les états du chemin qui ne sont pas sur celui du nouveau mot
+	// sont minimisés. Si les mots sont triés, ils ne changeront plus.
+	for( k=0; k < c->longueur_attente && mot[k] == c->dernier[k]; k++ );
+	minimiser_chemin( c, k );
+
+	if( n + 1 > c->capacite_chemin ){
+		while( n + 1 > c->capacite_chemin ){
+			c->capacite_chemin *= 2;
+		}
+		c->dernier = xrealloc( c->dernier, c->capacite_chemin );
+		c->chemin = xrealloc( c->chemin, sizeof(int) * c->capacite_chemin );
+	}
+	memcpy( c->dernier, mot, n + 1 );
+
+	// Au-delà du chemin en attente, on suit les transitions existantes.
+	int attente = c->longueur_attente;
+	for( k = attente; k < n; k++ ){
+		int a = trouver_arc( c, c->chemin[k], mot[k] );
+		if( a < 0 ) break;
+		c->chemin[k+1] = c->etats[ c->chemin[k] ].arcs[a].fin;
+	}
+	if( k == n && c->etats[ c->chemin[n] ].final ){
+		return 0;
+	}
+
+	// Les états du préfixe commun vont changer. Un état qui n'est atteint que
+	// par le chemin est retiré du registre ; un état partagé est dupliqué,
+	// ce qui rend partagés tous ses successeurs sur le chemin.
+	for( i = attente + 1; i <= k; i++ ){
+		int e = c->chemin[i];
+		if( c->etats[e].nb_entrants > 1 ){
+			int clone = cloner_etat( c, e );
+			rediriger_arc( c, c->chemin[i-1], mot[i-1], clone );
+			c->chemin[i] = clone;
+		}else{
+			desenregistrer( c, e );
+		}
+	}
+	for( i = k; i < n; i++ ){
+		int e = nouvel_etat( c );
+		ajouter_arc( c, c->chemin[i], mot[i], e );
+		c->chemin[i+1] = e;
+	}
+	c->etats[ c->chemin[n] ].final = 1;
+	c->longueur_attente = n;
+	return 1;
+}
+
+int nombre_etats_acyclique( const Constructeur_acyclique * constructeur ){
+	return constructeur->nb_etats - constructeur->nb_libres;
+}
+
+Automate * automate_acyclique( Constructeur_acyclique * constructeur ){
+	Constructeur_acyclique * c = constructeur;
+	Automate * res = creer_automate();
+	int * numeros;
+	int * file;
+	int debut = 0, fin = 0;
+	int i;
+
+	minimiser_chemin( c, 0 );
+
+	numeros = xmalloc( sizeof(int) * c->nb_etats );
+	file = xmalloc( sizeof(int) * c->nb_etats );
+	for( i=0; i<c->nb_etats; i++ ){
+		numeros[i] = -1;
+	}
+	numeros[ c->chemin[0] ] = 0;
+	file[ fin++ ] = c->chemin[0];
+	while( debut < fin ){
+		int e = file[ debut ];
+		const Etat_acyclique * etat = &c->etats[e];
+		ajouter_etat( res, debut );
+		if( etat->final ){
+			ajouter_etat_final( res, debut );
+		}
+		for( i=0; i<etat->nb_arcs; i++ ){
+			int f = etat->arcs[i].fin;
+			if( numeros[f] == -1 ){
+				numeros[f] = fin;
+				file[ fin++ ] = f;
+			}
+			ajouter_transition( res, debut, etat->arcs[i].lettre, numeros[f] );
+		}
+		debut++;
+	}
+	ajouter_etat_initial( res, 0 );
+
+	xfree( numeros );
+	xfree( file );
+	return res;
+}
@@ -0,0 +1,101 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2014, 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file acyclique.h */
+
+#ifndef __ACYCLIQUE_H__
+#define __ACYCLIQUE_H__
+
+#include "automate.h"
+
+#pragma GCC visibility push(default)
+
+/**
+ * @brief Le type d'un constructeur d'automate acyclique minimal.
+ *
+ * Le constructeur construit, mot après mot, l'automate déterministe minimal
+ * qui reconnaît un ensemble fini de mots, sans jamais construire l'arbre
+ * préfixe de ces mots (algorithme de Daciuk, Mihov, Watson et Watson).
+ * Il maintient un registre des états déjà minimisés : un état dont tous les
+ * successeurs sont minimisés est fusionné avec l'état équivalent du
+ * registre s'il en existe un, et il y est ajouté sinon. Seuls les états du
+ * chemin du dernier mot ajouté ne sont pas encore minimisés.
+ *
+ * Les mots peuvent être ajoutés dans n'importe quel ordre :
+ *  - si les mots sont ajoutés par ordre lexicographique croissant (celui de
+ *    strcmp()), chaque ajout se fait en temps linéaire en la longueur du mot,
+ *    sans dupliquer aucun état ;
+ *  - sinon, les états partagés du chemin du nouveau mot sont d'abord
+ *    dupliqués, puis minimisés à nouveau.
+ */
+typedef struct Constructeur_acyclique Constructeur_acyclique;
+
+/**
+ * @brief Crée un constructeur, qui ne reconnaît encore aucun mot.
+ *
+ * @return Le constructeur.
+ */
+Constructeur_acyclique * creer_constructeur_acyclique();
+
+/**
+ * @brief Détruit un constructeur.
+ *
+ * @param constructeur Le constructeur à détruire.
+ */
+void liberer_constructeur_acyclique( Constructeur_acyclique * constructeur );
+
+/**
+ * @brief Ajoute un mot à l'ensemble des mots reconnus.
+ *
+ * @param constructeur Un constructeur.
+ * @param mot Le mot à ajouter.
+ * @return 1 si le mot a été ajouté, 0 s'il était déjà reconnu.
+ */
+int ajouter_mot_acyclique(
+	Constructeur_acyclique * constructeur, const char * mot
+);
+
+/**
+ * @brief Renvoie le nombre d'états utilisés par le constructeur.
+ *
+ * @param constructeur Un constructeur.
+ * @return Le nombre d'états.
+ */
+int nombre_etats_acyclique( const Constructeur_acyclique * constructeur );
+
+/**
+ * @brief Renvoie l'automate minimal qui reconnaît les mots ajoutés.
+ *
+ * Les états de l'automate sont numérotés de 0 à n-1 dans l'ordre d'un
+ * parcours en largeur (lettres dans l'ordre croissant) depuis l'état
+ * initial, qui porte donc le numéro 0. Si aucun mot n'a été ajouté,
+ * l'automate n'a qu'un état, initial et non final.
+ *
+ * Le chemin du dernier mot est minimisé : d'autres mots peuvent ensuite être
+ * ajoutés au constructeur.
+ *
+ * @param constructeur Un constructeur.
+ * @return L'automate minimal.
+ */
+Automate * automate_acyclique( Constructeur_acyclique * constructeur );
+
+#pragma GCC visibility pop
+
+#endif
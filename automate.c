@@ -18,13 +18,19 @@
  *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#define ETIQUETTE_ALLOCATIONS ETIQUETTE_AUTOMATE
+
 #include "automate.h"
 #include "table.h"
 #include "ensemble.h"
 #include "outils.h"
 #include "fifo.h"
+#include "statistiques.h"
+#include "automate_compile.h"
+#include "parallele.h"
 
 #include <search.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -97,14 +103,23 @@ Cle * copier_cle( const Cle* cle ){
 	return creer_cle( cle->origine, cle->lettre );
 }
 
+intptr_t cle_transition( int origine, char lettre ){
+	return (intptr_t) origine * 256 + ( (int) lettre + 128 );
+}
+
+void lire_cle_transition( intptr_t cle, Cle * res ){
+	int lettre = (int) ( ( cle % 256 + 256 ) % 256 );
+	res->origine = (int) ( ( cle - lettre ) / 256 );
+	res->lettre = lettre - 128;
+}
+
 Automate * creer_automate(){
 	Automate * automate = xmalloc( sizeof(Automate) );
 	automate->etats = creer_ensemble( NULL, NULL, NULL );
 	automate->alphabet = creer_ensemble( NULL, NULL, NULL );
-	automate->transitions = creer_table(
-		( int(*)(const intptr_t, const intptr_t) ) comparer_cle , 
-		( intptr_t (*)( const intptr_t ) ) copier_cle,
-		( void(*)(intptr_t) ) supprimer_cle
+	automate->transitions = creer_table_persistante(
+		( intptr_t (*)( const intptr_t ) ) partager_ensemble,
+		( void(*)(intptr_t) ) liberer_ensemble
 	);
 	automate->initiaux = creer_ensemble( NULL, NULL, NULL );
 	automate->finaux = creer_ensemble( NULL, NULL, NULL );
@@ -149,23 +164,22 @@ Automate * translater_automate_entier( const Automate* automate, int translation
 		ajouter_lettre( res, (char) get_element( it ) );
 	}
 
-	Table_iterateur it1;
+	Parcours_table_persistante parcours;
+	intptr_t cle, valeur;
 	Ensemble_iterateur it2;
-	for(
-		it1 = premier_iterateur_table( automate->transitions );
-		! iterateur_est_vide( it1 );
-		it1 = iterateur_suivant_table( it1 )
-	){
-		Cle * cle = (Cle*) get_cle( it1 );
-		Ensemble * fins = (Ensemble*) get_valeur( it1 );
+	commencer_parcours_table_persistante( &parcours, automate->transitions );
+	while( entree_suivante_table_persistante( &parcours, &cle, &valeur ) ){
+		Cle origine;
+		lire_cle_transition( cle, &origine );
 		for(
-			it2 = premier_iterateur_ensemble( fins );
+			it2 = premier_iterateur_ensemble( (Ensemble*) valeur );
 			! iterateur_ensemble_est_vide( it2 );
 			it2 = iterateur_suivant_ensemble( it2 )
 		){
 			int fin = get_element( it2 );
 			ajouter_transition(
-				res, cle->origine + translation, cle->lettre, fin + translation
+				res, origine.origine + translation, origine.lettre,
+				fin + translation
 			);
 		}
 	};
@@ -179,10 +193,8 @@ void liberer_automate( Automate * automate ){
 	liberer_ensemble( automate->vide );
 	liberer_ensemble( automate->finaux );
 	liberer_ensemble( automate->initiaux );
-	pour_toute_valeur_table(
-		automate->transitions, ( void(*)(intptr_t) ) liberer_ensemble
-	);
-	liberer_table( automate->transitions );
+	// Les ensembles d'arrivée appartiennent à la table des transitions.
+	liberer_table_persistante( automate->transitions );
 	liberer_ensemble( automate->alphabet );
 	liberer_ensemble( automate->etats );
 	xfree(automate);
@@ -204,6 +216,10 @@ const Ensemble * get_alphabet( const Automate* automate ){
 	return automate->alphabet;
 }
 
+/*
+ * Les ajouts qui ne changent pas le contenu d'un ensemble ne le détachent 
+ * pas de ses clones : voir ajouter_element().
+ */
 void ajouter_etat( Automate * automate, int etat ){
 	ajouter_element( automate->etats, etat );
 }
@@ -219,17 +235,22 @@ void ajouter_transition(
 	ajouter_etat( automate, fin );
 	ajouter_lettre( automate, lettre );
 
-	Cle cle;
-	initialiser_cle( &cle, origine, lettre );
-	Table_iterateur it = trouver_table( automate->transitions, (intptr_t) &cle );
-	Ensemble * ens;
-	if( iterateur_est_vide( it ) ){
-		ens = creer_ensemble( NULL, NULL, NULL );
-		add_table( automate->transitions, (intptr_t) &cle, (intptr_t) ens );
+	// Sur un clone, seuls les noeuds partagés du chemin qui mène à la clé
+	// sont copiés, puis l'ensemble d'arrivée lors de son ajout.
+	intptr_t cle = cle_transition( origine, lettre );
+	intptr_t fins;
+	if( trouver_table_persistante( automate->transitions, cle, &fins ) ){
+		if( ! est_dans_l_ensemble( (Ensemble*) fins, fin ) ){
+			intptr_t * valeur = modifier_valeur_table_persistante(
+				automate->transitions, cle
+			);
+			ajouter_element( (Ensemble*) *valeur, fin );
+		}
 	}else{
-		ens = (Ensemble*) get_valeur( it );
+		Ensemble * ens = creer_ensemble( NULL, NULL, NULL );
+		ajouter_element( ens, fin );
+		ajouter_table_persistante( automate->transitions, cle, (intptr_t) ens );
 	}
-	ajouter_element( ens, fin );
 }
 
 void ajouter_etat_final(
@@ -247,11 +268,14 @@ void ajouter_etat_initial(
 }
 
 const Ensemble * voisins( const Automate* automate, int origine, char lettre ){
-	Cle cle;
-	initialiser_cle( &cle, origine, lettre );
-	Table_iterateur it = trouver_table( automate->transitions, (intptr_t) &cle );
-	if( ! iterateur_est_vide( it ) ){
-		return (Ensemble*) get_valeur( it );
+	intptr_t fins;
+	COMPTER_OPERATION( sondes_arbres, 1 );
+	if(
+		trouver_table_persistante(
+			automate->transitions, cle_transition( origine, lettre ), &fins
+		)
+	){
+		return (Ensemble*) fins;
 	}else{
 		return automate->vide;
 	}
@@ -279,25 +303,141 @@ Ensemble * delta(
 		const Ensemble * fins = voisins(
 			automate, get_element( it ), lettre
 		);
+		COMPTER_OPERATION( transitions_parcourues, taille_ensemble( fins ) );
 		ajouter_elements( res, fins );
 	}
 
 	return res;
 }
 
+struct Tampons_etats {
+	int * courants;
+	int * suivants;
+	int capacite;
+};
+
+Tampons_etats * creer_tampons_etats(){
+	Tampons_etats * res = xmalloc( sizeof(Tampons_etats) );
+	res->courants = NULL;
+	res->suivants = NULL;
+	res->capacite = 0;
+	return res;
+}
+
+void liberer_tampons_etats( Tampons_etats * tampons ){
+	xfree( tampons->courants );
+	xfree( tampons->suivants );
+	xfree( tampons );
+}
+
+/*
+ * Les tampons utilisés par delta_star() et le_mot_est_reconnu(). Leur taille
+ * est celle du plus grand ensemble d'états rencontré par le thread. Ils sont
+ * rangés dans une clé de thread, dont le destructeur les libère quand le 
+ * thread se termine.
+ */
+static pthread_key_t cle_tampons_locaux;
+static pthread_once_t cle_tampons_locaux_creee = PTHREAD_ONCE_INIT;
+
+static void detruire_tampons_locaux( void * tampons ){
+	liberer_tampons_etats( (Tampons_etats *) tampons );
+}
+
+static void creer_cle_tampons_locaux( void ){
+	if( pthread_key_create( &cle_tampons_locaux, detruire_tampons_locaux ) ){
+		ERREUR( "Impossible de créer la clé des tampons de lecture" );
+	}
+}
+
+static Tampons_etats * tampons_locaux( void ){
+	pthread_once( &cle_tampons_locaux_creee, creer_cle_tampons_locaux );
+	Tampons_etats * res = pthread_getspecific( cle_tampons_locaux );
+	if( ! res ){
+		res = creer_tampons_etats();
+		pthread_setspecific( cle_tampons_locaux, res );
+	}
+	return res;
+}
+
+static void reserver_tampons( Tampons_etats * tampons, int taille ){
+	if( taille <= tampons->capacite ) return;
+	int capacite = tampons->capacite ? tampons->capacite : 16;
+	while( capacite < taille ){
+		capacite *= 2;
+	}
+	tampons->courants = xrealloc( tampons->courants, sizeof(int) * capacite );
+	tampons->suivants = xrealloc( tampons->suivants, sizeof(int) * capacite );
+	tampons->capacite = capacite;
+}
+
+static int comparer_etats( const void * a, const void * b ){
+	int x = *(const int *) a;
+	int y = *(const int *) b;
+	return ( x > y ) - ( x < y );
+}
+
+const int * delta_star_tampons(
+	const Automate* automate, const Ensemble * etats_courants, const char* mot,
+	Tampons_etats * tampons, int * nb_etats
+){
+	int nb = 0;
+	Ensemble_iterateur it;
+
+	reserver_tampons( tampons, taille_ensemble( etats_courants ) );
+	for(
+		it = premier_iterateur_ensemble( etats_courants );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		tampons->courants[nb++] = get_element( it );
+	}
+
+	for( ; *mot && nb > 0; mot++ ){
+		int nb_suivants = 0;
+		int i;
+		for( i=0; i<nb; i++ ){
+			const Ensemble * fins = voisins( automate, tampons->courants[i], *mot );
+			reserver_tampons( tampons, nb_suivants + taille_ensemble( fins ) );
+			for(
+				it = premier_iterateur_ensemble( fins );
+				! iterateur_ensemble_est_vide( it );
+				it = iterateur_suivant_ensemble( it )
+			){
+				tampons->suivants[nb_suivants++] = get_element( it );
+			}
+		}
+		// Les fins issues d'un seul état sont déjà triées et sans doublons.
+		if( nb > 1 && nb_suivants > 1 ){
+			qsort( tampons->suivants, nb_suivants, sizeof(int), comparer_etats );
+			int j = 0;
+			for( i=1; i<nb_suivants; i++ ){
+				if( tampons->suivants[i] != tampons->suivants[j] ){
+					tampons->suivants[++j] = tampons->suivants[i];
+				}
+			}
+			nb_suivants = j + 1;
+		}
+		int * tmp = tampons->courants;
+		tampons->courants = tampons->suivants;
+		tampons->suivants = tmp;
+		nb = nb_suivants;
+	}
+	*nb_etats = nb;
+	return tampons->courants;
+}
+
 Ensemble * delta_star(
 	const Automate* automate, const Ensemble * etats_courants, const char* mot
 ){
-	int len = strlen( mot );
-	int i;
-	Ensemble * old = copier_ensemble( etats_courants );
-	Ensemble * new = old;
-	for( i=0; i<len; i++ ){
-		new = delta( automate, old, *(mot+i) );
-		liberer_ensemble( old );
-		old = new;
+	int nb, i;
+	const int * etats = delta_star_tampons(
+		automate, etats_courants, mot, tampons_locaux(), &nb
+	);
+	Ensemble * res = creer_ensemble( NULL, NULL, NULL );
+	for( i=0; i<nb; i++ ){
+		ajouter_element( res, etats[i] );
 	}
-	return new;
+	return res;
 }
 
 void pour_toute_transition(
@@ -305,79 +445,49 @@ void pour_toute_transition(
 	void (* action )( int origine, char lettre, int fin, void* data ),
 	void* data
 ){
-	Table_iterateur it1;
+	Parcours_table_persistante parcours;
+	intptr_t cle, valeur;
 	Ensemble_iterateur it2;
-	for(
-		it1 = premier_iterateur_table( automate->transitions );
-		! iterateur_est_vide( it1 );
-		it1 = iterateur_suivant_table( it1 )
-	){
-		Cle * cle = (Cle*) get_cle( it1 );
-		Ensemble * fins = (Ensemble*) get_valeur( it1 );
+	commencer_parcours_table_persistante( &parcours, automate->transitions );
+	while( entree_suivante_table_persistante( &parcours, &cle, &valeur ) ){
+		Cle origine;
+		lire_cle_transition( cle, &origine );
 		for(
-			it2 = premier_iterateur_ensemble( fins );
+			it2 = premier_iterateur_ensemble( (Ensemble*) valeur );
 			! iterateur_ensemble_est_vide( it2 );
 			it2 = iterateur_suivant_ensemble( it2 )
 		){
 			int fin = get_element( it2 );
-			action( cle->origine, cle->lettre, fin, data );
+			COMPTER_OPERATION( transitions_parcourues, 1 );
+			action( origine.origine, origine.lettre, fin, data );
 		}
 	};
 }
 
 Automate* copier_automate( const Automate* automate ){
-	Automate * res = creer_automate();
-	Ensemble_iterateur it1;
-	// On ajoute les états de l'automate
-	for(
-		it1 = premier_iterateur_ensemble( get_etats( automate ) );
-		! iterateur_ensemble_est_vide( it1 );
-		it1 = iterateur_suivant_ensemble( it1 )
-	){
-		ajouter_etat( res, get_element( it1 ) );
-	}
-	// On ajoute les états initiaux
-	for(
-		it1 = premier_iterateur_ensemble( get_initiaux( automate ) );
-		! iterateur_ensemble_est_vide( it1 );
-		it1 = iterateur_suivant_ensemble( it1 )
-	){
-		ajouter_etat_initial( res, get_element( it1 ) );
-	}
-	// On ajoute les états finaux
-	for(
-		it1 = premier_iterateur_ensemble( get_finaux( automate ) );
-		! iterateur_ensemble_est_vide( it1 );
-		it1 = iterateur_suivant_ensemble( it1 )
-	){
-		ajouter_etat_final( res, get_element( it1 ) );
-	}
-	// On ajoute les lettres
-	for(
-		it1 = premier_iterateur_ensemble( get_alphabet( automate ) );
-		! iterateur_ensemble_est_vide( it1 );
-		it1 = iterateur_suivant_ensemble( it1 )
-	){
-		ajouter_lettre( res, (char) get_element( it1 ) );
-	}
-	// On ajoute les transitions
-	Table_iterateur it2;
-	for(
-		it2 = premier_iterateur_table( automate->transitions );
-		! iterateur_est_vide( it2 );
-		it2 = iterateur_suivant_table( it2 )
-	){
-		Cle * cle = (Cle*) get_cle( it2 );
-		Ensemble * fins = (Ensemble*) get_valeur( it2 );
-		for(
-			it1 = premier_iterateur_ensemble( fins );
-			! iterateur_ensemble_est_vide( it1 );
-			it1 = iterateur_suivant_ensemble( it1 )
-		){
-			int fin = get_element( it1 );
-			ajouter_transition( res, cle->origine, cle->lettre, fin );
-		}
-	}
+	// Chaque ensemble, comme la table des transitions, est copié d'un seul
+	// parcours, sans réinsertion.
+	Automate * res = xmalloc( sizeof(Automate) );
+	res->vide = creer_ensemble( NULL, NULL, NULL );
+	res->etats = copier_ensemble( get_etats( automate ) );
+	res->alphabet = copier_ensemble( get_alphabet( automate ) );
+	res->transitions = copier_table_persistante(
+		automate->transitions,
+		( intptr_t (*)( const intptr_t ) ) copier_ensemble
+	);
+	res->initiaux = copier_ensemble( get_initiaux( automate ) );
+	res->finaux = copier_ensemble( get_finaux( automate ) );
+	return res;
+}
+
+Automate* cloner_automate( const Automate* automate ){
+	Automate * res = xmalloc( sizeof(Automate) );
+	res->vide = partager_ensemble( automate->vide );
+	res->etats = partager_ensemble( get_etats( automate ) );
+	res->alphabet = partager_ensemble( get_alphabet( automate ) );
+	res->transitions = partager_table_persistante( automate->transitions );
+	res->initiaux = partager_ensemble( get_initiaux( automate ) );
+	res->finaux = partager_ensemble( get_finaux( automate ) );
 	return res;
 }
 
@@ -398,6 +508,104 @@ Automate * translater_automate(
 	
 }
 
+Vue_automate vue_automate( const Automate* automate, int translation ){
+	Vue_automate vue;
+	vue.automate = automate;
+	vue.translation = translation;
+	return vue;
+}
+
+Vue_automate vue_translatee(
+	const Automate * automate, const Automate * automate_a_eviter
+){
+	if(
+		taille_ensemble( get_etats(automate) ) == 0 ||
+		taille_ensemble( get_etats(automate_a_eviter) ) == 0
+	){
+		return vue_automate( automate, 0 );
+	}
+	return vue_automate(
+		automate, get_max_etat( automate_a_eviter ) - get_min_etat( automate ) + 1
+	);
+}
+
+Ensemble * delta_vue(
+	Vue_automate vue, const Ensemble * etats_courants, char lettre
+){
+	Ensemble * res = creer_ensemble( NULL, NULL, NULL );
+
+	Ensemble_iterateur it1, it2;
+	for(
+		it1 = premier_iterateur_ensemble( etats_courants );
+		! iterateur_ensemble_est_vide( it1 );
+		it1 = iterateur_suivant_ensemble( it1 )
+	){
+		const Ensemble * fins = voisins(
+			vue.automate, get_element( it1 ) - vue.translation, lettre
+		);
+		for(
+			it2 = premier_iterateur_ensemble( fins );
+			! iterateur_ensemble_est_vide( it2 );
+			it2 = iterateur_suivant_ensemble( it2 )
+		){
+			ajouter_element( res, get_element( it2 ) + vue.translation );
+		}
+	}
+
+	return res;
+}
+
+void pour_toute_transition_vue(
+	Vue_automate vue,
+	void (* action )( int origine, char lettre, int fin, void* data ),
+	void* data
+){
+	Parcours_table_persistante parcours;
+	intptr_t cle, valeur;
+	Ensemble_iterateur it2;
+	commencer_parcours_table_persistante( &parcours, vue.automate->transitions );
+	while( entree_suivante_table_persistante( &parcours, &cle, &valeur ) ){
+		Cle origine;
+		lire_cle_transition( cle, &origine );
+		for(
+			it2 = premier_iterateur_ensemble( (Ensemble*) valeur );
+			! iterateur_ensemble_est_vide( it2 );
+			it2 = iterateur_suivant_ensemble( it2 )
+		){
+			action(
+				origine.origine + vue.translation, origine.lettre,
+				get_element( it2 ) + vue.translation, data
+			);
+		}
+	}
+}
+
+int get_max_etat_vue( Vue_automate vue ){
+	int max = get_max_etat( vue.automate );
+	return ( max == INT_MIN ) ? max : max + vue.translation;
+}
+
+int get_min_etat_vue( Vue_automate vue ){
+	int min = get_min_etat( vue.automate );
+	return ( min == INT_MAX ) ? min : min + vue.translation;
+}
+
+/*
+ * Ajoute à 'res' les éléments de 'etats' translatés par 'translation'.
+ */
+static void ajouter_etats_translates(
+	Ensemble * res, const Ensemble * etats, int translation
+){
+	Ensemble_iterateur it;
+	for(
+		it = premier_iterateur_ensemble( etats );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		ajouter_element( res, get_element( it ) + translation );
+	}
+}
+
 int est_une_transition_de_l_automate(
 	const Automate* automate,
 	int origine, char lettre, int fin
@@ -439,33 +647,56 @@ void print_automate( const Automate * automate ){
 	printf("\n- Alphabet : ");
 	print_ensemble( get_alphabet( automate ), print_lettre );
 	printf("\n- Transitions : ");
-	print_table( 
-		automate->transitions,
-		( void (*)( const intptr_t ) ) print_cle, 
-		( void (*)( const intptr_t ) ) print_ensemble_2,
-		""
-	);
-	printf("\n");
+	printf( "{ " );
+	Parcours_table_persistante parcours;
+	intptr_t cle, valeur;
+	commencer_parcours_table_persistante( &parcours, automate->transitions );
+	while( entree_suivante_table_persistante( &parcours, &cle, &valeur ) ){
+		Cle origine;
+		lire_cle_transition( cle, &origine );
+		print_cle( &origine );
+		printf( " --> " );
+		print_ensemble_2( valeur );
+		printf( ", " );
+	}
+	printf( " }\n" );
 }
 
-int le_mot_est_reconnu( const Automate* automate, const char* mot ){
-	Ensemble * arrivee = delta_star( automate, get_initiaux(automate) , mot ); 
-	
-	int result = 0;
+int le_mot_est_reconnu_tampons(
+	const Automate* automate, const char* mot, Tampons_etats * tampons
+){
+	int nb, i = 0;
+	const int * arrivee = delta_star_tampons(
+		automate, get_initiaux( automate ), mot, tampons, &nb
+	);
 
-	Ensemble_iterateur it;
-	for(
-		it = premier_iterateur_ensemble( arrivee );
-		! iterateur_ensemble_est_vide( it );
-		it = iterateur_suivant_ensemble( it )
-	){
-		if( est_un_etat_final_de_l_automate( automate, get_element(it) ) ){
-			result = 1;
-			break;
+	// Peu d'états d'arrivée : on cherche chacun d'eux parmi les finaux.
+	const Ensemble * finaux = get_finaux( automate );
+	if( 8 * nb < (int) taille_ensemble( finaux ) ){
+		for( i=0; i<nb; i++ ){
+			if( est_dans_l_ensemble( finaux, arrivee[i] ) ) return 1;
 		}
+		return 0;
 	}
-	liberer_ensemble( arrivee );
-	return result;
+
+	// Sinon, intersection de deux suites triées : les états d'arrivée et les
+	// finaux.
+	Ensemble_iterateur it = premier_iterateur_ensemble( finaux );
+	while( i < nb && ! iterateur_ensemble_est_vide( it ) ){
+		int final = get_element( it );
+		if( arrivee[i] < final ){
+			i++;
+		}else if( arrivee[i] > final ){
+			it = iterateur_suivant_ensemble( it );
+		}else{
+			return 1;
+		}
+	}
+	return 0;
+}
+
+int le_mot_est_reconnu( const Automate* automate, const char* mot ){
+	return le_mot_est_reconnu_tampons( automate, mot, tampons_locaux() );
 }
 
 Automate * mot_to_automate( const char * mot ){
@@ -485,45 +716,74 @@ void action_creer_union_des_automates ( int origine, char lettre, int fin, void
 }
 
 Automate * creer_union_des_automates(const Automate * automate_1, const Automate * automate_2){
-	//On évite les doublons
-	Automate * automate_2_trans = translater_automate(automate_2, automate_1);
+	Mesure_operation mesure;
+	debut_operation( &mesure, "creer_union_des_automates" );
+	//On évite les doublons, sans copier le second automate
+	Vue_automate vue_2 = vue_translatee(automate_2, automate_1);
 	Automate * automate_resultat = creer_automate();
 	//On ajoute les états, les initiaux et les finaux des deux automates
-	transferer_elements_et_libere(automate_resultat->etats,creer_union_ensemble(get_etats(automate_1), get_etats(automate_2_trans)));
-	transferer_elements_et_libere(automate_resultat->initiaux,creer_union_ensemble(get_initiaux(automate_1), get_initiaux(automate_2_trans)));
-	transferer_elements_et_libere(automate_resultat->finaux,creer_union_ensemble(get_finaux(automate_1), get_finaux(automate_2_trans)));
+	ajouter_elements(automate_resultat->etats, get_etats(automate_1));
+	ajouter_etats_translates(automate_resultat->etats, get_etats(automate_2), vue_2.translation);
+	ajouter_elements(automate_resultat->initiaux, get_initiaux(automate_1));
+	ajouter_etats_translates(automate_resultat->initiaux, get_initiaux(automate_2), vue_2.translation);
+	ajouter_elements(automate_resultat->finaux, get_finaux(automate_1));
+	ajouter_etats_translates(automate_resultat->finaux, get_finaux(automate_2), vue_2.translation);
 	//On ajoute les transitions des deux automates
 	pour_toute_transition(automate_1, action_creer_union_des_automates, automate_resultat);
-	pour_toute_transition(automate_2_trans, action_creer_union_des_automates, automate_resultat);
-	liberer_automate(automate_2_trans);
+	pour_toute_transition_vue(vue_2, action_creer_union_des_automates, automate_resultat);
+	fin_operation( &mesure );
 	return automate_resultat;
 }
 
-Ensemble* etats_accessibles( const Automate * automate, int etat ){
-	Ensemble * etats = creer_ensemble( NULL, NULL, NULL );
-	ajouter_element(etats, etat);
-	
-	Ensemble_iterateur it_etats;
-	for(
-		it_etats = premier_iterateur_ensemble( etats);
-		! iterateur_ensemble_est_vide( it_etats );
-		it_etats = iterateur_suivant_ensemble( it_etats )
-	){
+//Parcours en largeur : la file contient les états atteints dont on n'a pas
+//encore exploré les transitions, chaque état n'y entre qu'une fois
+static void parcourir_accessibles(
+	const Automate * automate, Ensemble * etats, Fifo * file
+){
+	while( ! est_vide( file ) ){
+		int etat = (int) retirer_fifo( file );
+		COMPTER_OPERATION( etats_visites, 1 );
 		Ensemble_iterateur it_lettres;
 		for(
 			it_lettres = premier_iterateur_ensemble(get_alphabet(automate));
 			! iterateur_ensemble_est_vide(it_lettres);
 			it_lettres = iterateur_suivant_ensemble( it_lettres)
 		){
-			//Pour chaque état et chaque lettre, on récupère les voisins et on réitère l'opération sur ces-derniers
-			transferer_elements_et_libere( etats, delta(automate, etats, (char)get_element(it_lettres))); 
+			const Ensemble * fins = voisins(
+				automate, etat, (char) get_element( it_lettres )
+			);
+			COMPTER_OPERATION( transitions_parcourues, taille_ensemble( fins ) );
+			Ensemble_iterateur it_fins;
+			for(
+				it_fins = premier_iterateur_ensemble( fins );
+				! iterateur_ensemble_est_vide( it_fins );
+				it_fins = iterateur_suivant_ensemble( it_fins )
+			){
+				intptr_t fin = get_element( it_fins );
+				if( ! est_dans_l_ensemble( etats, fin ) ){
+					ajouter_element( etats, fin );
+					ajouter_fifo( file, fin );
+				}
+			}
 		}
 	}
+}
+
+Ensemble* etats_accessibles( const Automate * automate, int etat ){
+	Ensemble * etats = creer_ensemble( NULL, NULL, NULL );
+	Fifo * file = creer_fifo();
+	ajouter_element( etats, etat );
+	ajouter_fifo( file, etat );
+	parcourir_accessibles( automate, etats, file );
+	liberer_fifo( file );
 	return etats;
 }
 
 Ensemble* accessibles( const Automate * automate ){
+	Mesure_operation mesure;
+	debut_operation( &mesure, "accessibles" );
 	Ensemble * etats = creer_ensemble( NULL, NULL, NULL );
+	Fifo * file = creer_fifo();
 	
 	Ensemble_iterateur it;
 	for(
@@ -531,9 +791,15 @@ Ensemble* accessibles( const Automate * automate ){
 		! iterateur_ensemble_est_vide( it );
 		it = iterateur_suivant_ensemble( it )
 	){
-		//On cherche les états accessibles depuis les initiaux
-		transferer_elements_et_libere( etats, etats_accessibles(automate, (int)get_element(it))); 
+		//On cherche les états accessibles depuis tous les initiaux en un seul parcours
+		if( ! est_dans_l_ensemble( etats, get_element( it ) ) ){
+			ajouter_element( etats, get_element( it ) );
+			ajouter_fifo( file, get_element( it ) );
+		}
 	}
+	parcourir_accessibles( automate, etats, file );
+	liberer_fifo( file );
+	fin_operation( &mesure );
 	return etats;
 }
 
@@ -544,13 +810,45 @@ void action_automate_accessible( int origine, char lettre, int fin, void * data
 		ajouter_transition((Automate*)data, origine, lettre, fin);
 }
 
-Automate *automate_accessible( const Automate * automate ){
+Ensemble* accessibles_parallele( const Automate * automate, int nb_fils ){
+	if( nb_fils <= 1 ){
+		return accessibles( automate );
+	}
+	Mesure_operation mesure;
+	debut_operation( &mesure, "accessibles_parallele" );
+	//Le parcours parallèle se fait sur l'automate indexé, lui aussi construit
+	//en parallèle
+	Automate_indexe * index = indexer_automate_parallele( automate, nb_fils );
+	unsigned char * marques = xmalloc( index->nb_etats + 1 );
+	marquer_accessibles_indexe_parallele( index, marques, nb_fils );
+	//Les états marqués sont déjà triés : l'ensemble est construit d'un coup
+	intptr_t * accessibles = xmalloc( sizeof(intptr_t) * ( index->nb_etats + 1 ) );
+	int i, nb_accessibles = 0;
+	for( i=0; i<index->nb_etats; i++ ){
+		if( marques[i] ){
+			accessibles[nb_accessibles++] = index->etats[i];
+		}
+	}
+	Ensemble * etats = creer_ensemble_depuis_tableau(
+		accessibles, nb_accessibles, NULL, NULL, NULL
+	);
+	xfree( accessibles );
+	xfree( marques );
+	liberer_automate_indexe( index );
+	fin_operation( &mesure );
+	return etats;
+}
+
+//Construit l'automate accessible à partir de l'ensemble de ses états, qui est libéré
+static Automate * restreindre_aux_accessibles(
+	const Automate * automate, Ensemble * etats
+){
 	Automate * automate_resultat = creer_automate();
 	//L'alphabet et les initiaux ne changent pas
 	transferer_elements_et_libere(automate_resultat->alphabet, copier_ensemble(get_alphabet(automate)));
 	transferer_elements_et_libere(automate_resultat->initiaux, copier_ensemble(get_initiaux(automate)));
 	//On veut seulement les états accessibles
-	transferer_elements_et_libere(automate_resultat->etats, accessibles(automate));
+	transferer_elements_et_libere(automate_resultat->etats, etats);
 	//On conserve uniquement les transitions qui ne concernent que les états accessibles
 	pour_toute_transition(automate, action_automate_accessible, automate_resultat);
 	//On ajoute les finaux accessibles
@@ -558,11 +856,33 @@ Automate *automate_accessible( const Automate * automate ){
 	return automate_resultat;
 }
 
+Automate *automate_accessible( const Automate * automate ){
+	Mesure_operation mesure;
+	debut_operation( &mesure, "automate_accessible" );
+	Automate * automate_resultat = restreindre_aux_accessibles(
+		automate, accessibles( automate )
+	);
+	fin_operation( &mesure );
+	return automate_resultat;
+}
+
+Automate *automate_accessible_parallele( const Automate * automate, int nb_fils ){
+	Mesure_operation mesure;
+	debut_operation( &mesure, "automate_accessible_parallele" );
+	Automate * automate_resultat = restreindre_aux_accessibles(
+		automate, accessibles_parallele( automate, nb_fils )
+	);
+	fin_operation( &mesure );
+	return automate_resultat;
+}
+
 void action_miroir( int origine, char lettre, int fin, void * data ){
 	ajouter_transition((Automate *) data, fin, lettre, origine);
 }
 
 Automate *miroir( const Automate * automate){
+	Mesure_operation mesure;
+	debut_operation( &mesure, "miroir" );
 	Automate * automate_resultat = creer_automate();
 	//Les états et l'alphabet ne changent pas
 	transferer_elements_et_libere(automate_resultat->etats, copier_ensemble(get_etats(automate)));
@@ -572,6 +892,7 @@ Automate *miroir( const Automate * automate){
 	transferer_elements_et_libere(automate_resultat->finaux, copier_ensemble(get_initiaux(automate)));
 	//On inverse chaque transition
 	pour_toute_transition(automate, action_miroir, automate_resultat);
+	fin_operation( &mesure );
 	return automate_resultat;
 }
 
@@ -647,11 +968,13 @@ void action_creer_automate_du_melange_copier_transitions_automate_2( int origine
 }
 
 Automate * creer_automate_du_melange(const Automate* automate_1,  const Automate* automate_2){
-	//On évite les doublons
-	Automate * automate_2_trans = translater_automate(automate_2, automate_1);
+	Mesure_operation mesure;
+	debut_operation( &mesure, "creer_automate_du_melange" );
+	//On évite les doublons, sans copier le second automate
+	Vue_automate vue_2 = vue_translatee(automate_2, automate_1);
 	Automate * automate_resultat = creer_automate();
 	//Le tableau couples contiendra toutes les correspondances entre les nouveaux états et ceux auxquels ils correspondent
-	Couple * couples = malloc(sizeof(Couple)*taille_ensemble(get_etats(automate_1))*taille_ensemble(get_etats(automate_2_trans)));
+	Couple * couples = xmalloc(sizeof(Couple)*taille_ensemble(get_etats(automate_1))*taille_ensemble(get_etats(automate_2)));
 	int nb_etats = 0;
 	//Etats + Initiaux + Finaux
 	Couple tmp;
@@ -663,20 +986,21 @@ Automate * creer_automate_du_melange(const Automate* automate_1,  const Automate
 	){
 		Ensemble_iterateur it_etats_automate_2;
 		for(
-			it_etats_automate_2 = premier_iterateur_ensemble( get_etats(automate_2_trans ));
+			it_etats_automate_2 = premier_iterateur_ensemble( get_etats(automate_2 ));
 			! iterateur_ensemble_est_vide( it_etats_automate_2 );
 			it_etats_automate_2 = iterateur_suivant_ensemble( it_etats_automate_2 )
 		){
 			//Pour chaque couple d'état possible entre les automates 1 et 2, on ajoute un état
+			COMPTER_OPERATION( etats_visites, 1 );
 			tmp.etat_automate_1 = get_element(it_etats_automate_1);
-			tmp.etat_automate_2 = get_element(it_etats_automate_2);
+			tmp.etat_automate_2 = get_element(it_etats_automate_2) + vue_2.translation;
 			//Si les deux étaient initiaux/finaux notre état sera initial/final
 			if(est_un_etat_initial_de_l_automate(automate_1, tmp.etat_automate_1) 
-			  && est_un_etat_initial_de_l_automate(automate_2_trans, tmp.etat_automate_2)){
+			  && est_un_etat_initial_de_l_automate(automate_2, get_element(it_etats_automate_2))){
 				ajouter_etat_initial(automate_resultat, nb_etats);
 			}
 			else if(est_un_etat_final_de_l_automate(automate_1, tmp.etat_automate_1)
-			  && est_un_etat_final_de_l_automate(automate_2_trans, tmp.etat_automate_2)){
+			  && est_un_etat_final_de_l_automate(automate_2, get_element(it_etats_automate_2))){
 				ajouter_etat_final(automate_resultat, nb_etats);
 			}
 			else{
@@ -687,20 +1011,20 @@ Automate * creer_automate_du_melange(const Automate* automate_1,  const Automate
 		}
 	}
 	//L'alphabet est l'union des deux alphabets
-	transferer_elements_et_libere(automate_resultat->alphabet, creer_union_ensemble(get_alphabet(automate_1), get_alphabet(automate_2_trans)));
+	transferer_elements_et_libere(automate_resultat->alphabet, creer_union_ensemble(get_alphabet(automate_1), get_alphabet(automate_2)));
 	// Transitions
 	//On utilise la structure My_data pour avoir non seulement nos états mais aussi leur couple correspondant
-	My_data md = malloc(sizeof(struct My_data));
+	My_data md = xmalloc(sizeof(struct My_data));
 	md->md_couples = couples;
 	md->md_automate = automate_resultat;
 	//Pour chaque transition des automates 1 et 2, on va chercher où elle intervient dans notre automate résultat
 	// Le traitement, bien que similaire, reste légèrement différent selon si on veut copier la transition depuis l'automate 1 ou le 2
 	// Cela semble pourtant relativement "sale" vu qu'il y a beaucoup de duplication de code, comment aurions-nous pu faire ?
 	pour_toute_transition(automate_1,action_creer_automate_du_melange_copier_transitions_automate_1,md);
-	pour_toute_transition(automate_2_trans,action_creer_automate_du_melange_copier_transitions_automate_2,md);
-	free(couples);	
-	free(md);
-	liberer_automate(automate_2_trans);	
+	pour_toute_transition_vue(vue_2,action_creer_automate_du_melange_copier_transitions_automate_2,md);
+	xfree(couples);
+	xfree(md);
+	fin_operation( &mesure );
 	return automate_resultat;
 }
 
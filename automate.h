@@ -24,6 +24,9 @@
 #define __AUTOMATE_H__
 
 #include "ensemble.h"
+#include "table_persistante.h"
+
+#pragma GCC visibility push(default)
 
 /**
  * @brief Le type d'un automate.
@@ -40,7 +43,7 @@ struct Automate {
     Ensemble * vide; //!<
 	Ensemble * etats;
 	Ensemble * alphabet;
-	Table* transitions;
+	Table_persistante* transitions; //!< Voir cle_transition().
 	Ensemble * initiaux;
 	Ensemble * finaux;
 };
@@ -52,6 +55,39 @@ typedef struct Cle {
 	int lettre;
 } Cle;
 
+/**
+ * @brief Renvoie la clé de la table des transitions qui correspond à un état
+ * d'origine et à une lettre.
+ *
+ * Les clés sont des entiers triés par origine, puis par lettre.
+ *
+ * @param origine L'état d'origine.
+ * @param lettre La lettre.
+ * @return La clé.
+ */
+intptr_t cle_transition( int origine, char lettre );
+
+/**
+ * @brief Décode une clé de la table des transitions.
+ *
+ * @param cle Une clé renvoyée par cle_transition().
+ * @param res La clé décodée.
+ */
+void lire_cle_transition( intptr_t cle, Cle * res );
+
+/**
+ * @brief Le type des vues d'un automate.
+ *
+ * Une vue présente un automate dont tous les états sont translatés par un
+ * entier, sans copier l'automate : l'état e de l'automate est vu comme
+ * l'état e + translation. Une vue ne possède aucune mémoire, et n'est valide
+ * que tant que l'automate l'est.
+ */
+typedef struct Vue_automate {
+	const Automate * automate;
+	int translation;
+} Vue_automate;
+
 /**
  * @brief Crée un automate vide, sans états, sans lettres et sans transitions.
  *
@@ -280,6 +316,68 @@ Ensemble * delta_star(
  */ 
 int le_mot_est_reconnu( const Automate* automate, const char* mot );
 
+/**
+ * @brief Le type des tampons de lecture d'un mot.
+ *
+ * Il s'agit de deux tableaux triés d'états, utilisés alternativement pour
+ * stocker les états courants et les états suivants lors de la lecture d'un
+ * mot. Une fois les tampons assez grands, lire un mot ne fait plus aucune
+ * allocation.
+ *
+ * delta_star() et le_mot_est_reconnu() utilisent des tampons propres à
+ * chaque thread, libérés quand le thread se termine. Les fonctions
+ * delta_star_tampons() et le_mot_est_reconnu_tampons() permettent de
+ * fournir ses propres tampons.
+ */
+typedef struct Tampons_etats Tampons_etats;
+
+/**
+ * @brief Crée des tampons de lecture vides.
+ *
+ * @return Les tampons.
+ */
+Tampons_etats * creer_tampons_etats();
+
+/**
+ * @brief Détruit des tampons de lecture.
+ *
+ * @param tampons Les tampons à détruire.
+ */
+void liberer_tampons_etats( Tampons_etats * tampons );
+
+/**
+ * @brief Renvoie les états accessibles à partir d'un ensemble d'états en
+ *        lisant un mot, sans allocation une fois les tampons assez grands.
+ *
+ * Les états sont renvoyés sous la forme d'un tableau trié, sans doublons,
+ * qui appartient aux tampons : il n'est valide que jusqu'à la prochaine
+ * utilisation des tampons.
+ *
+ * @param automate Un automate.
+ * @param etats_courants L'ensemble des état origines.
+ * @param mot Le mot à lire.
+ * @param tampons Les tampons à utiliser.
+ * @param nb_etats Un pointeur qui recevra le nombre d'états renvoyés.
+ * @return Le tableau des états accessibles.
+ */
+const int * delta_star_tampons(
+	const Automate* automate, const Ensemble * etats_courants, const char* mot,
+	Tampons_etats * tampons, int * nb_etats
+);
+
+/**
+ * @brief Renvoie 1 si le mot est reconnu par l'automate et 0 sinon, en
+ *        utilisant les tampons passés en paramètre.
+ *
+ * @param automate Un automate.
+ * @param mot Le mot à reconnaître.
+ * @param tampons Les tampons à utiliser.
+ * @return 1 ou 0
+ */
+int le_mot_est_reconnu_tampons(
+	const Automate* automate, const char* mot, Tampons_etats * tampons
+);
+
 /**
  * @brief La fonction passe en revue toutes les transitions de l'automate et 
  *        appelle la fonction passée en paramètre.
@@ -324,6 +422,81 @@ Automate * translater_automate(
  */
 Automate * translater_automate_entier( const Automate* automate, int translation );
 
+/**
+ * @brief Renvoie la vue d'un automate dont les états sont translatés par un
+ *        entier.
+ *
+ * @param automate Un automate.
+ * @param translation L'entier de translation.
+ * @return La vue.
+ */
+Vue_automate vue_automate( const Automate* automate, int translation );
+
+/**
+ * @brief Renvoie la vue d'un automate dont les états évitent ceux d'un
+ *        second automate.
+ *
+ * La translation est la même que celle de translater_automate().
+ *
+ * @param automate Un automate.
+ * @param automate_a_eviter L'automate à éviter.
+ * @return La vue.
+ */
+Vue_automate vue_translatee(
+	const Automate * automate, const Automate * automate_a_eviter
+);
+
+/**
+ * @brief Renvoie l'ensemble des états accessibles dans une vue à partir d'un
+ *        ensemble d'états de la vue, en lisant une lettre.
+ *
+ * Comme pour delta(), la mémoire de l'ensemble renvoyé est laissée à la
+ * charge de l'utilisateur.
+ *
+ * @param vue Une vue.
+ * @param etats_courants L'ensemble des états origines (numérotés dans la vue).
+ * @param lettre Une lettre.
+ * @return L'ensemble des états accessibles (numérotés dans la vue).
+ */
+Ensemble * delta_vue(
+	Vue_automate vue, const Ensemble * etats_courants, char lettre
+);
+
+/**
+ * @brief Passe en revue toutes les transitions d'une vue et appelle la
+ *        fonction passée en paramètre.
+ *
+ * Voir pour_toute_transition() : les paramètres 'origine' et 'fin' passés à
+ * la fonction sont numérotés dans la vue.
+ *
+ * @param vue Une vue.
+ * @param action La fonction à exécuter.
+ * @param data La donnée supplémentaire à passer à la fonction 'action'.
+ */
+void pour_toute_transition_vue(
+	Vue_automate vue,
+	void (* action )( int origine, char lettre, int fin, void* data ),
+	void* data
+);
+
+/**
+ * @brief Renvoie l'état ayant le numéro le plus grand d'une vue.
+ *
+ * Si l'automate de la vue est vide (sans état), alors il renvoie INT_MIN.
+ *
+ * @param vue Une vue.
+ */
+int get_max_etat_vue( Vue_automate vue );
+
+/**
+ * @brief Renvoie l'état ayant le numéro le plus petit d'une vue.
+ *
+ * Si l'automate de la vue est vide (sans état), alors il renvoie INT_MAX.
+ *
+ * @param vue Une vue.
+ */
+int get_min_etat_vue( Vue_automate vue );
+
 /**
  * @brief @todo Renvoie l'état ayant le numéro le plus grand de l'automate passé en 
  *        paramètre.
@@ -358,6 +531,25 @@ int get_min_etat( const Automate* automate );
  */ 
 Automate* copier_automate( const Automate* automate );
 
+/**
+ * @brief Crée un clone d'un automate, en temps constant.
+ *
+ * Le clone partage la mémoire de l'automate cloné jusqu'à ce que l'un des
+ * deux soit modifié (copie à l'écriture). Modifier les états, les lettres,
+ * les initiaux ou les finaux ne copie que l'ensemble modifié, et seulement si
+ * la modification change son contenu. La table des transitions est une
+ * table persistante : ajouter une transition ne copie que les O(log n) 
+ * noeuds du chemin qui mène à sa clé, et l'ensemble d'états d'arrivée 
+ * modifié.
+ *
+ * Le clone et l'automate cloné se libèrent indépendamment, dans n'importe
+ * quel ordre, avec liberer_automate().
+ *
+ * @param automate L'automate à cloner.
+ * @return Le clone.
+ */
+Automate* cloner_automate( const Automate* automate );
+
 /**
  * @brief Renvoie un automate qui reconnaît un unique mot passé en paramètre.
  *
@@ -370,6 +562,9 @@ Automate * mot_to_automate( const char * mot );
  * @brief @todo Renvoie l'ensemble des états accessibles à partir d'un état en lisant 
  *        un mot quelcquonque.
  *
+ * Le calcul est un parcours en largeur : chaque état atteint passe une seule
+ * fois dans la file de travail.
+ *
  * @param automate Un automate.
  * @param etat L'état de départ.
  * @return L'ensemble des états accessibles.
@@ -380,6 +575,9 @@ Ensemble* etats_accessibles( const Automate * automate, int etat );
  * @brief @todo Renvoie l'ensemble des états accessibles à partir des états initiaux
  *        en lisant un mot quelconque.
  *
+ * Tous les états initiaux sont placés dans la file de travail d'un même
+ * parcours en largeur.
+ *
  * @param automate Un automate.
  * @return L'ensemble des états accessibles.
  */ 
@@ -394,6 +592,32 @@ Ensemble* accessibles( const Automate * automate );
  */ 
 Automate *automate_accessible( const Automate * automate );
 
+/**
+ * @brief Renvoie l'ensemble des états accessibles à partir des états initiaux,
+ *        en répartissant le parcours sur plusieurs fils d'exécution.
+ *
+ * L'automate est indexé par indexer_automate_parallele(), puis parcouru par
+ * marquer_accessibles_indexe_parallele(), avec le même nombre de fils. 
+ * L'ensemble résultat est construit d'un coup à partir des états marqués, 
+ * qui sont déjà triés. Avec un seul fil, la fonction se ramène à 
+ * accessibles().
+ *
+ * @param automate Un automate.
+ * @param nb_fils Le nombre de fils d'exécution.
+ * @return L'ensemble des états accessibles.
+ */
+Ensemble* accessibles_parallele( const Automate * automate, int nb_fils );
+
+/**
+ * @brief Comme automate_accessible(), mais en calculant les états
+ *        accessibles avec accessibles_parallele().
+ *
+ * @param automate Un automate.
+ * @param nb_fils Le nombre de fils d'exécution.
+ * @return L'automate accessible.
+ */
+Automate *automate_accessible_parallele( const Automate * automate, int nb_fils );
+
 /**
   * @brief @todo Crée l'automate du mélange.
   * 
@@ -448,4 +672,6 @@ Automate * creer_union_des_automates(
  */ 
 Automate *miroir( const Automate * automate);
 
+#pragma GCC visibility pop
+
 #endif
@@ -0,0 +1,657 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2014, 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define ETIQUETTE_ALLOCATIONS ETIQUETTE_AUTOMATE
+
+#include "automate_compile.h"
+#include "automate.h"
+#include "table.h"
+#include "ensemble.h"
+#include "outils.h"
+#include "statistiques.h"
+#include "parallele.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+#include <assert.h>
+
+static void initialiser_lettres(
+	const Ensemble * alphabet, char * lettres, int * indice_lettre,
+	int * nb_lettres
+){
+	int i;
+	for( i=0; i<NB_LETTRES_MAX; i++ ){
+		indice_lettre[i] = -1;
+	}
+	*nb_lettres = 0;
+	Ensemble_iterateur it;
+	for(
+		it = premier_iterateur_ensemble( alphabet );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		char lettre = (char) get_element( it );
+		lettres[*nb_lettres] = lettre;
+		indice_lettre[(unsigned char) lettre] = *nb_lettres;
+		(*nb_lettres)++;
+	}
+}
+
+int indice_etat( const Automate_indexe * automate, int etat ){
+	int debut = 0;
+	int fin = automate->nb_etats - 1;
+	while( debut <= fin ){
+		int milieu = debut + ( fin - debut ) / 2;
+		if( automate->etats[milieu] < etat ){
+			debut = milieu + 1;
+		}else if( automate->etats[milieu] > etat ){
+			fin = milieu - 1;
+		}else{
+			return milieu;
+		}
+	}
+	return -1;
+}
+
+/*
+ * Les deux passes de l'indexation sur la table des transitions se partagent
+ * par tranches de rangs : chaque entrée (origine, lettre) de la table ne 
+ * remplit que sa propre case de 'debut', puis sa propre plage de 'fins', 
+ * donc les tranches sont indépendantes.
+ */
+typedef struct Indexation {
+	const Table_persistante * transitions;
+	Automate_indexe * index;
+	int ranger; //!< 0 pour compter les fins de chaque case, 1 pour les ranger.
+	int nb_tranches;
+	atomic_int prochaine;
+} Indexation;
+
+static void indexer_tranche( Indexation * indexation, int tranche ){
+	Automate_indexe * res = indexation->index;
+	long nb_entrees = taille_table_persistante( indexation->transitions );
+	int debut = nb_entrees * tranche / indexation->nb_tranches;
+	int fin = nb_entrees * ( tranche + 1 ) / indexation->nb_tranches;
+	Parcours_table_persistante parcours;
+	intptr_t cle_table, fins;
+	Cle cle;
+	Ensemble_iterateur it;
+	int r, origine = 0, indice_origine = -1;
+	commencer_parcours_table_persistante_au_rang(
+		&parcours, indexation->transitions, debut
+	);
+	for( r=debut; r<fin; r++ ){
+		entree_suivante_table_persistante( &parcours, &cle_table, &fins );
+		lire_cle_transition( cle_table, &cle );
+		// Les clés sont triées par origine puis par lettre : l'indice de
+		// l'origine ne change qu'au passage à l'état suivant.
+		if( indice_origine < 0 || cle.origine != origine ){
+			origine = cle.origine;
+			indice_origine = indice_etat( res, origine );
+		}
+		int k = indice_origine * res->nb_lettres
+			+ res->indice_lettre[(unsigned char) cle.lettre];
+		if( ! indexation->ranger ){
+			res->debut[k+1] = taille_ensemble( (Ensemble *) fins );
+			continue;
+		}
+		int j = res->debut[k];
+		for(
+			it = premier_iterateur_ensemble( (Ensemble *) fins );
+			! iterateur_ensemble_est_vide( it );
+			it = iterateur_suivant_ensemble( it )
+		){
+			res->fins[j++] = indice_etat( res, get_element( it ) );
+		}
+	}
+}
+
+static void * indexer_tranches( void * data ){
+	Indexation * indexation = (Indexation *) data;
+	int tranche;
+	while(
+		( tranche = atomic_fetch_add( &indexation->prochaine, 1 ) )
+		< indexation->nb_tranches
+	){
+		indexer_tranche( indexation, tranche );
+	}
+	return NULL;
+}
+
+static void indexer_transitions( Indexation * indexation, int nb_fils ){
+	atomic_store( &indexation->prochaine, 0 );
+	if( nb_fils <= 1 ){
+		indexer_tranches( indexation );
+	}else{
+		executer_en_parallele( indexer_tranches, indexation, nb_fils );
+	}
+}
+
+Automate_indexe * indexer_automate( const Automate * automate ){
+	return indexer_automate_parallele( automate, 1 );
+}
+
+Automate_indexe * indexer_automate_parallele(
+	const Automate * automate, int nb_fils
+){
+	Automate_indexe * res = xmalloc( sizeof(Automate_indexe) );
+	Ensemble_iterateur it;
+	int i;
+
+	// Les états, dans l'ordre croissant
+	res->nb_etats = taille_ensemble( get_etats( automate ) );
+	res->etats = xmalloc( sizeof(int) * ( res->nb_etats + 1 ) );
+	i = 0;
+	for(
+		it = premier_iterateur_ensemble( get_etats( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		res->etats[i++] = get_element( it );
+	}
+
+	initialiser_lettres(
+		get_alphabet( automate ), res->lettres, res->indice_lettre,
+		&res->nb_lettres
+	);
+
+	// Un premier passage compte les fins de chaque case du CSR, un second
+	// les range une fois les débuts de cases connus.
+	int nb_cases = res->nb_etats * res->nb_lettres;
+	res->debut = xmalloc( sizeof(int) * ( nb_cases + 1 ) );
+	memset( res->debut, 0, sizeof(int) * ( nb_cases + 1 ) );
+	Indexation indexation;
+	indexation.transitions = automate->transitions;
+	indexation.index = res;
+	indexation.nb_tranches = nb_fils <= 1 ? 1 : 8 * nb_fils;
+	indexation.ranger = 0;
+	indexer_transitions( &indexation, nb_fils );
+	for( i=0; i<nb_cases; i++ ){
+		res->debut[i+1] += res->debut[i];
+	}
+	res->nb_transitions = res->debut[nb_cases];
+	res->fins = xmalloc( sizeof(int) * ( res->nb_transitions + 1 ) );
+	indexation.ranger = 1;
+	indexer_transitions( &indexation, nb_fils );
+
+	// Les états initiaux et finaux
+	res->nb_initiaux = taille_ensemble( get_initiaux( automate ) );
+	res->initiaux = xmalloc( sizeof(int) * ( res->nb_initiaux + 1 ) );
+	i = 0;
+	for(
+		it = premier_iterateur_ensemble( get_initiaux( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		res->initiaux[i++] = indice_etat( res, get_element( it ) );
+	}
+	res->finaux = xmalloc( res->nb_etats + 1 );
+	memset( res->finaux, 0, res->nb_etats + 1 );
+	for(
+		it = premier_iterateur_ensemble( get_finaux( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		res->finaux[ indice_etat( res, get_element( it ) ) ] = 1;
+	}
+	res->nb_finaux = taille_ensemble( get_finaux( automate ) );
+	res->liste_finaux = xmalloc( sizeof(int) * ( res->nb_finaux + 1 ) );
+	i = 0;
+	for(
+		it = premier_iterateur_ensemble( get_finaux( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		res->liste_finaux[i++] = indice_etat( res, get_element( it ) );
+	}
+	res->est_initial = xmalloc( res->nb_etats + 1 );
+	memset( res->est_initial, 0, res->nb_etats + 1 );
+	for( i=0; i<res->nb_initiaux; i++ ){
+		res->est_initial[ res->initiaux[i] ] = 1;
+	}
+	res->debut_inverse = NULL;
+	res->origines = NULL;
+	return res;
+}
+
+void indexer_inverse( Automate_indexe * automate ){
+	if( automate->debut_inverse ) return;
+	int L = automate->nb_lettres;
+	int nb_cases = automate->nb_etats * L;
+	int * debut = xmalloc( sizeof(int) * ( nb_cases + 2 ) );
+	int * origines = xmalloc( sizeof(int) * ( automate->nb_transitions + 1 ) );
+	int e, l, t;
+
+	// Comptage des prédécesseurs de chaque case (fin, lettre), décalé de deux
+	// cases pour que debut[k+1] serve ensuite de position d'écriture.
+	memset( debut, 0, sizeof(int) * ( nb_cases + 2 ) );
+	for( e=0; e<automate->nb_etats; e++ ){
+		for( l=0; l<L; l++ ){
+			int k = e * L + l;
+			for( t=automate->debut[k]; t<automate->debut[k+1]; t++ ){
+				debut[ automate->fins[t] * L + l + 2 ]++;
+			}
+		}
+	}
+	for( e=0; e<nb_cases; e++ ){
+		debut[e+2] += debut[e+1];
+	}
+	for( e=0; e<automate->nb_etats; e++ ){
+		for( l=0; l<L; l++ ){
+			int k = e * L + l;
+			for( t=automate->debut[k]; t<automate->debut[k+1]; t++ ){
+				origines[ debut[ automate->fins[t] * L + l + 1 ]++ ] = e;
+			}
+		}
+	}
+	automate->debut_inverse = debut;
+	automate->origines = origines;
+}
+
+Automate_indexe miroir_indexe( Automate_indexe * automate ){
+	indexer_inverse( automate );
+	Automate_indexe res = *automate;
+	res.debut = automate->debut_inverse;
+	res.fins = automate->origines;
+	res.debut_inverse = automate->debut;
+	res.origines = automate->fins;
+	res.nb_initiaux = automate->nb_finaux;
+	res.initiaux = automate->liste_finaux;
+	res.nb_finaux = automate->nb_initiaux;
+	res.liste_finaux = automate->initiaux;
+	res.finaux = automate->est_initial;
+	res.est_initial = automate->finaux;
+	return res;
+}
+
+void marquer_accessibles_indexe(
+	const Automate_indexe * automate, unsigned char * marques
+){
+	int L = automate->nb_lettres;
+	int * pile = xmalloc( sizeof(int) * ( automate->nb_etats + 1 ) );
+	int taille = 0;
+	int i, t;
+
+	memset( marques, 0, automate->nb_etats );
+	for( i=0; i<automate->nb_initiaux; i++ ){
+		int e = automate->initiaux[i];
+		if( ! marques[e] ){
+			marques[e] = 1;
+			pile[taille++] = e;
+		}
+	}
+	while( taille > 0 ){
+		int e = pile[--taille];
+		// Les cases de l'état e sont contiguës dans le CSR.
+		for( t=automate->debut[e*L]; t<automate->debut[(e+1)*L]; t++ ){
+			int f = automate->fins[t];
+			if( ! marques[f] ){
+				marques[f] = 1;
+				pile[taille++] = f;
+			}
+		}
+	}
+	xfree( pile );
+}
+
+void liberer_automate_indexe( Automate_indexe * automate ){
+	assert( automate );
+	xfree( automate->etats );
+	xfree( automate->debut );
+	xfree( automate->fins );
+	xfree( automate->initiaux );
+	xfree( automate->finaux );
+	xfree( automate->liste_finaux );
+	xfree( automate->est_initial );
+	if( automate->debut_inverse ){
+		xfree( automate->debut_inverse );
+		xfree( automate->origines );
+	}
+	xfree( automate );
+}
+
+/*
+ * Dictionnaire des sous-ensembles déjà rencontrés lors de la construction
+ * des sous-ensembles. Les sous-ensembles sont des tableaux triés d'indices
+ * d'états, rangés les uns à la suite des autres dans 'valeurs'.
+ */
+typedef struct {
+	int nb;
+	int capacite;
+	int * debut;
+	unsigned int * empreintes;
+	int * valeurs;
+	int taille_valeurs;
+	int capacite_valeurs;
+	int * cases;
+	int nb_cases;
+} Sous_ensembles;
+
+static unsigned int empreinte_sous_ensemble( const int * elements, int taille ){
+	unsigned int h = 2166136261u;
+	int i;
+	for( i=0; i<taille; i++ ){
+		h = ( h ^ (unsigned int) elements[i] ) * 16777619u;
+	}
+	return h;
+}
+
+static void initialiser_sous_ensembles( Sous_ensembles * se ){
+	se->nb = 0;
+	se->capacite = 16;
+	se->debut = xmalloc( sizeof(int) * ( se->capacite + 1 ) );
+	se->debut[0] = 0;
+	se->empreintes = xmalloc( sizeof(unsigned int) * se->capacite );
+	se->capacite_valeurs = 64;
+	se->taille_valeurs = 0;
+	se->valeurs = xmalloc( sizeof(int) * se->capacite_valeurs );
+	se->nb_cases = 32;
+	se->cases = xmalloc( sizeof(int) * se->nb_cases );
+	memset( se->cases, -1, sizeof(int) * se->nb_cases );
+}
+
+static void liberer_sous_ensembles( Sous_ensembles * se ){
+	xfree( se->debut );
+	xfree( se->empreintes );
+	xfree( se->valeurs );
+	xfree( se->cases );
+}
+
+static void agrandir_cases( Sous_ensembles * se ){
+	int i;
+	xfree( se->cases );
+	se->nb_cases *= 2;
+	se->cases = xmalloc( sizeof(int) * se->nb_cases );
+	memset( se->cases, -1, sizeof(int) * se->nb_cases );
+	for( i=0; i<se->nb; i++ ){
+		unsigned int c = se->empreintes[i] & ( se->nb_cases - 1 );
+		while( se->cases[c] != -1 ){
+			c = ( c + 1 ) & ( se->nb_cases - 1 );
+		}
+		se->cases[c] = i;
+	}
+}
+
+/*
+ * Renvoie le numéro du sous-ensemble passé en paramètre, en l'ajoutant s'il
+ * n'a jamais été rencontré. Dans ce cas, *nouveau est mis à 1.
+ */
+static int trouver_ou_ajouter_sous_ensemble(
+	Sous_ensembles * se, const int * elements, int taille, int * nouveau
+){
+	unsigned int h = empreinte_sous_ensemble( elements, taille );
+	unsigned int c = h & ( se->nb_cases - 1 );
+	*nouveau = 0;
+	while( se->cases[c] != -1 ){
+		int id = se->cases[c];
+		int taille_id = se->debut[id+1] - se->debut[id];
+		if(
+			se->empreintes[id] == h && taille_id == taille &&
+			memcmp(
+				se->valeurs + se->debut[id], elements, sizeof(int) * taille
+			) == 0
+		){
+			return id;
+		}
+		c = ( c + 1 ) & ( se->nb_cases - 1 );
+	}
+
+	*nouveau = 1;
+	if( se->nb == se->capacite ){
+		se->capacite *= 2;
+		se->debut = xrealloc( se->debut, sizeof(int) * ( se->capacite + 1 ) );
+		se->empreintes = xrealloc(
+			se->empreintes, sizeof(unsigned int) * se->capacite
+		);
+	}
+	while( se->taille_valeurs + taille > se->capacite_valeurs ){
+		se->capacite_valeurs *= 2;
+		se->valeurs = xrealloc(
+			se->valeurs, sizeof(int) * se->capacite_valeurs
+		);
+	}
+	int id = se->nb++;
+	memcpy( se->valeurs + se->taille_valeurs, elements, sizeof(int) * taille );
+	se->taille_valeurs += taille;
+	se->debut[id+1] = se->taille_valeurs;
+	se->empreintes[id] = h;
+	se->cases[c] = id;
+	if( 2 * se->nb > se->nb_cases ){
+		agrandir_cases( se );
+	}
+	return id;
+}
+
+static int comparer_entiers( const void * a, const void * b ){
+	int x = *(const int *) a;
+	int y = *(const int *) b;
+	return ( x > y ) - ( x < y );
+}
+
+Automate_compile * compiler_automate( const Automate * automate ){
+	Mesure_operation mesure;
+	debut_operation( &mesure, "compiler_automate" );
+	Automate_indexe * index = indexer_automate( automate );
+	Automate_compile * res = xmalloc( sizeof(Automate_compile) );
+	int L = index->nb_lettres;
+	int i, l, j;
+
+	res->nb_lettres = L;
+	memcpy( res->lettres, index->lettres, sizeof(res->lettres) );
+	memcpy( res->indice_lettre, index->indice_lettre, sizeof(res->indice_lettre) );
+	res->complet = 0;
+	res->puits_final = 0;
+
+	Sous_ensembles se;
+	initialiser_sous_ensembles( &se );
+	int capacite_etats = 16;
+	int capacite_allouee = capacite_etats;
+	res->transitions = xmalloc( sizeof(int) * capacite_etats * ( L + 1 ) );
+	res->finaux = xmalloc( capacite_etats );
+
+	// Tampons pour le calcul des successeurs
+	int * successeurs = xmalloc( sizeof(int) * ( index->nb_etats + 1 ) );
+	int * marque = xmalloc( sizeof(int) * ( index->nb_etats + 1 ) );
+	for( i=0; i<index->nb_etats; i++ ){
+		marque[i] = -1;
+	}
+	int tampon = 0;
+
+	int nouveau;
+	if( index->nb_initiaux == 0 ){
+		res->initial = ETAT_PUITS;
+	}else{
+		res->initial = trouver_ou_ajouter_sous_ensemble(
+			&se, index->initiaux, index->nb_initiaux, &nouveau
+		);
+	}
+
+	// Les sous-ensembles sont numérotés dans leur ordre de découverte : la
+	// file du parcours en largeur est donc simplement 0, 1, ..., se.nb-1.
+	for( i=0; i<se.nb; i++ ){
+		while( se.nb > capacite_etats ){
+			capacite_etats *= 2;
+		}
+		if( capacite_etats != capacite_allouee ){
+			capacite_allouee = capacite_etats;
+			res->transitions = xrealloc(
+				res->transitions, sizeof(int) * capacite_etats * ( L + 1 )
+			);
+			res->finaux = xrealloc( res->finaux, capacite_etats );
+		}
+		COMPTER_OPERATION( etats_visites, 1 );
+		res->finaux[i] = 0;
+		for( j=se.debut[i]; j<se.debut[i+1]; j++ ){
+			if( index->finaux[ se.valeurs[j] ] ){
+				res->finaux[i] = 1;
+				break;
+			}
+		}
+		for( l=0; l<L; l++ ){
+			int nb_successeurs = 0;
+			tampon++;
+			for( j=se.debut[i]; j<se.debut[i+1]; j++ ){
+				int k = se.valeurs[j] * L + l;
+				int t;
+				COMPTER_OPERATION(
+					transitions_parcourues, index->debut[k+1] - index->debut[k]
+				);
+				for( t=index->debut[k]; t<index->debut[k+1]; t++ ){
+					int fin = index->fins[t];
+					if( marque[fin] != tampon ){
+						marque[fin] = tampon;
+						successeurs[nb_successeurs++] = fin;
+					}
+				}
+			}
+			if( nb_successeurs == 0 ){
+				res->transitions[i*L + l] = ETAT_PUITS;
+			}else{
+				qsort(
+					successeurs, nb_successeurs, sizeof(int), comparer_entiers
+				);
+				res->transitions[i*L + l] = trouver_ou_ajouter_sous_ensemble(
+					&se, successeurs, nb_successeurs, &nouveau
+				);
+			}
+		}
+	}
+	res->nb_etats = se.nb;
+
+	xfree( successeurs );
+	xfree( marque );
+	liberer_sous_ensembles( &se );
+	liberer_automate_indexe( index );
+	fin_operation( &mesure );
+	return res;
+}
+
+void liberer_automate_compile( Automate_compile * automate ){
+	assert( automate );
+	xfree( automate->transitions );
+	xfree( automate->finaux );
+	xfree( automate );
+}
+
+Automate_compile * copier_automate_compile( const Automate_compile * automate ){
+	Automate_compile * res = xmalloc( sizeof(Automate_compile) );
+	*res = *automate;
+	size_t taille = (size_t) automate->nb_etats * automate->nb_lettres;
+	res->transitions = xmalloc( sizeof(int) * ( taille + 1 ) );
+	memcpy( res->transitions, automate->transitions, sizeof(int) * taille );
+	res->finaux = xmalloc( automate->nb_etats + 1 );
+	memcpy( res->finaux, automate->finaux, automate->nb_etats );
+	return res;
+}
+
+int delta_compile( const Automate_compile * automate, int etat, char lettre ){
+	int l = automate->indice_lettre[(unsigned char) lettre];
+	if( etat == ETAT_PUITS || l < 0 ){
+		return ETAT_PUITS;
+	}
+	return automate->transitions[ etat * automate->nb_lettres + l ];
+}
+
+int est_final_compile( const Automate_compile * automate, int etat ){
+	if( etat == ETAT_PUITS ){
+		return automate->puits_final;
+	}
+	return automate->finaux[etat];
+}
+
+int le_mot_est_reconnu_compile(
+	const Automate_compile * automate, const char * mot
+){
+	int etat = automate->initial;
+	const unsigned char * c;
+	for( c = (const unsigned char *) mot; *c; c++ ){
+		int l = automate->indice_lettre[*c];
+		if( l < 0 ){
+			return 0;
+		}
+		if( etat != ETAT_PUITS ){
+			etat = automate->transitions[ etat * automate->nb_lettres + l ];
+		}else if( ! automate->puits_final ){
+			// Le puits n'est pas final : le mot ne peut plus être reconnu.
+			return 0;
+		}
+	}
+	return est_final_compile( automate, etat );
+}
+
+Automate_compile * completer( const Automate_compile * automate ){
+	Automate_compile * res = copier_automate_compile( automate );
+	res->complet = 1;
+	return res;
+}
+
+Automate_compile * complement( const Automate_compile * automate ){
+	Automate_compile * res = copier_automate_compile( automate );
+	int i;
+	res->complet = 1;
+	for( i=0; i<res->nb_etats; i++ ){
+		res->finaux[i] = ! res->finaux[i];
+	}
+	res->puits_final = ! res->puits_final;
+	return res;
+}
+
+Automate * decompiler_automate( const Automate_compile * automate ){
+	Automate * res = creer_automate();
+	int i, l;
+	int puits = automate->nb_etats;
+	int avec_puits = automate->complet || automate->puits_final;
+
+	for( l=0; l<automate->nb_lettres; l++ ){
+		ajouter_lettre( res, automate->lettres[l] );
+	}
+	for( i=0; i<automate->nb_etats; i++ ){
+		ajouter_etat( res, i );
+		if( automate->finaux[i] ){
+			ajouter_etat_final( res, i );
+		}
+		for( l=0; l<automate->nb_lettres; l++ ){
+			int fin = automate->transitions[ i*automate->nb_lettres + l ];
+			if( fin != ETAT_PUITS ){
+				ajouter_transition( res, i, automate->lettres[l], fin );
+			}else if( avec_puits ){
+				ajouter_transition( res, i, automate->lettres[l], puits );
+			}
+		}
+	}
+	if( avec_puits ){
+		ajouter_etat( res, puits );
+		for( l=0; l<automate->nb_lettres; l++ ){
+			ajouter_transition( res, puits, automate->lettres[l], puits );
+		}
+		if( automate->puits_final ){
+			ajouter_etat_final( res, puits );
+		}
+	}
+	if( automate->initial != ETAT_PUITS ){
+		ajouter_etat_initial( res, automate->initial );
+	}else if( avec_puits ){
+		ajouter_etat_initial( res, puits );
+	}
+	return res;
+}
@@ -0,0 +1,287 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2014, 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file automate_compile.h */
+
+#ifndef __AUTOMATE_COMPILE_H__
+#define __AUTOMATE_COMPILE_H__
+
+#include "automate.h"
+
+#include <limits.h>
+
+#pragma GCC visibility push(default)
+
+/**
+ * @brief Nombre de lettres possibles (une lettre est un char).
+ */
+#define NB_LETTRES_MAX (UCHAR_MAX+1)
+
+/**
+ * @brief Numéro de l'état puits implicite d'un automate compilé.
+ */
+#define ETAT_PUITS (-1)
+
+/**
+ * @brief Le type d'un automate indexé.
+ *
+ * Il s'agit d'une représentation en lecture seule d'un automate (éventuellement
+ * non déterministe), dans laquelle les états sont renumérotés de 0 à
+ * nb_etats-1 et les lettres de 0 à nb_lettres-1.
+ *
+ * Les transitions sont rangées au format CSR (Compressed Sparse Row) : les
+ * indices des fins des transitions partant de l'état d'indice e en lisant la
+ * lettre d'indice l sont rangés dans fins[ debut[k] ], ...,
+ * fins[ debut[k+1]-1 ] où k = e*nb_lettres + l.
+ *
+ * L'index inverse (les prédécesseurs) est rangé de la même manière dans
+ * debut_inverse et origines. Il n'est construit qu'à la demande, par
+ * indexer_inverse() : tant qu'il ne l'est pas, ces deux champs valent NULL.
+ */
+typedef struct Automate_indexe {
+	int nb_etats;
+	int nb_lettres;
+	int nb_transitions;
+	int * etats; //!< Numéros des états, triés par ordre croissant.
+	char lettres[NB_LETTRES_MAX]; //!< Lettres, triées par ordre croissant.
+	int indice_lettre[NB_LETTRES_MAX]; //!< Indice d'une lettre ou -1.
+	int * debut;
+	int * fins;
+	int nb_initiaux;
+	int * initiaux; //!< Indices des états initiaux.
+	unsigned char * finaux; //!< finaux[e] vaut 1 si e est final.
+	int nb_finaux;
+	int * liste_finaux; //!< Indices des états finaux.
+	unsigned char * est_initial; //!< est_initial[e] vaut 1 si e est initial.
+	int * debut_inverse;
+	int * origines;
+} Automate_indexe;
+
+/**
+ * @brief Le type d'un automate déterministe compilé.
+ *
+ * Les états sont numérotés de 0 à nb_etats-1 et la table des transitions est
+ * dense : transitions[ e*nb_lettres + l ] est l'état atteint depuis l'état e
+ * en lisant la lettre d'indice l.
+ *
+ * L'automate possède un état puits implicite, numéroté ETAT_PUITS, qui n'est
+ * jamais stocké dans la table des transitions : une case valant ETAT_PUITS
+ * indique que la transition mène au puits, et le puits boucle sur lui-même
+ * pour toutes les lettres. Le champ puits_final indique si ce puits est
+ * final. Ainsi, compléter ou complémenter un automate compilé ne change pas
+ * la taille de sa table.
+ */
+typedef struct Automate_compile {
+	int nb_etats;
+	int nb_lettres;
+	char lettres[NB_LETTRES_MAX]; //!< Lettres, triées par ordre croissant.
+	int indice_lettre[NB_LETTRES_MAX]; //!< Indice d'une lettre ou -1.
+	int initial; //!< L'état initial (ETAT_PUITS si l'automate n'en a pas).
+	int * transitions;
+	unsigned char * finaux; //!< finaux[e] vaut 1 si e est final.
+	int complet; //!< 1 si le puits fait partie de l'automate.
+	int puits_final; //!< 1 si le puits implicite est final.
+} Automate_compile;
+
+/**
+ * @brief Crée l'automate indexé associé à un automate.
+ *
+ * @param automate Un automate.
+ * @return L'automate indexé.
+ */
+Automate_indexe * indexer_automate( const Automate * automate );
+
+/**
+ * @brief Crée l'automate indexé associé à un automate, en répartissant les
+ *        passages sur la table des transitions entre plusieurs fils 
+ *        d'exécution.
+ *
+ * Chaque fil parcourt des tranches de la table des transitions, commencées
+ * à leur rang en O(log n), et remplit les cases du CSR de ces tranches. Le
+ * résultat est le même que celui de indexer_automate(). Avec un seul fil, 
+ * aucun fil n'est créé.
+ *
+ * @param automate Un automate.
+ * @param nb_fils Le nombre de fils d'exécution (au moins 1).
+ * @return L'automate indexé.
+ */
+Automate_indexe * indexer_automate_parallele(
+	const Automate * automate, int nb_fils
+);
+
+/**
+ * @brief Détruit un automate indexé.
+ *
+ * @param automate L'automate indexé à détruire.
+ */
+void liberer_automate_indexe( Automate_indexe * automate );
+
+/**
+ * @brief Construit l'index inverse d'un automate indexé, s'il ne l'est pas
+ *        déjà.
+ *
+ * @param automate Un automate indexé.
+ */
+void indexer_inverse( Automate_indexe * automate );
+
+/**
+ * @brief Renvoie une vue de l'automate miroir d'un automate indexé.
+ *
+ * Aucune donnée n'est copiée : la vue échange les index direct et inverse,
+ * ainsi que les rôles des états initiaux et finaux. Elle partage donc la
+ * mémoire de l'automate indexé, et n'est valide que tant que celui-ci l'est.
+ * Elle ne doit pas être passée à liberer_automate_indexe().
+ *
+ * L'index inverse est construit s'il ne l'est pas déjà.
+ *
+ * @param automate Un automate indexé.
+ * @return La vue miroir.
+ */
+Automate_indexe miroir_indexe( Automate_indexe * automate );
+
+/**
+ * @brief Marque les états accessibles depuis les états initiaux d'un
+ *        automate indexé.
+ *
+ * Appliquée à miroir_indexe(), la fonction marque les états co-accessibles.
+ *
+ * @param automate Un automate indexé.
+ * @param marques Un tableau de nb_etats cases, qui reçoit 1 pour les états
+ *        accessibles et 0 pour les autres.
+ */
+void marquer_accessibles_indexe(
+	const Automate_indexe * automate, unsigned char * marques
+);
+
+/**
+ * @brief Renvoie l'indice d'un état dans un automate indexé, ou -1 si l'état
+ *        n'appartient pas à l'automate.
+ *
+ * @param automate Un automate indexé.
+ * @param etat Le numéro de l'état dans l'automate d'origine.
+ * @return L'indice de l'état ou -1.
+ */
+int indice_etat( const Automate_indexe * automate, int etat );
+
+/**
+ * @brief Compile un automate en un automate déterministe.
+ *
+ * Si l'automate n'est pas déterministe, il est déterminisé par la
+ * construction des sous-ensembles. Seuls les états accessibles sont créés,
+ * et ils sont numérotés dans l'ordre d'un parcours en largeur (lettres dans
+ * l'ordre croissant) depuis l'état initial, qui porte donc le numéro 0.
+ * L'ensemble vide n'est pas créé : il correspond au puits implicite.
+ *
+ * @param automate Un automate.
+ * @return L'automate compilé.
+ */
+Automate_compile * compiler_automate( const Automate * automate );
+
+/**
+ * @brief Détruit un automate compilé.
+ *
+ * @param automate L'automate compilé à détruire.
+ */
+void liberer_automate_compile( Automate_compile * automate );
+
+/**
+ * @brief Copie un automate compilé.
+ *
+ * @param automate L'automate compilé à copier.
+ * @return La copie.
+ */
+Automate_compile * copier_automate_compile( const Automate_compile * automate );
+
+/**
+ * @brief Renvoie l'état atteint depuis un état en lisant une lettre.
+ *
+ * Si la lettre n'appartient pas à l'alphabet, ou si l'état est le puits,
+ * la fonction renvoie ETAT_PUITS.
+ *
+ * @param automate Un automate compilé.
+ * @param etat Un état (ou ETAT_PUITS).
+ * @param lettre Une lettre.
+ * @return L'état atteint (ou ETAT_PUITS).
+ */
+int delta_compile( const Automate_compile * automate, int etat, char lettre );
+
+/**
+ * @brief Renvoie 1 si l'état passé en paramètre (éventuellement ETAT_PUITS)
+ *        est final et 0 sinon.
+ *
+ * @param automate Un automate compilé.
+ * @param etat Un état (ou ETAT_PUITS).
+ * @return 1 ou 0.
+ */
+int est_final_compile( const Automate_compile * automate, int etat );
+
+/**
+ * @brief Renvoie 1 si le mot est reconnu par l'automate compilé et 0 sinon.
+ *
+ * Un mot contenant une lettre qui n'appartient pas à l'alphabet de l'automate
+ * n'est jamais reconnu.
+ *
+ * @param automate Un automate compilé.
+ * @param mot Le mot à reconnaître.
+ * @return 1 ou 0.
+ */
+int le_mot_est_reconnu_compile(
+	const Automate_compile * automate, const char * mot
+);
+
+/**
+ * @brief Renvoie le complété d'un automate compilé.
+ *
+ * Le puits reste implicite : la table des transitions n'est pas agrandie,
+ * seul le champ complet est positionné. Le langage reconnu est inchangé.
+ *
+ * @param automate Un automate compilé.
+ * @return L'automate complété.
+ */
+Automate_compile * completer( const Automate_compile * automate );
+
+/**
+ * @brief Renvoie le complémentaire d'un automate compilé.
+ *
+ * L'automate renvoyé reconnaît les mots sur l'alphabet de l'automate qui ne
+ * sont pas reconnus par l'automate passé en paramètre. Il est complet, et
+ * son puits implicite est final (sauf si celui de l'automate d'origine
+ * l'était).
+ *
+ * @param automate Un automate compilé.
+ * @return L'automate complémentaire.
+ */
+Automate_compile * complement( const Automate_compile * automate );
+
+/**
+ * @brief Crée un automate à partir d'un automate compilé.
+ *
+ * Les états de l'automate créé sont numérotés de 0 à nb_etats-1. Le puits
+ * n'est matérialisé (avec le numéro nb_etats) que si l'automate compilé est
+ * complet ou si son puits est final.
+ *
+ * @param automate Un automate compilé.
+ * @return L'automate créé.
+ */
+Automate * decompiler_automate( const Automate_compile * automate );
+
+#pragma GCC visibility pop
+
+#endif
@@ -0,0 +1,124 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "acyclique.h"
+#include "automate.h"
+#include "generateurs.h"
+#include "outils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Construit l'automate minimal de k mots aléatoires, ajoutés triés puis dans
+ * le désordre, et le compare à l'union des automates mot_to_automate() et à
+ * l'arbre préfixe des mots. Les mots sont formés d'un radical et d'une
+ * terminaison choisis parmi quelques-unes, comme ceux d'un lexique.
+ * Chaque ligne affichée est de la forme :
+ *   union <mots> <etats> <ns>
+ *   acyclique <mots> <etats_arbre> <etats_max> <etats> <tries_ns> <desordre_ns>
+ * où etats_max est le nombre maximal d'états utilisés pendant la
+ * construction à partir des mots triés.
+ */
+
+#define LONGUEUR_MAX 16
+
+static void mot_du_lexique( char * mot ){
+	static const char * terminaisons[] = { "", "s", "er", "ez", "ait", "ions" };
+	int longueur = 3 + alea( 6 );
+	mot_aleatoire( mot, longueur, 26 );
+	strcpy( mot + longueur, terminaisons[ alea( 6 ) ] );
+}
+
+static int comparer_mots( const void * a, const void * b ){
+	return strcmp( (const char *) a, (const char *) b );
+}
+
+int main(){
+	int k, i;
+
+	for( k=100; k<=400; k*=2 ){
+		long t0 = maintenant_ns();
+		Automate * automate = creer_automate();
+		for( i=0; i<k; i++ ){
+			char mot[LONGUEUR_MAX];
+			mot_du_lexique( mot );
+			Automate * a = mot_to_automate( mot );
+			Automate * u = creer_union_des_automates( automate, a );
+			liberer_automate( a );
+			liberer_automate( automate );
+			automate = u;
+		}
+		long t1 = maintenant_ns();
+		printf(
+			"union\t%d\t%u\t%ld\n", k, taille_ensemble( get_etats( automate ) ),
+			t1 - t0
+		);
+		liberer_automate( automate );
+	}
+
+	for( k=1000; k<=100000; k*=10 ){
+		char (* mots)[LONGUEUR_MAX] = xmalloc( k * sizeof(*mots) );
+		for( i=0; i<k; i++ ){
+			mot_du_lexique( mots[i] );
+		}
+
+		long t0 = maintenant_ns();
+		Constructeur_acyclique * desordre = creer_constructeur_acyclique();
+		for( i=0; i<k; i++ ){
+			ajouter_mot_acyclique( desordre, mots[i] );
+		}
+		long t1 = maintenant_ns();
+
+		qsort( mots, k, sizeof(*mots), comparer_mots );
+		int etats_arbre = 1, etats_max = 0;
+		long t2 = maintenant_ns();
+		Constructeur_acyclique * tries = creer_constructeur_acyclique();
+		for( i=0; i<k; i++ ){
+			ajouter_mot_acyclique( tries, mots[i] );
+			if( nombre_etats_acyclique( tries ) > etats_max ){
+				etats_max = nombre_etats_acyclique( tries );
+			}
+		}
+		long t3 = maintenant_ns();
+		Automate * automate = automate_acyclique( tries );
+
+		for( i=0; i<k; i++ ){
+			int commun = 0;
+			if( i > 0 ){
+				while( mots[i][commun] && mots[i][commun] == mots[i-1][commun] ){
+					commun++;
+				}
+			}
+			etats_arbre += strlen( mots[i] ) - commun;
+		}
+		printf(
+			"acyclique\t%d\t%d\t%d\t%u\t%ld\t%ld\n", k, etats_arbre, etats_max,
+			taille_ensemble( get_etats( automate ) ), t3 - t2, t1 - t0
+		);
+		liberer_automate( automate );
+		liberer_constructeur_acyclique( tries );
+		liberer_constructeur_acyclique( desordre );
+		xfree( mots );
+	}
+
+	return 0;
+}
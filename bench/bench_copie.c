@@ -0,0 +1,102 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate.h"
+#include "generateurs.h"
+#include "outils.h"
+
+#include <stdio.h>
+
+/*
+ * Compare copier_automate(), qui clone les arbres des ensembles et de la
+ * table des transitions, avec une copie par réinsertion de chaque état et de
+ * chaque transition, ainsi que cloner_automate() suivi d'une première
+ * écriture. Chaque ligne affichée est de la forme :
+ *   copie <etats> <transitions> <clonage_ns> <reinsertion_ns>
+ *   clone <etats> <transitions> <clone_ns> <premiere_ecriture_ns>
+ */
+
+static void action_reinserer( int origine, char lettre, int fin, void * data ){
+	ajouter_transition( (Automate *) data, origine, lettre, fin );
+}
+
+static Automate * copier_par_reinsertion( const Automate * automate ){
+	Automate * res = creer_automate();
+	Ensemble_iterateur it;
+	for(
+		it = premier_iterateur_ensemble( get_etats( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		ajouter_etat( res, get_element( it ) );
+	}
+	for(
+		it = premier_iterateur_ensemble( get_initiaux( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		ajouter_etat_initial( res, get_element( it ) );
+	}
+	for(
+		it = premier_iterateur_ensemble( get_finaux( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		ajouter_etat_final( res, get_element( it ) );
+	}
+	for(
+		it = premier_iterateur_ensemble( get_alphabet( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		ajouter_lettre( res, (char) get_element( it ) );
+	}
+	pour_toute_transition( automate, action_reinserer, res );
+	return res;
+}
+
+int main(){
+	int n;
+
+	for( n=1000; n<=64000; n*=4 ){
+		Automate * automate = automate_aleatoire( n, 26, 4, 0.25 );
+
+		long t0 = maintenant_ns();
+		Automate * clone = copier_automate( automate );
+		long t1 = maintenant_ns();
+		Automate * copie = copier_par_reinsertion( automate );
+		long t2 = maintenant_ns();
+
+		printf( "copie\t%d\t%d\t%ld\t%ld\n", n, n * 4, t1 - t0, t2 - t1 );
+
+		t0 = maintenant_ns();
+		Automate * variante = cloner_automate( automate );
+		t1 = maintenant_ns();
+		ajouter_transition( variante, 0, 'a', n - 1 );
+		t2 = maintenant_ns();
+		printf( "clone\t%d\t%d\t%ld\t%ld\n", n, n * 4, t1 - t0, t2 - t1 );
+		liberer_automate( variante );
+		liberer_automate( copie );
+		liberer_automate( clone );
+		liberer_automate( automate );
+	}
+
+	return 0;
+}
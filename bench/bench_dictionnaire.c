@@ -0,0 +1,87 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate.h"
+#include "dictionnaire.h"
+#include "generateurs.h"
+#include "outils.h"
+
+#include <stdio.h>
+
+/*
+ * Compare la construction d'un dictionnaire de k mots aléatoires avec l'union
+ * des k automates mot_to_automate(), puis mesure la recherche de tous les
+ * mots du dictionnaire dans un texte aléatoire. Chaque ligne affichée est de
+ * la forme :
+ *   union <mots> <union_ns> <dictionnaire_ns>
+ *   dictionnaire <mots> <construction_ns> <recherche_ns> <occurrences>
+ */
+
+int main(){
+	char mot[16];
+	int k, i;
+
+	for( k=100; k<=400; k*=2 ){
+		char ** mots = mots_aleatoires( k, 4, 12, 26 );
+		long t0 = maintenant_ns();
+		Automate * automate = creer_automate();
+		for( i=0; i<k; i++ ){
+			Automate * a = mot_to_automate( mots[i] );
+			Automate * u = creer_union_des_automates( automate, a );
+			liberer_automate( a );
+			liberer_automate( automate );
+			automate = u;
+		}
+		long t1 = maintenant_ns();
+		Dictionnaire * d = creer_dictionnaire();
+		for( i=0; i<k; i++ ){
+			ajouter_mot_dictionnaire( d, mots[i] );
+		}
+		long t2 = maintenant_ns();
+		printf( "union\t%d\t%ld\t%ld\n", k, t1 - t0, t2 - t1 );
+		liberer_dictionnaire( d );
+		liberer_mots( mots, k );
+		liberer_automate( automate );
+	}
+
+	int taille_texte = 1 << 20;
+	char * texte = xmalloc( taille_texte + 1 );
+	for( i=0; i<taille_texte; i++ ){
+		texte[i] = 'a' + alea( 26 );
+	}
+	texte[taille_texte] = '\0';
+
+	for( k=10000; k<=1000000; k*=10 ){
+		long t0 = maintenant_ns();
+		Dictionnaire * d = creer_dictionnaire();
+		for( i=0; i<k; i++ ){
+			mot_aleatoire( mot, 4 + alea( 9 ), 26 );
+			ajouter_mot_dictionnaire( d, mot );
+		}
+		long t1 = maintenant_ns();
+		int nb = rechercher_dictionnaire( d, texte, NULL, NULL );
+		long t2 = maintenant_ns();
+		printf( "dictionnaire\t%d\t%ld\t%ld\t%d\n", k, t1 - t0, t2 - t1, nb );
+		liberer_dictionnaire( d );
+	}
+	xfree( texte );
+
+	return 0;
+}
@@ -0,0 +1,143 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "automate.h"
+#include "automate_compile.h"
+#include "files_concurrentes.h"
+#include "pipeline.h"
+#include "generateurs.h"
+#include "outils.h"
+
+#include <pthread.h>
+
+/*
+ * Mesure le débit des files concurrentes et du pipeline de reconnaissance
+ * selon le nombre de fils d'exécution. Voir rapporter() pour le format des
+ * lignes affichées : la taille est le nombre de fils (de paires
+ * producteur/consommateur pour les files, de fils de reconnaissance pour le
+ * pipeline).
+ */
+
+#define NB_ELEMENTS 1000000
+#define CAPACITE 1024
+#define NB_MOTS 200000
+
+static void * produire_spsc( void * data ){
+	File_spsc * file = (File_spsc *) data;
+	for( intptr_t i = 0; i < NB_ELEMENTS; i++ ){
+		deposer_spsc_attendre( file, i );
+	}
+	return NULL;
+}
+
+typedef struct Fil_mpmc {
+	File_mpmc * file;
+	int nb_elements;
+} Fil_mpmc;
+
+static void * produire_mpmc( void * data ){
+	Fil_mpmc * fil = (Fil_mpmc *) data;
+	for( intptr_t i = 0; i < fil->nb_elements; i++ ){
+		deposer_mpmc_attendre( fil->file, i );
+	}
+	return NULL;
+}
+
+static void * consommer_mpmc( void * data ){
+	Fil_mpmc * fil = (Fil_mpmc *) data;
+	for( int i = 0; i < fil->nb_elements; i++ ){
+		prelever_mpmc_attendre( fil->file );
+	}
+	return NULL;
+}
+
+typedef struct Flot {
+	char ** mots;
+	int suivant;
+} Flot;
+
+static const char * lire_mot( void * data ){
+	Flot * flot = (Flot *) data;
+	if( flot->suivant == NB_MOTS ){
+		return NULL;
+	}
+	return flot->mots[ flot->suivant++ ];
+}
+
+static void compter_reconnus( long indice, const char * mot, int reconnu, void * data ){
+	*(long *) data += reconnu;
+}
+
+int main(){
+	int nb_fils;
+
+	{
+		File_spsc * file = creer_file_spsc( CAPACITE );
+		pthread_t producteur;
+		long t0 = maintenant_ns();
+		pthread_create( &producteur, NULL, produire_spsc, file );
+		for( int i = 0; i < NB_ELEMENTS; i++ ){
+			prelever_spsc_attendre( file );
+		}
+		pthread_join( producteur, NULL );
+		long t1 = maintenant_ns();
+		rapporter( "file_spsc", 1, NB_ELEMENTS, t1 - t0 );
+		liberer_file_spsc( file );
+	}
+
+	for( nb_fils = 1; nb_fils <= 8; nb_fils *= 2 ){
+		File_mpmc * file = creer_file_mpmc( CAPACITE );
+		Fil_mpmc fil = { file, NB_ELEMENTS / nb_fils };
+		pthread_t producteurs[8], consommateurs[8];
+		long t0 = maintenant_ns();
+		for( int i = 0; i < nb_fils; i++ ){
+			pthread_create( &consommateurs[i], NULL, consommer_mpmc, &fil );
+			pthread_create( &producteurs[i], NULL, produire_mpmc, &fil );
+		}
+		for( int i = 0; i < nb_fils; i++ ){
+			pthread_join( producteurs[i], NULL );
+			pthread_join( consommateurs[i], NULL );
+		}
+		long t1 = maintenant_ns();
+		rapporter( "file_mpmc", nb_fils, fil.nb_elements * nb_fils, t1 - t0 );
+		liberer_file_mpmc( file );
+	}
+
+	Automate * automate = automate_deterministe_aleatoire( 1000, 4, 3.5, 0.25 );
+	Automate_compile * compile = compiler_automate( automate );
+	char ** mots = mots_aleatoires( NB_MOTS, 8, 64, 4 );
+	for( nb_fils = 1; nb_fils <= 8; nb_fils *= 2 ){
+		Flot flot = { mots, 0 };
+		long nb_reconnus = 0;
+		long t0 = maintenant_ns();
+		reconnaitre_en_pipeline(
+			compile, lire_mot, &flot, compter_reconnus, &nb_reconnus, nb_fils
+		);
+		long t1 = maintenant_ns();
+		rapporter( "pipeline", nb_fils, NB_MOTS, t1 - t0 );
+	}
+	liberer_mots( mots, NB_MOTS );
+	liberer_automate_compile( compile );
+	liberer_automate( automate );
+
+	return 0;
+}
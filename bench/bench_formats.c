@@ -0,0 +1,61 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate.h"
+#include "formats.h"
+#include "generateurs.h"
+#include "outils.h"
+
+#include <stdio.h>
+
+/*
+ * Écrit un automate aléatoire dans un fichier temporaire, à chaque format
+ * lisible, puis le relit. Chaque ligne affichée est de la forme :
+ *   <format> <etats> <transitions> <octets> <ecriture_ns> <lecture_ns>
+ */
+
+int main(){
+	static const char * noms[] = { "att", "ba" };
+	int n, format;
+
+	for( n=1000; n<=100000; n*=10 ){
+		Automate * automate = automate_aleatoire( n, 26, 4, 0.25 );
+
+		for( format = FORMAT_ATT; format <= FORMAT_BA; format++ ){
+			FILE * flux = tmpfile();
+			long t0 = maintenant_ns();
+			ecrire_automate( automate, format, flux );
+			long t1 = maintenant_ns();
+			long octets = ftell( flux );
+			rewind( flux );
+			Automate * lu = lire_automate( format, flux, NULL );
+			long t2 = maintenant_ns();
+			printf(
+				"%s\t%d\t%d\t%ld\t%ld\t%ld\n", noms[format], n, n * 4, octets,
+				t1 - t0, t2 - t1
+			);
+			liberer_automate( lu );
+			fclose( flux );
+		}
+		liberer_automate( automate );
+	}
+
+	return 0;
+}
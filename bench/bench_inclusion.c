@@ -0,0 +1,98 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate.h"
+#include "automate_compile.h"
+#include "langage.h"
+#include "generateurs.h"
+#include "outils.h"
+
+#include <stdio.h>
+
+/*
+ * Compare le test d'inclusion par antichaînes (est_inclus) avec l'algorithme
+ * naïf qui déterminise les deux automates (compiler_automate puis
+ * est_inclus_compile). Chaque ligne affichée est de la forme :
+ *   inclusion <famille> <etats> <antichaine_ns> <naif_ns> <resultat>
+ */
+
+/*
+ * Automate de (a+b)*a(a+b)^k : son déterminisé a 2^(k+1) états.
+ */
+static Automate * automate_k_ieme_lettre( int k ){
+	Automate * automate = creer_automate();
+	int i;
+	ajouter_transition( automate, 0, 'a', 0 );
+	ajouter_transition( automate, 0, 'b', 0 );
+	ajouter_transition( automate, 0, 'a', 1 );
+	for( i=1; i<=k; i++ ){
+		ajouter_transition( automate, i, 'a', i+1 );
+		ajouter_transition( automate, i, 'b', i+1 );
+	}
+	ajouter_etat_initial( automate, 0 );
+	ajouter_etat_final( automate, k+1 );
+	return automate;
+}
+
+static void mesurer(
+	const char * famille, const Automate * auto1, const Automate * auto2
+){
+	long t0 = maintenant_ns();
+	int resultat = est_inclus( auto1, auto2, NULL );
+	long t1 = maintenant_ns();
+	Automate_compile * dfa1 = compiler_automate( auto1 );
+	Automate_compile * dfa2 = compiler_automate( auto2 );
+	int resultat_naif = est_inclus_compile( dfa1, dfa2, NULL );
+	long t2 = maintenant_ns();
+	liberer_automate_compile( dfa1 );
+	liberer_automate_compile( dfa2 );
+	if( resultat != resultat_naif ){
+		ERREUR( "Les deux algorithmes ne sont pas d'accord" );
+	}
+	printf(
+		"inclusion\t%s\t%d\t%ld\t%ld\t%d\n", famille,
+		taille_ensemble( get_etats( auto1 ) ), t1 - t0, t2 - t1, resultat
+	);
+}
+
+int main(){
+	int n, k;
+
+	for( n=8; n<=64; n*=2 ){
+		Automate * auto1 = automate_aleatoire( n, 2, 2, 0.25 );
+		Automate * auto2 = automate_aleatoire( n, 2, 2, 0.25 );
+		Automate * union_1_2 = creer_union_des_automates( auto1, auto2 );
+		mesurer( "aleatoire", auto1, auto2 );
+		mesurer( "aleatoire_inclus", auto1, union_1_2 );
+		liberer_automate( union_1_2 );
+		liberer_automate( auto1 );
+		liberer_automate( auto2 );
+	}
+
+	for( k=4; k<=12; k+=2 ){
+		Automate * auto1 = automate_k_ieme_lettre( k );
+		Automate * auto2 = automate_k_ieme_lettre( k );
+		mesurer( "k_ieme_lettre", auto1, auto2 );
+		liberer_automate( auto1 );
+		liberer_automate( auto2 );
+	}
+
+	return 0;
+}
@@ -0,0 +1,150 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate.h"
+#include "generateurs.h"
+#include "outils.h"
+
+#include <stdio.h>
+
+/*
+ * Mesure les opérations de base de la bibliothèque sur des automates
+ * aléatoires de tailles croissantes. Voir rapporter() pour le format des
+ * lignes affichées : la taille est le nombre de transitions de l'automate
+ * (ou le nombre de mots du dictionnaire).
+ */
+
+#define NB_LETTRES 8
+#define DENSITE 4
+#define NB_MOTS 10000
+#define LONGUEUR_MOTS 16
+
+static void mesurer_lectures( const Automate * automate, long taille ){
+	char ** mots = mots_aleatoires( NB_MOTS, LONGUEUR_MOTS, LONGUEUR_MOTS, NB_LETTRES );
+	int i, reconnus = 0;
+
+	long t0 = maintenant_ns();
+	for( i=0; i<NB_MOTS; i++ ){
+		Ensemble * etats = delta_star( automate, get_initiaux( automate ), mots[i] );
+		liberer_ensemble( etats );
+	}
+	long t1 = maintenant_ns();
+	rapporter( "delta_star", taille, NB_MOTS, t1 - t0 );
+
+	t0 = maintenant_ns();
+	for( i=0; i<NB_MOTS; i++ ){
+		reconnus += le_mot_est_reconnu( automate, mots[i] );
+	}
+	t1 = maintenant_ns();
+	rapporter( "le_mot_est_reconnu", taille, NB_MOTS, t1 - t0 );
+
+	liberer_mots( mots, NB_MOTS );
+}
+
+int main(){
+	int n, i;
+
+	for( n=1000; n<=100000; n*=10 ){
+		long nb_transitions = (long) n * DENSITE;
+		int * origines = xmalloc( sizeof(int) * nb_transitions );
+		char * lettres = xmalloc( nb_transitions );
+		int * fins = xmalloc( sizeof(int) * nb_transitions );
+		for( i=0; i<nb_transitions; i++ ){
+			origines[i] = alea( n );
+			lettres[i] = 'a' + alea( NB_LETTRES );
+			fins[i] = alea( n );
+		}
+
+		long t0 = maintenant_ns();
+		Automate * automate = creer_automate();
+		for( i=0; i<nb_transitions; i++ ){
+			ajouter_transition( automate, origines[i], lettres[i], fins[i] );
+		}
+		long t1 = maintenant_ns();
+		rapporter( "ajouter_transition", nb_transitions, nb_transitions, t1 - t0 );
+		ajouter_etat_initial( automate, 0 );
+		for( i=0; i<n; i+=4 ){
+			ajouter_etat_final( automate, i );
+		}
+		xfree( origines );
+		xfree( lettres );
+		xfree( fins );
+
+		mesurer_lectures( automate, nb_transitions );
+		Automate * deterministe = automate_deterministe_aleatoire(
+			n, NB_LETTRES, DENSITE, 0.25
+		);
+		mesurer_lectures( deterministe, nb_transitions );
+
+		t0 = maintenant_ns();
+		Automate * u = creer_union_des_automates( automate, deterministe );
+		t1 = maintenant_ns();
+		rapporter( "union", nb_transitions, 1, t1 - t0 );
+		liberer_automate( u );
+
+		t0 = maintenant_ns();
+		Automate * m = miroir( automate );
+		t1 = maintenant_ns();
+		rapporter( "miroir", nb_transitions, 1, t1 - t0 );
+		liberer_automate( m );
+
+		t0 = maintenant_ns();
+		Automate * copie = copier_automate( automate );
+		t1 = maintenant_ns();
+		rapporter( "copier_automate", nb_transitions, 1, t1 - t0 );
+		liberer_automate( copie );
+
+		liberer_automate( deterministe );
+		liberer_automate( automate );
+	}
+
+	for( n=1000; n<=100000; n*=10 ){
+		Automate * automate = automate_aleatoire( n, NB_LETTRES, DENSITE, 0.25 );
+		long t0 = maintenant_ns();
+		Ensemble * etats = accessibles( automate );
+		long t1 = maintenant_ns();
+		rapporter( "accessibles", (long) n * DENSITE, 1, t1 - t0 );
+		liberer_ensemble( etats );
+		liberer_automate( automate );
+	}
+
+	// Le mélange a pour états les couples d'états des deux automates.
+	for( n=10; n<=40; n*=2 ){
+		Automate * a1 = automate_aleatoire( n, NB_LETTRES, DENSITE, 0.25 );
+		Automate * a2 = automate_aleatoire( n, NB_LETTRES, DENSITE, 0.25 );
+		long t0 = maintenant_ns();
+		Automate * melange = creer_automate_du_melange( a1, a2 );
+		long t1 = maintenant_ns();
+		rapporter( "melange", (long) n * DENSITE, 1, t1 - t0 );
+		liberer_automate( melange );
+		liberer_automate( a1 );
+		liberer_automate( a2 );
+	}
+
+	for( n=100; n<=400; n*=2 ){
+		long t0 = maintenant_ns();
+		Automate * dictionnaire = dictionnaire_aleatoire( n, 4, 12, 26 );
+		long t1 = maintenant_ns();
+		rapporter( "dictionnaire_union", n, n, t1 - t0 );
+		liberer_automate( dictionnaire );
+	}
+
+	return 0;
+}
@@ -0,0 +1,184 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate.h"
+#include "automate_compile.h"
+#include "parallele.h"
+#include "generateurs.h"
+#include "outils.h"
+
+#include <string.h>
+
+/*
+ * Mesure les algorithmes parallèles (accessibilité sur un automate indexé
+ * aléatoire, puis par l'interface publique sur un automate aléatoire, 
+ * indexation comprise, et déterminisation d'un automate dont le déterminisé
+ * est exponentiel) selon le nombre de fils d'exécution.
+ * Voir rapporter() pour le format des lignes affichées : la taille est le
+ * nombre de fils (0 pour la version séquentielle).
+ */
+
+#define NB_ETATS 1000000
+#define NB_LETTRES 4
+#define DEGRE 8
+#define NB_ETATS_AUTOMATE 200000
+
+/*
+ * Renvoie un automate indexé aléatoire de nb_etats états, dont chaque état
+ * a 'degre' transitions réparties sur nb_lettres lettres.
+ */
+static Automate_indexe * automate_indexe_aleatoire(
+	int nb_etats, int nb_lettres, int degre
+){
+	Automate_indexe * automate = xmalloc( sizeof(Automate_indexe) );
+	memset( automate, 0, sizeof(Automate_indexe) );
+	automate->nb_etats = nb_etats;
+	automate->nb_lettres = nb_lettres;
+	automate->etats = xmalloc( sizeof(int) * nb_etats );
+	automate->debut = xmalloc( sizeof(int) * ( (long) nb_etats * nb_lettres + 1 ) );
+	automate->fins = xmalloc( sizeof(int) * (long) nb_etats * degre );
+	for( int l = 0; l < NB_LETTRES_MAX; l++ ){
+		automate->indice_lettre[l] = -1;
+	}
+	for( int l = 0; l < nb_lettres; l++ ){
+		automate->lettres[l] = 'a' + l;
+		automate->indice_lettre['a' + l] = l;
+	}
+	int t = 0;
+	for( int e = 0; e < nb_etats; e++ ){
+		automate->etats[e] = e;
+		for( int l = 0; l < nb_lettres; l++ ){
+			automate->debut[ e * nb_lettres + l ] = t;
+			for( int d = l; d < degre; d += nb_lettres ){
+				automate->fins[t++] = alea( nb_etats );
+			}
+		}
+	}
+	automate->debut[ nb_etats * nb_lettres ] = t;
+	automate->nb_transitions = t;
+	automate->nb_initiaux = 1;
+	automate->initiaux = xmalloc( sizeof(int) );
+	automate->initiaux[0] = 0;
+	automate->finaux = xmalloc( nb_etats );
+	memset( automate->finaux, 0, nb_etats );
+	automate->liste_finaux = xmalloc( sizeof(int) );
+	automate->est_initial = xmalloc( nb_etats );
+	memset( automate->est_initial, 0, nb_etats );
+	automate->est_initial[0] = 1;
+	return automate;
+}
+
+/*
+ * Renvoie l'automate non déterministe des mots sur {a, b} dont la
+ * (n+1)-ième lettre en partant de la fin est un 'a' : son déterminisé a
+ * 2^(n+1) états.
+ */
+static Automate * lettre_depuis_la_fin( int n ){
+	Automate * automate = creer_automate();
+	ajouter_transition( automate, 0, 'a', 0 );
+	ajouter_transition( automate, 0, 'b', 0 );
+	ajouter_transition( automate, 0, 'a', 1 );
+	for( int i = 1; i <= n; i++ ){
+		ajouter_transition( automate, i, 'a', i + 1 );
+		ajouter_transition( automate, i, 'b', i + 1 );
+	}
+	ajouter_etat_initial( automate, 0 );
+	ajouter_etat_final( automate, n + 1 );
+	return automate;
+}
+
+int main(){
+	Automate_indexe * automate = automate_indexe_aleatoire(
+		NB_ETATS, NB_LETTRES, DEGRE
+	);
+	unsigned char * marques = xmalloc( NB_ETATS );
+
+	long t0 = maintenant_ns();
+	marquer_accessibles_indexe( automate, marques );
+	long t1 = maintenant_ns();
+	rapporter( "accessibles_indexe", 0, 1, t1 - t0 );
+	for( int nb_fils = 1; nb_fils <= 16; nb_fils *= 2 ){
+		t0 = maintenant_ns();
+		marquer_accessibles_indexe_parallele( automate, marques, nb_fils );
+		t1 = maintenant_ns();
+		rapporter( "accessibles_parallele", nb_fils, 1, t1 - t0 );
+	}
+
+	xfree( marques );
+	liberer_automate_indexe( automate );
+
+	Automate * aleatoire = automate_aleatoire(
+		NB_ETATS_AUTOMATE, NB_LETTRES, DEGRE / 2, 0.1
+	);
+	t0 = maintenant_ns();
+	Automate_indexe * index = indexer_automate( aleatoire );
+	t1 = maintenant_ns();
+	rapporter( "indexer_automate", 0, 1, t1 - t0 );
+	liberer_automate_indexe( index );
+	for( int nb_fils = 1; nb_fils <= 16; nb_fils *= 2 ){
+		t0 = maintenant_ns();
+		index = indexer_automate_parallele( aleatoire, nb_fils );
+		t1 = maintenant_ns();
+		rapporter( "indexer_automate_parallele", nb_fils, 1, t1 - t0 );
+		liberer_automate_indexe( index );
+	}
+	t0 = maintenant_ns();
+	Ensemble * etats = accessibles( aleatoire );
+	t1 = maintenant_ns();
+	rapporter( "accessibles", 0, 1, t1 - t0 );
+	liberer_ensemble( etats );
+	for( int nb_fils = 2; nb_fils <= 16; nb_fils *= 2 ){
+		t0 = maintenant_ns();
+		etats = accessibles_parallele( aleatoire, nb_fils );
+		t1 = maintenant_ns();
+		rapporter( "accessibles_parallele(automate)", nb_fils, 1, t1 - t0 );
+		liberer_ensemble( etats );
+	}
+	t0 = maintenant_ns();
+	Automate * accessible = automate_accessible( aleatoire );
+	t1 = maintenant_ns();
+	rapporter( "automate_accessible", 0, 1, t1 - t0 );
+	liberer_automate( accessible );
+	for( int nb_fils = 2; nb_fils <= 16; nb_fils *= 2 ){
+		t0 = maintenant_ns();
+		accessible = automate_accessible_parallele( aleatoire, nb_fils );
+		t1 = maintenant_ns();
+		rapporter( "automate_accessible_parallele", nb_fils, 1, t1 - t0 );
+		liberer_automate( accessible );
+	}
+	liberer_automate( aleatoire );
+
+	Automate * nfa = lettre_depuis_la_fin( 15 );
+	t0 = maintenant_ns();
+	Automate_compile * dfa = compiler_automate( nfa );
+	t1 = maintenant_ns();
+	rapporter( "compiler_automate", 0, 1, t1 - t0 );
+	liberer_automate_compile( dfa );
+	for( int nb_fils = 1; nb_fils <= 16; nb_fils *= 2 ){
+		t0 = maintenant_ns();
+		dfa = compiler_automate_parallele( nfa, nb_fils );
+		t1 = maintenant_ns();
+		rapporter( "compiler_automate_parallele", nb_fils, 1, t1 - t0 );
+		liberer_automate_compile( dfa );
+	}
+	liberer_automate( nfa );
+
+	return 0;
+}
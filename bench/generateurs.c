@@ -0,0 +1,165 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2014, 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "generateurs.h"
+#include "outils.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#include <sys/resource.h>
+
+static uint64_t graine = 2016;
+
+void initialiser_alea( uint64_t nouvelle_graine ){
+	graine = nouvelle_graine;
+}
+
+static uint64_t suivant(){
+	graine ^= graine >> 12;
+	graine ^= graine << 25;
+	graine ^= graine >> 27;
+	return graine * UINT64_C(2685821657736338717);
+}
+
+int alea( int n ){
+	return (int) ( ( suivant() >> 11 ) % (uint64_t) n );
+}
+
+double alea_reel(){
+	return ( suivant() >> 11 ) * ( 1.0 / ( UINT64_C(1) << 53 ) );
+}
+
+static void ajouter_finaux( Automate * automate, int nb_etats, double proportion ){
+	int i;
+	for( i=0; i<nb_etats; i++ ){
+		if( alea_reel() < proportion ){
+			ajouter_etat_final( automate, i );
+		}
+	}
+}
+
+Automate * automate_aleatoire(
+	int nb_etats, int nb_lettres, double densite, double proportion_finaux
+){
+	Automate * automate = creer_automate();
+	long nb_transitions = (long) ( nb_etats * densite );
+	long i;
+	for( i=0; i<nb_etats; i++ ){
+		ajouter_etat( automate, i );
+	}
+	for( i=0; i<nb_transitions; i++ ){
+		ajouter_transition(
+			automate, alea( nb_etats ), 'a' + alea( nb_lettres ), alea( nb_etats )
+		);
+	}
+	ajouter_etat_initial( automate, 0 );
+	ajouter_finaux( automate, nb_etats, proportion_finaux );
+	return automate;
+}
+
+Automate * automate_deterministe_aleatoire(
+	int nb_etats, int nb_lettres, double densite, double proportion_finaux
+){
+	Automate * automate = creer_automate();
+	double probabilite = densite / nb_lettres;
+	int i, l;
+	for( i=0; i<nb_etats; i++ ){
+		ajouter_etat( automate, i );
+		for( l=0; l<nb_lettres; l++ ){
+			if( alea_reel() < probabilite ){
+				ajouter_transition( automate, i, 'a' + l, alea( nb_etats ) );
+			}
+		}
+	}
+	ajouter_etat_initial( automate, 0 );
+	ajouter_finaux( automate, nb_etats, proportion_finaux );
+	return automate;
+}
+
+void mot_aleatoire( char * mot, int longueur, int nb_lettres ){
+	int i;
+	for( i=0; i<longueur; i++ ){
+		mot[i] = 'a' + alea( nb_lettres );
+	}
+	mot[longueur] = '\0';
+}
+
+char ** mots_aleatoires(
+	int nb_mots, int longueur_min, int longueur_max, int nb_lettres
+){
+	char ** mots = xmalloc( sizeof(char *) * ( nb_mots + 1 ) );
+	int i;
+	for( i=0; i<nb_mots; i++ ){
+		int longueur = longueur_min + alea( longueur_max - longueur_min + 1 );
+		mots[i] = xmalloc( longueur + 1 );
+		mot_aleatoire( mots[i], longueur, nb_lettres );
+	}
+	return mots;
+}
+
+void liberer_mots( char ** mots, int nb_mots ){
+	int i;
+	for( i=0; i<nb_mots; i++ ){
+		xfree( mots[i] );
+	}
+	xfree( mots );
+}
+
+Automate * dictionnaire_aleatoire(
+	int nb_mots, int longueur_min, int longueur_max, int nb_lettres
+){
+	char ** mots = mots_aleatoires( nb_mots, longueur_min, longueur_max, nb_lettres );
+	Automate * res = creer_automate();
+	int i;
+	for( i=0; i<nb_mots; i++ ){
+		Automate * mot = mot_to_automate( mots[i] );
+		Automate * u = creer_union_des_automates( res, mot );
+		liberer_automate( mot );
+		liberer_automate( res );
+		res = u;
+	}
+	liberer_mots( mots, nb_mots );
+	return res;
+}
+
+long maintenant_ns(){
+	struct timespec t;
+	clock_gettime( CLOCK_MONOTONIC, &t );
+	return t.tv_sec * 1000000000L + t.tv_nsec;
+}
+
+long pic_rss_ko(){
+	struct rusage utilisation;
+	getrusage( RUSAGE_SELF, &utilisation );
+	return utilisation.ru_maxrss;
+}
+
+void rapporter( const char * operation, long taille, long nb_operations, long ns ){
+	double ns_par_operation = nb_operations ? (double) ns / nb_operations : 0;
+	double operations_par_seconde = ns ? 1e9 * nb_operations / ns : 0;
+	printf(
+		"%s\t%ld\t%ld\t%ld\t%.1f\t%.0f\t%ld\n", operation, taille, nb_operations,
+		ns, ns_par_operation, operations_par_seconde, pic_rss_ko()
+	);
+	fflush( stdout );
+}
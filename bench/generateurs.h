@@ -0,0 +1,119 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2014, 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file generateurs.h */
+
+#ifndef __GENERATEURS_H__
+#define __GENERATEURS_H__
+
+#include "automate.h"
+
+#include <stdint.h>
+
+/*
+ * Outils communs aux programmes de mesure du répertoire bench : générateurs
+ * aléatoires d'automates et de mots, mesure du temps et de la mémoire, et
+ * affichage des résultats.
+ *
+ * Le générateur aléatoire est un xorshift64* global : deux exécutions du
+ * même programme produisent donc les mêmes automates.
+ */
+
+/*
+ * Réinitialise le générateur aléatoire (la graine ne doit pas valoir 0).
+ */
+void initialiser_alea( uint64_t graine );
+
+/*
+ * Renvoie un entier aléatoire uniforme dans [0, n[.
+ */
+int alea( int n );
+
+/*
+ * Renvoie un réel aléatoire uniforme dans [0, 1[.
+ */
+double alea_reel();
+
+/*
+ * Renvoie un automate aléatoire, en général non déterministe, dont les états
+ * sont 0, ..., nb_etats-1 et les lettres les nb_lettres premières lettres
+ * à partir de 'a'. Il a nb_etats * densite transitions tirées au hasard,
+ * l'état initial 0, et chaque état est final avec la probabilité
+ * proportion_finaux.
+ */
+Automate * automate_aleatoire(
+	int nb_etats, int nb_lettres, double densite, double proportion_finaux
+);
+
+/*
+ * Renvoie un automate déterministe aléatoire : chaque couple (état, lettre)
+ * a une transition avec la probabilité densite / nb_lettres (donc en
+ * moyenne 'densite' transitions par état), vers un état tiré au hasard.
+ */
+Automate * automate_deterministe_aleatoire(
+	int nb_etats, int nb_lettres, double densite, double proportion_finaux
+);
+
+/*
+ * Remplit 'mot' avec un mot aléatoire de la longueur donnée sur les
+ * nb_lettres premières lettres, suivi de '\0'.
+ */
+void mot_aleatoire( char * mot, int longueur, int nb_lettres );
+
+/*
+ * Renvoie un tableau de nb_mots mots aléatoires, de longueurs comprises entre
+ * longueur_min et longueur_max. Il est à libérer avec liberer_mots().
+ */
+char ** mots_aleatoires(
+	int nb_mots, int longueur_min, int longueur_max, int nb_lettres
+);
+
+/*
+ * Libère un tableau de mots renvoyé par mots_aleatoires().
+ */
+void liberer_mots( char ** mots, int nb_mots );
+
+/*
+ * Renvoie l'union des automates mot_to_automate() de nb_mots mots
+ * aléatoires.
+ */
+Automate * dictionnaire_aleatoire(
+	int nb_mots, int longueur_min, int longueur_max, int nb_lettres
+);
+
+/*
+ * Renvoie le temps écoulé, en nanosecondes, depuis une origine arbitraire.
+ */
+long maintenant_ns();
+
+/*
+ * Renvoie le pic de mémoire résidente du processus, en kilo-octets.
+ */
+long pic_rss_ko();
+
+/*
+ * Affiche une ligne de résultat, de la forme :
+ *   <operation> <taille> <nb_operations> <ns> <ns_par_operation>
+ *   <operations_par_seconde> <pic_rss_ko>
+ * séparée par des tabulations.
+ */
+void rapporter( const char * operation, long taille, long nb_operations, long ns );
+
+#endif
@@ -0,0 +1,306 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2014, 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "comptage.h"
+#include "automate_compile.h"
+#include "outils.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <assert.h>
+
+/*
+ * Dans ce fichier, le puits implicite d'un automate compilé à n états est
+ * représenté par l'indice n, afin de pouvoir compter les mots qui passent par
+ * un puits final (par exemple dans le complémentaire d'un automate).
+ */
+
+struct Comptage_mots {
+	Automate_compile * automate;
+	int longueur_max;
+	int nb_utiles;
+	int * indice_utile; //!< Indice compact d'un état (puits compris), ou -1.
+	double * nombres; //!< nombres[ l*nb_utiles + u ] : mots de longueur l.
+	int * exposants; //!< Les nombres de longueur l sont à multiplier par 2^exposants[l].
+};
+
+static int indice_puits( const Automate_compile * automate, int etat ){
+	return ( etat == ETAT_PUITS ) ? automate->nb_etats : etat;
+}
+
+static int successeur( const Automate_compile * automate, int etat, int lettre ){
+	if( etat == automate->nb_etats ) return etat;
+	return indice_puits(
+		automate, automate->transitions[ etat * automate->nb_lettres + lettre ]
+	);
+}
+
+static int est_final_indice( const Automate_compile * automate, int etat ){
+	if( etat == automate->nb_etats ) return automate->puits_final;
+	return automate->finaux[etat];
+}
+
+/*
+ * Renvoie un nombre modulo 'modulo' (modulo 2^64 si 'modulo' vaut 0), en
+ * supposant que a et b sont déjà réduits.
+ */
+static uint64_t ajouter_modulo( uint64_t a, uint64_t b, uint64_t modulo ){
+	uint64_t somme = a + b;
+	if( modulo && ( somme < a || somme >= modulo ) ){
+		somme -= modulo;
+	}
+	return somme;
+}
+
+uint64_t compter_mots( const Automate * automate, int n, uint64_t modulo ){
+	Automate_compile * compile = compiler_automate( automate );
+	int nb = compile->nb_etats + 1;
+	int L = compile->nb_lettres;
+	uint64_t * courant = xmalloc( sizeof(uint64_t) * nb );
+	uint64_t * suivant = xmalloc( sizeof(uint64_t) * nb );
+	int i, e, l;
+
+	for( e=0; e<nb; e++ ){
+		courant[e] = est_final_indice( compile, e );
+		if( modulo == 1 ) courant[e] = 0;
+	}
+	for( i=0; i<n; i++ ){
+		for( e=0; e<nb; e++ ){
+			uint64_t somme = 0;
+			for( l=0; l<L; l++ ){
+				somme = ajouter_modulo(
+					somme, courant[ successeur( compile, e, l ) ], modulo
+				);
+			}
+			suivant[e] = somme;
+		}
+		uint64_t * tmp = courant;
+		courant = suivant;
+		suivant = tmp;
+	}
+	uint64_t resultat = courant[ indice_puits( compile, compile->initial ) ];
+
+	xfree( courant );
+	xfree( suivant );
+	liberer_automate_compile( compile );
+	return resultat;
+}
+
+/*
+ * Marque dans 'utile' les états (puits compris) depuis lesquels on peut
+ * atteindre un état final, par un parcours en largeur de l'automate inversé.
+ */
+static void marquer_co_accessibles(
+	const Automate_compile * automate, unsigned char * utile
+){
+	int nb = automate->nb_etats + 1;
+	int L = automate->nb_lettres;
+	int * debut = xmalloc( sizeof(int) * ( nb + 1 ) );
+	int * origines = xmalloc( sizeof(int) * ( (size_t) nb * L + 1 ) );
+	int * file = xmalloc( sizeof(int) * nb );
+	int debut_file = 0, fin_file = 0;
+	int e, l, t;
+
+	memset( debut, 0, sizeof(int) * ( nb + 1 ) );
+	for( e=0; e<nb; e++ ){
+		for( l=0; l<L; l++ ){
+			debut[ successeur( automate, e, l ) + 1 ]++;
+		}
+	}
+	for( e=0; e<nb; e++ ){
+		debut[e+1] += debut[e];
+	}
+	int * position = xmalloc( sizeof(int) * nb );
+	memcpy( position, debut, sizeof(int) * nb );
+	for( e=0; e<nb; e++ ){
+		for( l=0; l<L; l++ ){
+			origines[ position[ successeur( automate, e, l ) ]++ ] = e;
+		}
+	}
+	xfree( position );
+
+	for( e=0; e<nb; e++ ){
+		utile[e] = 0;
+		if( est_final_indice( automate, e ) ){
+			utile[e] = 1;
+			file[fin_file++] = e;
+		}
+	}
+	while( debut_file < fin_file ){
+		e = file[debut_file++];
+		for( t=debut[e]; t<debut[e+1]; t++ ){
+			int o = origines[t];
+			if( ! utile[o] ){
+				utile[o] = 1;
+				file[fin_file++] = o;
+			}
+		}
+	}
+	xfree( debut );
+	xfree( origines );
+	xfree( file );
+}
+
+Comptage_mots * creer_comptage_mots( const Automate * automate, int longueur_max ){
+	assert( longueur_max >= 0 );
+	Comptage_mots * res = xmalloc( sizeof(Comptage_mots) );
+	Automate_compile * compile = compiler_automate( automate );
+	int nb = compile->nb_etats + 1;
+	int L = compile->nb_lettres;
+	unsigned char * utile = xmalloc( nb );
+	int i, e, l;
+
+	res->automate = compile;
+	res->longueur_max = longueur_max;
+	res->indice_utile = xmalloc( sizeof(int) * nb );
+	res->nb_utiles = 0;
+	marquer_co_accessibles( compile, utile );
+	for( e=0; e<nb; e++ ){
+		res->indice_utile[e] = utile[e] ? res->nb_utiles++ : -1;
+	}
+	xfree( utile );
+
+	// Les nombres de mots croissent jusqu'à |Σ|^longueur et dépassent vite 
+	// la plage des doubles : chaque longueur est divisée par une puissance de
+	// 2 qui ramène son plus grand nombre dans [1/2, 1[. Les rapports entre
+	// nombres d'une même longueur, seuls utiles au tirage, sont conservés.
+	int U = res->nb_utiles;
+	res->nombres = xmalloc( sizeof(double) * (size_t) ( longueur_max + 1 ) * U + 1 );
+	res->exposants = xmalloc( sizeof(int) * ( longueur_max + 1 ) );
+	res->exposants[0] = 0;
+	for( e=0; e<nb; e++ ){
+		int u = res->indice_utile[e];
+		if( u != -1 ){
+			res->nombres[u] = est_final_indice( compile, e );
+		}
+	}
+	for( i=1; i<=longueur_max; i++ ){
+		const double * precedent = res->nombres + (size_t) ( i - 1 ) * U;
+		double * courant = res->nombres + (size_t) i * U;
+		double max = 0;
+		for( e=0; e<nb; e++ ){
+			int u = res->indice_utile[e];
+			if( u == -1 ) continue;
+			double somme = 0;
+			for( l=0; l<L; l++ ){
+				int v = res->indice_utile[ successeur( compile, e, l ) ];
+				if( v != -1 ) somme += precedent[v];
+			}
+			courant[u] = somme;
+			if( somme > max ) max = somme;
+		}
+		int exposant = 0;
+		frexp( max, &exposant );
+		for( e=0; e<U; e++ ){
+			courant[e] = ldexp( courant[e], -exposant );
+		}
+		res->exposants[i] = res->exposants[i-1] + exposant;
+	}
+	return res;
+}
+
+void liberer_comptage_mots( Comptage_mots * comptage ){
+	liberer_automate_compile( comptage->automate );
+	xfree( comptage->indice_utile );
+	xfree( comptage->nombres );
+	xfree( comptage->exposants );
+	xfree( comptage );
+}
+
+/*
+ * Renvoie le nombre de mots de longueur donnée, divisé par 
+ * 2^exposants[longueur].
+ */
+static double nombre_reduit( const Comptage_mots * comptage, int longueur ){
+	assert( longueur >= 0 && longueur <= comptage->longueur_max );
+	const Automate_compile * automate = comptage->automate;
+	int u = comptage->indice_utile[ indice_puits( automate, automate->initial ) ];
+	if( u == -1 ) return 0;
+	return comptage->nombres[ (size_t) longueur * comptage->nb_utiles + u ];
+}
+
+double nombre_de_mots( const Comptage_mots * comptage, int longueur ){
+	return ldexp(
+		nombre_reduit( comptage, longueur ), comptage->exposants[longueur]
+	);
+}
+
+double log2_nombre_de_mots( const Comptage_mots * comptage, int longueur ){
+	double nombre = nombre_reduit( comptage, longueur );
+	if( nombre == 0 ) return -INFINITY;
+	return log2( nombre ) + comptage->exposants[longueur];
+}
+
+/*
+ * Générateur xorshift64* : renvoie un réel uniforme dans [0, 1[.
+ */
+static double aleatoire( uint64_t * graine ){
+	uint64_t x = *graine;
+	x ^= x >> 12;
+	x ^= x << 25;
+	x ^= x >> 27;
+	*graine = x;
+	return ( ( x * UINT64_C(2685821657736338717) ) >> 11 ) * ( 1.0 / 9007199254740992.0 );
+}
+
+char * echantillonner_mot(
+	const Comptage_mots * comptage, int longueur, uint64_t * graine
+){
+	assert( *graine != 0 );
+	if( nombre_reduit( comptage, longueur ) == 0 ) return NULL;
+
+	const Automate_compile * automate = comptage->automate;
+	int L = automate->nb_lettres;
+	int U = comptage->nb_utiles;
+	char * mot = xmalloc( longueur + 1 );
+	int e = indice_puits( automate, automate->initial );
+	int r, l;
+
+	for( r=longueur; r>0; r-- ){
+		// Les successeurs sont pondérés par leurs nombres de mots de longueur
+		// r-1, qui sont tous à la même échelle : leur somme est recalculée 
+		// plutôt que lue à la longueur r, qui n'a pas la même échelle.
+		const double * reste = comptage->nombres + (size_t) ( r - 1 ) * U;
+		double total = 0;
+		for( l=0; l<L; l++ ){
+			int v = comptage->indice_utile[ successeur( automate, e, l ) ];
+			if( v != -1 ) total += reste[v];
+		}
+		double x = aleatoire( graine ) * total;
+		int choisie = -1;
+		for( l=0; l<L; l++ ){
+			int v = comptage->indice_utile[ successeur( automate, e, l ) ];
+			if( v == -1 || reste[v] == 0 ) continue;
+			choisie = l;
+			if( x < reste[v] ) break;
+			x -= reste[v];
+		}
+		// x est inférieur au total, mais les arrondis des soustractions 
+		// peuvent faire dépasser la dernière lettre : on garde alors la 
+		// dernière lettre possible.
+		assert( choisie != -1 );
+		mot[ longueur - r ] = automate->lettres[choisie];
+		e = successeur( automate, e, choisie );
+	}
+	mot[longueur] = '\0';
+	return mot;
+}
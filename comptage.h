@@ -0,0 +1,132 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2014, 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file comptage.h */
+
+#ifndef __COMPTAGE_H__
+#define __COMPTAGE_H__
+
+#include "automate.h"
+
+#include <stdint.h>
+
+#pragma GCC visibility push(default)
+
+/**
+ * @brief Le type des tables de comptage des mots d'un automate.
+ *
+ * Une table de comptage contient, pour chaque longueur l inférieure ou égale
+ * à une longueur maximale, et pour chaque état utile (accessible et
+ * co-accessible) de l'automate compilé, le nombre de mots de longueur l qui
+ * mènent de cet état à un état final. Elle permet de compter et de tirer
+ * uniformément des mots sans refaire le calcul.
+ */
+typedef struct Comptage_mots Comptage_mots;
+
+/**
+ * @brief Renvoie le nombre de mots de longueur n reconnus par l'automate,
+ *        modulo 'modulo'.
+ *
+ * L'automate est compilé, puis les mots sont comptés par programmation
+ * dynamique en O(n.|T|), où |T| est le nombre de transitions de l'automate
+ * compilé. Si 'modulo' vaut 0, le calcul est fait modulo 2^64 : le résultat
+ * est donc exact tant qu'il y a moins de 2^64 mots.
+ *
+ * @param automate Un automate.
+ * @param n Une longueur.
+ * @param modulo Le modulo, ou 0.
+ * @return Le nombre de mots.
+ */
+uint64_t compter_mots( const Automate * automate, int n, uint64_t modulo );
+
+/**
+ * @brief Crée la table de comptage des mots de longueur au plus
+ *        'longueur_max' d'un automate.
+ *
+ * Le calcul prend un temps O(longueur_max.|T|). Les nombres de mots sont
+ * stockés en double précision, avec un exposant commun à chaque longueur : 
+ * ils ne débordent pas, sont exacts jusqu'à 2^53, et au-delà l'erreur 
+ * relative est de l'ordre de 2^-53. Un état qui a plus de 2^1000 fois moins
+ * de mots que l'état le mieux pourvu de même longueur peut être compté 
+ * comme n'en ayant aucun.
+ *
+ * @param automate Un automate.
+ * @param longueur_max La longueur maximale des mots.
+ * @return La table de comptage.
+ */
+Comptage_mots * creer_comptage_mots( const Automate * automate, int longueur_max );
+
+/**
+ * @brief Détruit une table de comptage.
+ *
+ * @param comptage La table à détruire.
+ */
+void liberer_comptage_mots( Comptage_mots * comptage );
+
+/**
+ * @brief Renvoie le nombre de mots reconnus de longueur donnée.
+ *
+ * Le résultat vaut +inf s'il dépasse le plus grand double : voir
+ * log2_nombre_de_mots().
+ *
+ * @param comptage Une table de comptage.
+ * @param longueur Une longueur inférieure ou égale à la longueur maximale de
+ *        la table.
+ * @return Le nombre de mots.
+ */
+double nombre_de_mots( const Comptage_mots * comptage, int longueur );
+
+/**
+ * @brief Renvoie le logarithme en base 2 du nombre de mots reconnus de 
+ *        longueur donnée, ou -inf s'il n'y en a aucun.
+ *
+ * Contrairement à nombre_de_mots(), le résultat est fini pour toute
+ * longueur.
+ *
+ * @param comptage Une table de comptage.
+ * @param longueur Une longueur inférieure ou égale à la longueur maximale de
+ *        la table.
+ * @return Le logarithme du nombre de mots.
+ */
+double log2_nombre_de_mots( const Comptage_mots * comptage, int longueur );
+
+/**
+ * @brief Tire uniformément un mot reconnu de longueur donnée.
+ *
+ * Le tirage prend un temps O(longueur.|Σ|). Le générateur aléatoire est un
+ * xorshift64* dont l'état est pointé par 'graine' (qui ne doit pas valoir 0)
+ * et qui est mis à jour à chaque tirage.
+ *
+ * Le mot renvoyé est à libérer avec xfree(). S'il n'existe aucun mot reconnu
+ * de cette longueur, la fonction renvoie NULL.
+ *
+ * @param comptage Une table de comptage.
+ * @param longueur Une longueur inférieure ou égale à la longueur maximale de
+ *        la table.
+ * @param graine L'état du générateur aléatoire.
+ * @return Le mot tiré, ou NULL.
+ */
+char * echantillonner_mot(
+	const Comptage_mots * comptage, int longueur, uint64_t * graine
+);
+
+#pragma GCC visibility pop
+
+#endif
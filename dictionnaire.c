@@ -0,0 +1,363 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2014, 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dictionnaire.h"
+#include "ensemble.h"
+#include "outils.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <assert.h>
+
+typedef struct {
+	int premier_fils;
+	int frere; //!< Le fils suivant du même père, ou -1.
+	int lettre; //!< La lettre qui mène du père à ce nœud.
+	int suppleance; //!< Le nœud du plus long suffixe propre dans l'arbre.
+	int sortie; //!< Le nœud du plus long suffixe propre qui est un mot, ou -1.
+	int mot; //!< Le numéro du mot qui se termine en ce nœud, ou -1.
+} Noeud;
+
+struct Dictionnaire {
+	int nb_noeuds;
+	int capacite_noeuds;
+	Noeud * noeuds;
+	int nb_mots;
+	int capacite_mots;
+	int * longueurs; //!< Longueur de chaque mot.
+	int * fins; //!< Nœud de chaque mot.
+	// Table de hachage (adressage ouvert) des fils : la clé d'un fils est
+	// père * NB_LETTRES_MAX + lettre.
+	int capacite_fils; //!< Une puissance de 2.
+	int64_t * cles;
+	int * fils;
+	// Les nœuds dans l'ordre du parcours en largeur, qui sert de file lors
+	// du calcul des liens de suppléance.
+	int * ordre;
+	int suppleances_a_jour;
+};
+
+static int creer_noeud( Dictionnaire * d, int lettre ){
+	if( d->nb_noeuds == d->capacite_noeuds ){
+		d->capacite_noeuds *= 2;
+		d->noeuds = xrealloc( d->noeuds, sizeof(Noeud) * d->capacite_noeuds );
+	}
+	Noeud * n = &d->noeuds[ d->nb_noeuds ];
+	n->premier_fils = -1;
+	n->frere = -1;
+	n->lettre = lettre;
+	n->suppleance = 0;
+	n->sortie = -1;
+	n->mot = -1;
+	return d->nb_noeuds++;
+}
+
+Dictionnaire * creer_dictionnaire(){
+	Dictionnaire * res = xmalloc( sizeof(Dictionnaire) );
+	int i;
+	res->nb_noeuds = 0;
+	res->capacite_noeuds = 16;
+	res->noeuds = xmalloc( sizeof(Noeud) * res->capacite_noeuds );
+	res->nb_mots = 0;
+	res->capacite_mots = 16;
+	res->longueurs = xmalloc( sizeof(int) * res->capacite_mots );
+	res->fins = xmalloc( sizeof(int) * res->capacite_mots );
+	res->capacite_fils = 32;
+	res->cles = xmalloc( sizeof(int64_t) * res->capacite_fils );
+	res->fils = xmalloc( sizeof(int) * res->capacite_fils );
+	for( i=0; i<res->capacite_fils; i++ ){
+		res->cles[i] = -1;
+	}
+	res->ordre = NULL;
+	res->suppleances_a_jour = 0;
+	creer_noeud( res, -1 );
+	return res;
+}
+
+void liberer_dictionnaire( Dictionnaire * dictionnaire ){
+	assert( dictionnaire );
+	xfree( dictionnaire->noeuds );
+	xfree( dictionnaire->longueurs );
+	xfree( dictionnaire->fins );
+	xfree( dictionnaire->cles );
+	xfree( dictionnaire->fils );
+	xfree( dictionnaire->ordre );
+	xfree( dictionnaire );
+}
+
+/*
+ * Renvoie la case de la table des fils où se trouve la clé, ou bien la case
+ * vide où elle doit être ajoutée.
+ */
+static int case_fils( const Dictionnaire * d, int64_t cle ){
+	int masque = d->capacite_fils - 1;
+	int i = (int) ( empreinte_element( (intptr_t) cle ) & masque );
+	while( d->cles[i] != -1 && d->cles[i] != cle ){
+		i = ( i + 1 ) & masque;
+	}
+	return i;
+}
+
+static int trouver_fils( const Dictionnaire * d, int noeud, unsigned char lettre ){
+	int i = case_fils( d, (int64_t) noeud * NB_LETTRES_MAX + lettre );
+	return d->cles[i] == -1 ? -1 : d->fils[i];
+}
+
+static void agrandir_fils( Dictionnaire * d ){
+	int64_t * cles = d->cles;
+	int * fils = d->fils;
+	int capacite = d->capacite_fils;
+	int i;
+
+	d->capacite_fils *= 2;
+	d->cles = xmalloc( sizeof(int64_t) * d->capacite_fils );
+	d->fils = xmalloc( sizeof(int) * d->capacite_fils );
+	for( i=0; i<d->capacite_fils; i++ ){
+		d->cles[i] = -1;
+	}
+	for( i=0; i<capacite; i++ ){
+		if( cles[i] != -1 ){
+			int j = case_fils( d, cles[i] );
+			d->cles[j] = cles[i];
+			d->fils[j] = fils[i];
+		}
+	}
+	xfree( cles );
+	xfree( fils );
+}
+
+int ajouter_mot_dictionnaire( Dictionnaire * dictionnaire, const char * mot ){
+	Dictionnaire * d = dictionnaire;
+	int noeud = 0;
+	int i;
+
+	for( i=0; mot[i] != '\0'; i++ ){
+		unsigned char lettre = mot[i];
+		int64_t cle = (int64_t) noeud * NB_LETTRES_MAX + lettre;
+		int c = case_fils( d, cle );
+		if( d->cles[c] != -1 ){
+			noeud = d->fils[c];
+			continue;
+		}
+		// Le nombre de fils est nb_noeuds-1 : la table reste au plus à
+		// moitié pleine.
+		if( 2 * d->nb_noeuds > d->capacite_fils ){
+			agrandir_fils( d );
+			c = case_fils( d, cle );
+		}
+		int fils = creer_noeud( d, lettre );
+		d->cles[c] = cle;
+		d->fils[c] = fils;
+		d->noeuds[fils].frere = d->noeuds[noeud].premier_fils;
+		d->noeuds[noeud].premier_fils = fils;
+		d->suppleances_a_jour = 0;
+		noeud = fils;
+	}
+
+	if( d->noeuds[noeud].mot != -1 ){
+		return d->noeuds[noeud].mot;
+	}
+	if( d->nb_mots == d->capacite_mots ){
+		d->capacite_mots *= 2;
+		d->longueurs = xrealloc( d->longueurs, sizeof(int) * d->capacite_mots );
+		d->fins = xrealloc( d->fins, sizeof(int) * d->capacite_mots );
+	}
+	d->longueurs[ d->nb_mots ] = i;
+	d->fins[ d->nb_mots ] = noeud;
+	d->noeuds[noeud].mot = d->nb_mots;
+	d->suppleances_a_jour = 0;
+	return d->nb_mots++;
+}
+
+int trouver_mot_dictionnaire(
+	const Dictionnaire * dictionnaire, const char * mot
+){
+	int noeud = 0;
+	int i;
+	for( i=0; mot[i] != '\0' && noeud != -1; i++ ){
+		noeud = trouver_fils( dictionnaire, noeud, mot[i] );
+	}
+	return noeud == -1 ? -1 : dictionnaire->noeuds[noeud].mot;
+}
+
+int taille_dictionnaire( const Dictionnaire * dictionnaire ){
+	return dictionnaire->nb_mots;
+}
+
+int longueur_mot_dictionnaire( const Dictionnaire * dictionnaire, int mot ){
+	assert( mot >= 0 && mot < dictionnaire->nb_mots );
+	return dictionnaire->longueurs[mot];
+}
+
+/*
+ * Calcule les liens de suppléance et de sortie par un parcours en largeur
+ * de l'arbre : la suppléance d'un nœud est moins profonde que lui, et elle
+ * est donc calculée avant lui.
+ */
+static void calculer_suppleances( Dictionnaire * d ){
+	Noeud * noeuds = d->noeuds;
+	int debut = 0, fin = 0;
+
+	if( d->suppleances_a_jour ) return;
+	xfree( d->ordre );
+	d->ordre = xmalloc( sizeof(int) * d->nb_noeuds );
+
+	d->ordre[ fin++ ] = 0;
+	noeuds[0].suppleance = 0;
+	noeuds[0].sortie = -1;
+	while( debut < fin ){
+		int pere = d->ordre[ debut++ ];
+		int fils;
+		for( fils = noeuds[pere].premier_fils; fils != -1; fils = noeuds[fils].frere ){
+			int s = 0;
+			if( pere != 0 ){
+				int f = noeuds[pere].suppleance;
+				s = trouver_fils( d, f, noeuds[fils].lettre );
+				while( s == -1 && f != 0 ){
+					f = noeuds[f].suppleance;
+					s = trouver_fils( d, f, noeuds[fils].lettre );
+				}
+				if( s == -1 ) s = 0;
+			}
+			noeuds[fils].suppleance = s;
+			noeuds[fils].sortie = ( noeuds[s].mot != -1 ) ? s : noeuds[s].sortie;
+			d->ordre[ fin++ ] = fils;
+		}
+	}
+	d->suppleances_a_jour = 1;
+}
+
+int pour_tout_mot_de_l_etat(
+	Dictionnaire * dictionnaire, int etat,
+	void (* action )( int mot, void * data ), void * data
+){
+	Noeud * noeuds;
+	int nb = 0;
+
+	assert( etat >= 0 && etat < dictionnaire->nb_noeuds );
+	calculer_suppleances( dictionnaire );
+	noeuds = dictionnaire->noeuds;
+	if( noeuds[etat].mot == -1 ){
+		etat = noeuds[etat].sortie;
+	}
+	for( ; etat != -1; etat = noeuds[etat].sortie ){
+		nb++;
+		if( action ) action( noeuds[etat].mot, data );
+	}
+	return nb;
+}
+
+int rechercher_dictionnaire(
+	Dictionnaire * dictionnaire, const char * texte,
+	void (* action )( int position, int mot, void * data ), void * data
+){
+	Dictionnaire * d = dictionnaire;
+	Noeud * noeuds;
+	int nb_occurrences = 0;
+	int position = 0;
+	int noeud = 0;
+
+	calculer_suppleances( d );
+	noeuds = d->noeuds;
+	for( ;; position++ ){
+		int n = ( noeuds[noeud].mot != -1 ) ? noeud : noeuds[noeud].sortie;
+		for( ; n != -1; n = noeuds[n].sortie ){
+			nb_occurrences++;
+			if( action ) action( position, noeuds[n].mot, data );
+		}
+		if( texte[position] == '\0' ) return nb_occurrences;
+
+		unsigned char lettre = texte[position];
+		int suivant = trouver_fils( d, noeud, lettre );
+		while( suivant == -1 && noeud != 0 ){
+			noeud = noeuds[noeud].suppleance;
+			suivant = trouver_fils( d, noeud, lettre );
+		}
+		noeud = ( suivant == -1 ) ? 0 : suivant;
+	}
+}
+
+Automate * dictionnaire_vers_automate( const Dictionnaire * dictionnaire ){
+	const Noeud * noeuds = dictionnaire->noeuds;
+	Automate * res = creer_automate();
+	int i;
+
+	ajouter_etat_initial( res, 0 );
+	for( i=0; i<dictionnaire->nb_noeuds; i++ ){
+		int fils;
+		ajouter_etat( res, i );
+		for( fils = noeuds[i].premier_fils; fils != -1; fils = noeuds[fils].frere ){
+			ajouter_transition( res, i, (char) noeuds[fils].lettre, fils );
+		}
+	}
+	for( i=0; i<dictionnaire->nb_mots; i++ ){
+		ajouter_etat_final( res, dictionnaire->fins[i] );
+	}
+	return res;
+}
+
+Automate_compile * compiler_dictionnaire( Dictionnaire * dictionnaire ){
+	Dictionnaire * d = dictionnaire;
+	Automate_compile * res = xmalloc( sizeof(Automate_compile) );
+	int L = 0;
+	int c, i, l;
+
+	// Comme rechercher_dictionnaire(), l'automate lit n'importe quel texte :
+	// une lettre absente du dictionnaire ramène à la racine. Son alphabet est
+	// donc celui de toutes les lettres, sauf '\0'.
+	calculer_suppleances( d );
+	res->indice_lettre[0] = -1;
+	for( c=1; c<NB_LETTRES_MAX; c++ ){
+		res->indice_lettre[c] = L;
+		res->lettres[L++] = (char) c;
+	}
+	res->nb_lettres = L;
+	res->nb_etats = d->nb_noeuds;
+	res->initial = 0;
+	res->complet = 0;
+	res->puits_final = 0;
+	res->transitions = xmalloc( sizeof(int) * ( (size_t) d->nb_noeuds * L + 1 ) );
+	res->finaux = xmalloc( d->nb_noeuds + 1 );
+
+	// Dans l'ordre du parcours en largeur, la ligne d'un nœud est celle de
+	// sa suppléance, qui est déjà remplie, corrigée par ses propres fils.
+	for( i=0; i<d->nb_noeuds; i++ ){
+		int noeud = d->ordre[i];
+		const Noeud * n = &d->noeuds[noeud];
+		int * ligne = &res->transitions[ (size_t) noeud * L ];
+		int fils;
+		if( noeud == 0 ){
+			for( l=0; l<L; l++ ){
+				ligne[l] = 0;
+			}
+		}else{
+			memcpy(
+				ligne, &res->transitions[ (size_t) n->suppleance * L ],
+				sizeof(int) * L
+			);
+		}
+		for( fils = n->premier_fils; fils != -1; fils = d->noeuds[fils].frere ){
+			ligne[ res->indice_lettre[ d->noeuds[fils].lettre ] ] = fils;
+		}
+		res->finaux[noeud] = ( n->mot != -1 || n->sortie != -1 );
+	}
+	return res;
+}
@@ -0,0 +1,183 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2014, 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file dictionnaire.h */
+
+#ifndef __DICTIONNAIRE_H__
+#define __DICTIONNAIRE_H__
+
+#include "automate.h"
+#include "automate_compile.h"
+
+#pragma GCC visibility push(default)
+
+/**
+ * @brief Le type d'un dictionnaire.
+ *
+ * Un dictionnaire est un ensemble de mots, rangés dans un arbre préfixe
+ * (trie) muni des liens de suppléance d'Aho et Corasick. Il remplace l'union
+ * de nombreux automates obtenus par mot_to_automate() : l'ajout d'un mot se
+ * fait en temps linéaire en sa longueur, et le dictionnaire permet de
+ * rechercher en une seule lecture toutes les occurrences de tous ses mots
+ * dans un texte.
+ *
+ * Les mots sont numérotés à partir de 0 dans l'ordre de leur ajout. Les
+ * nœuds de l'arbre, qui sont les états des automates construits à partir du
+ * dictionnaire, sont numérotés à partir de 0 dans leur ordre de création :
+ * la racine porte le numéro 0.
+ *
+ * Les liens de suppléance sont calculés, par un parcours en largeur, lors
+ * de la première recherche ou compilation qui suit l'ajout d'un mot. Un
+ * dictionnaire ne doit donc pas être utilisé par deux threads en même temps.
+ */
+typedef struct Dictionnaire Dictionnaire;
+
+/**
+ * @brief Crée un dictionnaire vide.
+ *
+ * @return Le dictionnaire.
+ */
+Dictionnaire * creer_dictionnaire();
+
+/**
+ * @brief Détruit un dictionnaire.
+ *
+ * @param dictionnaire Le dictionnaire à détruire.
+ */
+void liberer_dictionnaire( Dictionnaire * dictionnaire );
+
+/**
+ * @brief Ajoute un mot au dictionnaire et renvoie son numéro.
+ *
+ * Si le mot appartient déjà au dictionnaire, il n'est pas ajouté une
+ * seconde fois, et la fonction renvoie son numéro.
+ *
+ * @param dictionnaire Un dictionnaire.
+ * @param mot Le mot à ajouter.
+ * @return Le numéro du mot.
+ */
+int ajouter_mot_dictionnaire( Dictionnaire * dictionnaire, const char * mot );
+
+/**
+ * @brief Renvoie le numéro d'un mot du dictionnaire, ou -1 si le mot
+ *        n'appartient pas au dictionnaire.
+ *
+ * @param dictionnaire Un dictionnaire.
+ * @param mot Un mot.
+ * @return Le numéro du mot ou -1.
+ */
+int trouver_mot_dictionnaire(
+	const Dictionnaire * dictionnaire, const char * mot
+);
+
+/**
+ * @brief Renvoie le nombre de mots du dictionnaire.
+ *
+ * @param dictionnaire Un dictionnaire.
+ * @return Le nombre de mots.
+ */
+int taille_dictionnaire( const Dictionnaire * dictionnaire );
+
+/**
+ * @brief Renvoie la longueur d'un mot du dictionnaire.
+ *
+ * @param dictionnaire Un dictionnaire.
+ * @param mot Le numéro du mot.
+ * @return La longueur du mot.
+ */
+int longueur_mot_dictionnaire( const Dictionnaire * dictionnaire, int mot );
+
+/**
+ * @brief Recherche toutes les occurrences des mots du dictionnaire dans un
+ *        texte, et renvoie leur nombre.
+ *
+ * Le texte est lu une seule fois, de gauche à droite. Si 'action' est
+ * différent de NULL, la fonction 'action' est appelée pour chaque
+ * occurrence, avec la position de la fin de l'occurrence (comptée en
+ * caractères : l'occurrence se termine juste avant cette position), le
+ * numéro du mot et le paramètre 'data'. Les occurrences sont signalées par
+ * position de fin croissante, et, pour une même position, du mot le plus
+ * long au mot le plus court.
+ *
+ * @param dictionnaire Un dictionnaire.
+ * @param texte Le texte.
+ * @param action La fonction à appeler pour chaque occurrence, ou NULL.
+ * @param data La donnée supplémentaire à passer à la fonction 'action'.
+ * @return Le nombre d'occurrences.
+ */
+int rechercher_dictionnaire(
+	Dictionnaire * dictionnaire, const char * texte,
+	void (* action )( int position, int mot, void * data ), void * data
+);
+
+/**
+ * @brief Appelle une fonction pour chaque mot du dictionnaire qui est un
+ *        suffixe du mot associé à un nœud, et renvoie le nombre de ces mots.
+ *
+ * Appliquée à l'état atteint dans l'automate compilé par
+ * compiler_dictionnaire(), la fonction donne les mots du dictionnaire dont
+ * une occurrence se termine à la fin du texte lu. Les mots sont donnés du
+ * plus long au plus court.
+ *
+ * @param dictionnaire Un dictionnaire.
+ * @param etat Un nœud du dictionnaire.
+ * @param action La fonction à appeler pour chaque mot, ou NULL.
+ * @param data La donnée supplémentaire à passer à la fonction 'action'.
+ * @return Le nombre de mots.
+ */
+int pour_tout_mot_de_l_etat(
+	Dictionnaire * dictionnaire, int etat,
+	void (* action )( int mot, void * data ), void * data
+);
+
+/**
+ * @brief Renvoie l'automate déterministe (l'arbre préfixe) qui reconnaît
+ *        exactement les mots du dictionnaire.
+ *
+ * L'automate reconnaît le même langage que l'union des automates
+ * mot_to_automate() de tous les mots du dictionnaire. Ses états sont les
+ * nœuds du dictionnaire.
+ *
+ * @param dictionnaire Un dictionnaire.
+ * @return L'automate.
+ */
+Automate * dictionnaire_vers_automate( const Dictionnaire * dictionnaire );
+
+/**
+ * @brief Compile l'automate d'Aho et Corasick du dictionnaire.
+ *
+ * L'automate compilé renvoyé est déterministe : il reconnaît les textes qui
+ * se terminent par un mot du dictionnaire, comme rechercher_dictionnaire().
+ * Son alphabet contient toutes les lettres sauf '\0' : une lettre qui 
+ * n'apparaît dans aucun mot du dictionnaire ramène à la racine. Ses états 
+ * sont les nœuds du dictionnaire, l'état initial est la racine, et toutes 
+ * les transitions sont définies : le puits n'est jamais atteint. La 
+ * fonction pour_tout_mot_de_l_etat() donne les mots reconnus en un état.
+ *
+ * La table des transitions est dense : elle occupe nb_etats * 255 entiers.
+ *
+ * @param dictionnaire Un dictionnaire.
+ * @return L'automate compilé.
+ */
+Automate_compile * compiler_dictionnaire( Dictionnaire * dictionnaire );
+
+#pragma GCC visibility pop
+
+#endif
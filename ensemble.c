@@ -21,9 +21,12 @@
 
 #define _GNU_SOURCE
 
+#define ETIQUETTE_ALLOCATIONS ETIQUETTE_ENSEMBLE
+
 #include "ensemble.h"
 #include "outils.h"
 #include "table.h"
+#include "statistiques.h"
 
 #include <stdlib.h>
 #include <stdio.h>
@@ -46,6 +49,11 @@ void next_iterators( Table_iterateur * it1, Table_iterateur * it2 ){
 
 int comparer_ensemble( const Ensemble* ens1, const Ensemble*  ens2 ){
 	Table_iterateur it1, it2;
+
+	// Un ensemble est égal à lui-même, ainsi qu'à ses copies partagées.
+	if( ens1 == ens2 || ens1->table == ens2->table ){
+		return 0;
+	}
 	
 	it1 = premier_iterateur_table( ens1->table );
 	it2 = premier_iterateur_table( ens2->table );
@@ -80,6 +88,29 @@ Ensemble * creer_ensemble(
 	result->table = creer_table(
 		comparer_element, copier_element, supprimer_element
 	);
+	result->empreinte = 0;
+	result->comparer_element = comparer_element;
+	result->copier_element = copier_element;
+	result->supprimer_element = supprimer_element;
+	return result;
+}
+
+Ensemble * creer_ensemble_depuis_tableau(
+	const intptr_t * elements, int nb_elements,
+	int (*comparer_element)( const intptr_t elem1, const intptr_t elem2 ),
+	intptr_t (*copier_element)( const intptr_t elem ),
+	void (*supprimer_element)(intptr_t elem )
+){
+	Ensemble * result = (Ensemble*) xmalloc( sizeof(Ensemble) );
+	result->table = creer_table_depuis_cles_triees(
+		elements, NULL, nb_elements,
+		comparer_element, copier_element, supprimer_element
+	);
+	result->empreinte = 0;
+	int i;
+	for( i=0; i<nb_elements; i++ ){
+		result->empreinte += empreinte_element( elements[i] );
+	}
 	result->comparer_element = comparer_element;
 	result->copier_element = copier_element;
 	result->supprimer_element = supprimer_element;
@@ -93,8 +124,31 @@ void liberer_ensemble( Ensemble * ens ){
 	}
 }
 
+/*
+ * Avant toute modification, un ensemble qui partage sa table avec un autre
+ * ensemble en fait sa propre copie.
+ */
+static void detacher_ensemble( Ensemble * ensemble ){
+	if( table_est_partagee( ensemble->table ) ){
+		Table * table = copier_table( ensemble->table, NULL );
+		liberer_table( ensemble->table );
+		ensemble->table = table;
+	}
+}
+
 void ajouter_element( Ensemble * ensemble, const intptr_t element ){
-	add_table( ensemble->table, element, (intptr_t) NULL );
+	COMPTER_OPERATION( operations_ensembles, 1 );
+	// Un ajout sans effet ne détache pas l'ensemble de ses copies.
+	if(
+		table_est_partagee( ensemble->table )
+		&& est_dans_l_ensemble( ensemble, element )
+	){
+		return;
+	}
+	detacher_ensemble( ensemble );
+	if( add_table( ensemble->table, element, (intptr_t) NULL ) ){
+		ensemble->empreinte += empreinte_element( element );
+	}
 }
 
 
@@ -121,7 +175,13 @@ void transferer_elements(
 }
 
 void retirer_element( Ensemble * ensemble, const intptr_t element ){
+	if( ! est_dans_l_ensemble( ensemble, element ) ){
+		return;
+	}
+	COMPTER_OPERATION( operations_ensembles, 1 );
+	detacher_ensemble( ensemble );
 	delete_table( ensemble->table, element );
+	ensemble->empreinte -= empreinte_element( element );
 }
 
 void action_retirer_elements( const intptr_t element, void* ens ){
@@ -133,22 +193,38 @@ void retirer_elements( Ensemble * ens1, const Ensemble * ens2 ){
 }
 
 void vider_ensemble( Ensemble * ensemble ){
+	COMPTER_OPERATION( operations_ensembles, 1 );
+	// Inutile de copier une table partagée pour la vider ensuite.
+	if( table_est_partagee( ensemble->table ) ){
+		liberer_table( ensemble->table );
+		ensemble->table = creer_table(
+			ensemble->comparer_element, ensemble->copier_element,
+			ensemble->supprimer_element
+		);
+	}
 	vider_table( ensemble->table );
+	ensemble->empreinte = 0;
 }
 
 int est_dans_l_ensemble( const Ensemble * ensemble, intptr_t element ){
+	COMPTER_OPERATION( operations_ensembles, 1 );
 	Table_iterateur it = trouver_table( ensemble->table, element );
 	return ! avl_t_is_null( &it ); 
 }
 
-void action_taille_ensemble( const intptr_t element, void* taille ){
-	(*(int*) taille)+=1;
+unsigned int taille_ensemble( const Ensemble* ensemble ){
+	return taille_table( ensemble->table );
 }
 
-unsigned int taille_ensemble( const Ensemble* ensemble ){
-	int taille = 0;
-	pour_tout_element( ensemble, action_taille_ensemble, &taille );
-	return taille;
+uint64_t empreinte_element( intptr_t element ){
+	uint64_t x = (uint64_t) element + UINT64_C(0x9E3779B97F4A7C15);
+	x = ( x ^ ( x >> 30 ) ) * UINT64_C(0xBF58476D1CE4E5B9);
+	x = ( x ^ ( x >> 27 ) ) * UINT64_C(0x94D049BB133111EB);
+	return x ^ ( x >> 31 );
+}
+
+uint64_t empreinte_ensemble( const Ensemble* ensemble ){
+	return ensemble->empreinte;
 }
 
 typedef struct {
@@ -205,6 +281,9 @@ void swap_ensemble( Ensemble* ens1, Ensemble* ens2 ){
 	void* tmp = ens1->table;
 	ens1->table = ens2->table;
 	ens2->table = tmp;
+	uint64_t empreinte = ens1->empreinte;
+	ens1->empreinte = ens2->empreinte;
+	ens2->empreinte = empreinte;
 }
 void deplacer_ensemble( Ensemble* ens1, Ensemble* ens2 ){
 	swap_ensemble( ens1, ens2 );
@@ -212,11 +291,17 @@ void deplacer_ensemble( Ensemble* ens1, Ensemble* ens2 ){
 }
 
 Ensemble* copier_ensemble( const Ensemble* ensemble ){
-	Ensemble* res = creer_ensemble(
-		ensemble->comparer_element, ensemble->copier_element,
-		ensemble->supprimer_element
-	);
-	ajouter_elements( res, ensemble  );
+	COMPTER_OPERATION( operations_ensembles, 1 );
+	Ensemble* res = (Ensemble*) xmalloc( sizeof(Ensemble) );
+	*res = *ensemble;
+	res->table = copier_table( ensemble->table, NULL );
+	return res;
+}
+
+Ensemble* partager_ensemble( const Ensemble* ensemble ){
+	Ensemble* res = (Ensemble*) xmalloc( sizeof(Ensemble) );
+	*res = *ensemble;
+	res->table = partager_table( ensemble->table );
 	return res;
 }
 
@@ -27,11 +27,14 @@
 #include "avl.h"
 #include "table.h"
 
+#pragma GCC visibility push(default)
+
 /*
  * Définit le type d'un ensemble.
  */
 struct Ensemble {
 	Table* table;
+	uint64_t empreinte; //!< Voir empreinte_ensemble().
 	int (*comparer_element)( const intptr_t elem1, const intptr_t elem2 );
 	intptr_t (*copier_element)( const intptr_t elem );
 	void (*supprimer_element)(intptr_t elem );
@@ -64,6 +67,19 @@ Ensemble * creer_ensemble(
 	void (*supprimer_element)( intptr_t elem )
 );
 
+/*
+ * Crée l'ensemble des éléments d'un tableau trié dans l'ordre strictement 
+ * croissant (pour 'comparer_element'), en temps linéaire : l'arbre de 
+ * l'ensemble est construit d'un coup au lieu d'ajouter les éléments un à 
+ * un. Les autres paramètres sont ceux de creer_ensemble().
+ */
+Ensemble * creer_ensemble_depuis_tableau(
+	const intptr_t * elements, int nb_elements,
+	int (*comparer_element)( const intptr_t elem1, const intptr_t elem2 ),
+	intptr_t (*copier_element)( const intptr_t elem ),
+	void (*supprimer_element)( intptr_t elem )
+);
+
 /*
  * Libère la mémoire d'un ensemble.
  * La mémoire de tous les éléments de l'ensemble est aussi libérée.
@@ -128,6 +144,22 @@ int est_dans_l_ensemble( const Ensemble * ensemble, const intptr_t element );
  */
 unsigned int taille_ensemble( const Ensemble* ensemble );
 
+/*
+ * Renvoie l'empreinte d'un entier. 
+ */
+uint64_t empreinte_element( intptr_t element );
+
+/*
+ * Renvoie l'empreinte d'un ensemble d'entiers, en temps constant.
+ *
+ * L'empreinte est la somme des empreintes des éléments : elle est mise à jour
+ * à chaque ajout ou retrait, et ne dépend que du contenu de l'ensemble. Deux
+ * ensembles égaux ont donc la même empreinte.
+ * Pour un ensemble dont les éléments sont des pointeurs, l'empreinte n'a pas
+ * de sens.
+ */
+uint64_t empreinte_ensemble( const Ensemble* ensemble );
+
 /*
  * Compare deux ensembles entre eux.
  *
@@ -145,6 +177,14 @@ int comparer_ensemble( const Ensemble* ens1, const Ensemble*  ens2 );
  */
 Ensemble* copier_ensemble( const Ensemble* ensemble );
 
+/*
+ * Renvoie une copie de l'ensemble passé en paramètre, en temps constant.
+ * Les deux ensembles partagent leurs éléments jusqu'à la première 
+ * modification de l'un d'entre eux, qui copie alors ses éléments 
+ * (copie à l'écriture).
+ */
+Ensemble* partager_ensemble( const Ensemble* ensemble );
+
 /*
  * Crée un nouvel ensemble qui est la copie de deux ensembles passés en 
  * paramètre
@@ -251,4 +291,6 @@ int iterateur_ensemble_est_vide( Ensemble_iterateur iterateur );
  */
 intptr_t get_element( Ensemble_iterateur it );
 
+#pragma GCC visibility pop
+
 #endif
@@ -0,0 +1,395 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define ETIQUETTE_ALLOCATIONS ETIQUETTE_ENSEMBLE
+
+#include "ensemble_persistant.h"
+#include "outils.h"
+
+#include <stdlib.h>
+#include <stdatomic.h>
+
+#include <assert.h>
+
+/*
+ * Un ensemble persistant est un pointeur vers la racine d'un arbre AVL dont
+ * les noeuds sont partagés entre les versions et comptent leurs références.
+ * Un noeud n'est jamais modifié après sa création, à l'exception de son 
+ * compteur de références.
+ */
+struct Ensemble_persistant {
+	intptr_t element;
+	Ensemble_persistant * gauche;
+	Ensemble_persistant * droite;
+	int hauteur;
+	int taille;
+	atomic_int nb_references;
+	uint64_t empreinte; //!< Somme des empreintes des éléments du sous-arbre.
+};
+
+/*
+ * Une hauteur de 64 suffit pour tout arbre AVL de moins de 2^43 noeuds.
+ */
+#define HAUTEUR_MAX 64
+
+static int hauteur( const Ensemble_persistant * noeud ){
+	return noeud ? noeud->hauteur : 0;
+}
+
+/*
+ * Crée un noeud. Le noeud créé prend possession des références 'gauche' et
+ * 'droite'.
+ */
+static Ensemble_persistant * creer_noeud(
+	intptr_t element, Ensemble_persistant * gauche, Ensemble_persistant * droite
+){
+	Ensemble_persistant * res = xmalloc( sizeof(Ensemble_persistant) );
+	int hg = hauteur( gauche );
+	int hd = hauteur( droite );
+	res->element = element;
+	res->gauche = gauche;
+	res->droite = droite;
+	res->hauteur = 1 + ( hg > hd ? hg : hd );
+	res->taille = 1 + taille_ensemble_persistant( gauche )
+		+ taille_ensemble_persistant( droite );
+	res->empreinte = empreinte_element( element )
+		+ empreinte_ensemble_persistant( gauche )
+		+ empreinte_ensemble_persistant( droite );
+	atomic_init( &res->nb_references, 1 );
+	return res;
+}
+
+Ensemble_persistant * partager_ensemble_persistant(
+	const Ensemble_persistant * ensemble
+){
+	// Le compteur de références ne fait pas partie du contenu de l'ensemble.
+	Ensemble_persistant * res = (Ensemble_persistant *) ensemble;
+	if( res ){
+		atomic_fetch_add_explicit(
+			&res->nb_references, 1, memory_order_relaxed
+		);
+	}
+	return res;
+}
+
+void liberer_ensemble_persistant( Ensemble_persistant * ensemble ){
+	while(
+		ensemble
+		&& atomic_fetch_sub_explicit(
+			&ensemble->nb_references, 1, memory_order_acq_rel
+		) == 1
+	){
+		Ensemble_persistant * droite = ensemble->droite;
+		liberer_ensemble_persistant( ensemble->gauche );
+		xfree( ensemble );
+		ensemble = droite;
+	}
+}
+
+/*
+ * Crée un noeud équilibré à partir de deux sous-arbres AVL dont les hauteurs
+ * diffèrent d'au plus 2. Les rotations créent de nouveaux noeuds : les
+ * sous-arbres d'origine ne sont pas modifiés. La fonction prend possession
+ * des références 'gauche' et 'droite'.
+ */
+static Ensemble_persistant * equilibrer(
+	intptr_t element, Ensemble_persistant * gauche, Ensemble_persistant * droite
+){
+	Ensemble_persistant * res;
+	if( hauteur( gauche ) > hauteur( droite ) + 1 ){
+		if( hauteur( gauche->gauche ) >= hauteur( gauche->droite ) ){
+			res = creer_noeud(
+				gauche->element,
+				partager_ensemble_persistant( gauche->gauche ),
+				creer_noeud(
+					element, partager_ensemble_persistant( gauche->droite ),
+					droite
+				)
+			);
+		}else{
+			const Ensemble_persistant * milieu = gauche->droite;
+			res = creer_noeud(
+				milieu->element,
+				creer_noeud(
+					gauche->element,
+					partager_ensemble_persistant( gauche->gauche ),
+					partager_ensemble_persistant( milieu->gauche )
+				),
+				creer_noeud(
+					element, partager_ensemble_persistant( milieu->droite ),
+					droite
+				)
+			);
+		}
+		liberer_ensemble_persistant( gauche );
+		return res;
+	}
+	if( hauteur( droite ) > hauteur( gauche ) + 1 ){
+		if( hauteur( droite->droite ) >= hauteur( droite->gauche ) ){
+			res = creer_noeud(
+				droite->element,
+				creer_noeud(
+					element, gauche,
+					partager_ensemble_persistant( droite->gauche )
+				),
+				partager_ensemble_persistant( droite->droite )
+			);
+		}else{
+			const Ensemble_persistant * milieu = droite->gauche;
+			res = creer_noeud(
+				milieu->element,
+				creer_noeud(
+					element, gauche,
+					partager_ensemble_persistant( milieu->gauche )
+				),
+				creer_noeud(
+					droite->element,
+					partager_ensemble_persistant( milieu->droite ),
+					partager_ensemble_persistant( droite->droite )
+				)
+			);
+		}
+		liberer_ensemble_persistant( droite );
+		return res;
+	}
+	return creer_noeud( element, gauche, droite );
+}
+
+/*
+ * Insère un élément qui n'appartient pas à l'ensemble.
+ */
+static Ensemble_persistant * inserer(
+	const Ensemble_persistant * noeud, intptr_t element
+){
+	if( ! noeud ){
+		return creer_noeud( element, NULL, NULL );
+	}
+	if( element < noeud->element ){
+		return equilibrer(
+			noeud->element, inserer( noeud->gauche, element ),
+			partager_ensemble_persistant( noeud->droite )
+		);
+	}
+	return equilibrer(
+		noeud->element, partager_ensemble_persistant( noeud->gauche ),
+		inserer( noeud->droite, element )
+	);
+}
+
+static Ensemble_persistant * retirer_minimum(
+	const Ensemble_persistant * noeud, intptr_t * minimum
+){
+	if( ! noeud->gauche ){
+		*minimum = noeud->element;
+		return partager_ensemble_persistant( noeud->droite );
+	}
+	return equilibrer(
+		noeud->element, retirer_minimum( noeud->gauche, minimum ),
+		partager_ensemble_persistant( noeud->droite )
+	);
+}
+
+/*
+ * Retire un élément qui appartient à l'ensemble.
+ */
+static Ensemble_persistant * supprimer(
+	const Ensemble_persistant * noeud, intptr_t element
+){
+	if( element < noeud->element ){
+		return equilibrer(
+			noeud->element, supprimer( noeud->gauche, element ),
+			partager_ensemble_persistant( noeud->droite )
+		);
+	}
+	if( element > noeud->element ){
+		return equilibrer(
+			noeud->element, partager_ensemble_persistant( noeud->gauche ),
+			supprimer( noeud->droite, element )
+		);
+	}
+	if( ! noeud->gauche ){
+		return partager_ensemble_persistant( noeud->droite );
+	}
+	if( ! noeud->droite ){
+		return partager_ensemble_persistant( noeud->gauche );
+	}
+	intptr_t minimum;
+	Ensemble_persistant * droite = retirer_minimum( noeud->droite, &minimum );
+	return equilibrer(
+		minimum, partager_ensemble_persistant( noeud->gauche ), droite
+	);
+}
+
+Ensemble_persistant * ajouter_element_persistant(
+	const Ensemble_persistant * ensemble, intptr_t element
+){
+	if( est_dans_l_ensemble_persistant( ensemble, element ) ){
+		return partager_ensemble_persistant( ensemble );
+	}
+	return inserer( ensemble, element );
+}
+
+Ensemble_persistant * retirer_element_persistant(
+	const Ensemble_persistant * ensemble, intptr_t element
+){
+	if( ! est_dans_l_ensemble_persistant( ensemble, element ) ){
+		return partager_ensemble_persistant( ensemble );
+	}
+	return supprimer( ensemble, element );
+}
+
+int est_dans_l_ensemble_persistant(
+	const Ensemble_persistant * ensemble, intptr_t element
+){
+	while( ensemble ){
+		if( element < ensemble->element ){
+			ensemble = ensemble->gauche;
+		}else if( element > ensemble->element ){
+			ensemble = ensemble->droite;
+		}else{
+			return 1;
+		}
+	}
+	return 0;
+}
+
+int taille_ensemble_persistant( const Ensemble_persistant * ensemble ){
+	return ensemble ? ensemble->taille : 0;
+}
+
+uint64_t empreinte_ensemble_persistant( const Ensemble_persistant * ensemble ){
+	return ensemble ? ensemble->empreinte : 0;
+}
+
+/*
+ * Parcours infixe d'un arbre à l'aide d'une pile.
+ */
+typedef struct {
+	const Ensemble_persistant * pile[HAUTEUR_MAX];
+	int taille;
+} Parcours;
+
+static void descendre( Parcours * parcours, const Ensemble_persistant * noeud ){
+	while( noeud ){
+		assert( parcours->taille < HAUTEUR_MAX );
+		parcours->pile[ parcours->taille++ ] = noeud;
+		noeud = noeud->gauche;
+	}
+}
+
+static const Ensemble_persistant * suivant( Parcours * parcours ){
+	if( parcours->taille == 0 ) return NULL;
+	const Ensemble_persistant * noeud = parcours->pile[ --parcours->taille ];
+	descendre( parcours, noeud->droite );
+	return noeud;
+}
+
+int comparer_ensemble_persistant(
+	const Ensemble_persistant * ens1, const Ensemble_persistant * ens2
+){
+	if( ens1 == ens2 ) return 0;
+	Parcours p1, p2;
+	p1.taille = 0;
+	p2.taille = 0;
+	descendre( &p1, ens1 );
+	descendre( &p2, ens2 );
+	for( ;; ){
+		const Ensemble_persistant * n1 = suivant( &p1 );
+		const Ensemble_persistant * n2 = suivant( &p2 );
+		if( ! n1 && ! n2 ) return 0;
+		if( ! n1 ) return -1;
+		if( ! n2 ) return 1;
+		if( n1->element < n2->element ) return -1;
+		if( n1->element > n2->element ) return 1;
+	}
+}
+
+int sont_egaux_ensembles_persistants(
+	const Ensemble_persistant * ens1, const Ensemble_persistant * ens2
+){
+	if( ens1 == ens2 ) return 1;
+	if(
+		taille_ensemble_persistant( ens1 ) != taille_ensemble_persistant( ens2 )
+		|| empreinte_ensemble_persistant( ens1 )
+			!= empreinte_ensemble_persistant( ens2 )
+	){
+		return 0;
+	}
+	return comparer_ensemble_persistant( ens1, ens2 ) == 0;
+}
+
+void pour_tout_element_persistant(
+	const Ensemble_persistant * ensemble,
+	void (* action )( const intptr_t element, void* data ),
+	void* data
+){
+	Parcours parcours;
+	const Ensemble_persistant * noeud;
+	parcours.taille = 0;
+	descendre( &parcours, ensemble );
+	while( ( noeud = suivant( &parcours ) ) ){
+		action( noeud->element, data );
+	}
+}
+
+/*
+ * Construit un arbre parfaitement équilibré à partir d'un tableau trié.
+ */
+static Ensemble_persistant * construire( const intptr_t * elements, int n ){
+	if( n == 0 ) return NULL;
+	int milieu = n / 2;
+	return creer_noeud(
+		elements[milieu], construire( elements, milieu ),
+		construire( elements + milieu + 1, n - milieu - 1 )
+	);
+}
+
+Ensemble_persistant * creer_ensemble_persistant( const Ensemble * ensemble ){
+	int n = taille_ensemble( ensemble );
+	intptr_t * elements = xmalloc( sizeof(intptr_t) * ( n + 1 ) );
+	int i = 0;
+	Ensemble_iterateur it;
+	for(
+		it = premier_iterateur_ensemble( ensemble );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		elements[i++] = get_element( it );
+	}
+	Ensemble_persistant * res = construire( elements, n );
+	xfree( elements );
+	return res;
+}
+
+static void action_ajouter_element_persistant(
+	const intptr_t element, void * data
+){
+	ajouter_element( (Ensemble *) data, element );
+}
+
+Ensemble * creer_ensemble_depuis_persistant(
+	const Ensemble_persistant * ensemble
+){
+	Ensemble * res = creer_ensemble( NULL, NULL, NULL );
+	pour_tout_element_persistant(
+		ensemble, action_ajouter_element_persistant, res
+	);
+	return res;
+}
@@ -0,0 +1,142 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux.
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __ENSEMBLE_PERSISTANT_H__
+#define __ENSEMBLE_PERSISTANT_H__
+
+#include <stdint.h>
+
+#include "ensemble.h"
+
+#pragma GCC visibility push(default)
+
+/*
+ * Définit le type d'un ensemble persistant d'entiers.
+ *
+ * Un ensemble persistant n'est jamais modifié : ajouter ou retirer un 
+ * élément renvoie une nouvelle version de l'ensemble, en O(log n), qui 
+ * partage avec l'ancienne tous les noeuds de l'arbre AVL qui n'ont pas été
+ * touchés. L'ancienne version reste valide.
+ *
+ * Chaque version est une référence, qui doit être abandonnée avec 
+ * liberer_ensemble_persistant(). L'ensemble vide est représenté par NULL.
+ *
+ * Les compteurs de références sont atomiques : les versions d'un même 
+ * ensemble peuvent être partagées, lues et libérées par des fils 
+ * différents.
+ *
+ * Chaque noeud connaît la taille et l'empreinte de son sous-arbre. 
+ * L'empreinte d'un ensemble ne dépend que de ses éléments (et pas de la 
+ * forme de l'arbre) : c'est la même que celle d'un Ensemble qui contient les
+ * mêmes éléments (voir empreinte_ensemble()).
+ */
+typedef struct Ensemble_persistant Ensemble_persistant;
+
+/*
+ * Renvoie une nouvelle version de l'ensemble, à laquelle on a ajouté un 
+ * élément. 
+ */
+Ensemble_persistant * ajouter_element_persistant(
+	const Ensemble_persistant * ensemble, intptr_t element
+);
+
+/*
+ * Renvoie une nouvelle version de l'ensemble, à laquelle on a retiré un 
+ * élément. 
+ */
+Ensemble_persistant * retirer_element_persistant(
+	const Ensemble_persistant * ensemble, intptr_t element
+);
+
+/*
+ * Renvoie une nouvelle référence vers un ensemble persistant, en temps 
+ * constant.
+ */
+Ensemble_persistant * partager_ensemble_persistant(
+	const Ensemble_persistant * ensemble
+);
+
+/*
+ * Abandonne une référence vers un ensemble persistant. Les noeuds qui ne sont
+ * plus utilisés par aucune version sont libérés.
+ */
+void liberer_ensemble_persistant( Ensemble_persistant * ensemble );
+
+/*
+ * Renvoie 1 si l'élément appartient à l'ensemble et 0 sinon.
+ */
+int est_dans_l_ensemble_persistant(
+	const Ensemble_persistant * ensemble, intptr_t element
+);
+
+/*
+ * Renvoie le nombre d'éléments de l'ensemble, en temps constant.
+ */
+int taille_ensemble_persistant( const Ensemble_persistant * ensemble );
+
+/*
+ * Renvoie l'empreinte de l'ensemble, en temps constant.
+ */
+uint64_t empreinte_ensemble_persistant( const Ensemble_persistant * ensemble );
+
+/*
+ * Compare deux ensembles persistants, dans le même ordre que 
+ * comparer_ensemble() : la fonction renvoie -1, 0 ou 1.
+ * Deux versions identiques (même pointeur) sont comparées en temps constant.
+ */
+int comparer_ensemble_persistant(
+	const Ensemble_persistant * ens1, const Ensemble_persistant * ens2
+);
+
+/*
+ * Renvoie 1 si les deux ensembles sont égaux et 0 sinon.
+ * Deux ensembles de tailles ou d'empreintes différentes sont distingués en 
+ * temps constant.
+ */
+int sont_egaux_ensembles_persistants(
+	const Ensemble_persistant * ens1, const Ensemble_persistant * ens2
+);
+
+/*
+ * Passe en revue tous les éléments d'un ensemble persistant, dans l'ordre 
+ * croissant, et execute un fonction passée en paramètre.
+ */
+void pour_tout_element_persistant(
+	const Ensemble_persistant * ensemble,
+	void (* action )( const intptr_t element, void* data ),
+	void* data
+);
+
+/*
+ * Crée un ensemble persistant qui contient les éléments d'un ensemble 
+ * d'entiers, en temps linéaire.
+ */
+Ensemble_persistant * creer_ensemble_persistant( const Ensemble * ensemble );
+
+/*
+ * Crée un ensemble qui contient les éléments d'un ensemble persistant.
+ */
+Ensemble * creer_ensemble_depuis_persistant(
+	const Ensemble_persistant * ensemble
+);
+
+#pragma GCC visibility pop
+
+#endif
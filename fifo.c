@@ -19,65 +19,89 @@
  */
 
 
+#define ETIQUETTE_ALLOCATIONS ETIQUETTE_FIFO
+
 #include "outils.h"
 #include "fifo.h"
 
-typedef struct List List;
+#include <assert.h>
+#include <string.h>
 
-struct List {
-	List * next;
-	intptr_t element;
-};
+#define CAPACITE_INITIALE_FIFO 16
 
+/*
+ * Les éléments occupent les cases debut, debut+1, ..., debut+taille-1 du
+ * tableau, modulo sa capacité, qui est une puissance de 2.
+ */
 struct Fifo {
-	List * list;
+	intptr_t * elements;
+	int capacite;
+	int debut;
+	int taille;
 };
 
-List* allouer_list( List * next, intptr_t element ){
-	List* res = (List*) xmalloc( sizeof(List) );
-	res->next = next;
-	res->element = element;
-	return res;
-}
-
-void liberer_list( List * list ){
-	xfree( list );
+static void agrandir_fifo( Fifo* fifo ){
+	int ancienne_capacite = fifo->capacite;
+	fifo->capacite *= 2;
+	fifo->elements = xrealloc(
+		fifo->elements, sizeof(intptr_t) * fifo->capacite
+	);
+	// Les éléments qui faisaient le tour du tableau sont déplacés dans la
+	// nouvelle moitié, pour rester contigus (modulo la capacité).
+	int nb_replies = fifo->debut + fifo->taille - ancienne_capacite;
+	if( nb_replies > 0 ){
+		memcpy(
+			fifo->elements + ancienne_capacite, fifo->elements,
+			sizeof(intptr_t) * nb_replies
+		);
+	}
 }
 
 void ajouter_fifo( Fifo* fifo, intptr_t element ){
-	fifo->list = allouer_list( fifo->list, element );
+	if( fifo->taille == fifo->capacite ){
+		agrandir_fifo( fifo );
+	}
+	int fin = ( fifo->debut + fifo->taille ) & ( fifo->capacite - 1 );
+	fifo->elements[fin] = element;
+	fifo->taille++;
 }
 
 intptr_t retirer_fifo( Fifo* fifo ){
-	intptr_t res = fifo->list->element;
-	List* tmp = fifo->list;
-	fifo->list = fifo->list->next;
-	liberer_list( tmp );
+	assert( fifo->taille > 0 );
+	intptr_t res = fifo->elements[fifo->debut];
+	fifo->debut = ( fifo->debut + 1 ) & ( fifo->capacite - 1 );
+	fifo->taille--;
 	return res;
 }
 
 intptr_t obtenir_fifo( Fifo* fifo ){
-	return fifo->list->element;
+	assert( fifo->taille > 0 );
+	return fifo->elements[fifo->debut];
 }
 
 int est_vide( Fifo* fifo ){
-	return fifo->list == NULL;
+	return fifo->taille == 0;
+}
+
+int taille_fifo( Fifo* fifo ){
+	return fifo->taille;
+}
+
+void vider_fifo( Fifo* fifo ){
+	fifo->debut = 0;
+	fifo->taille = 0;
 }
 
 Fifo* creer_fifo(){
 	Fifo* res = xmalloc( sizeof(Fifo) );
-	res->list = NULL;
+	res->capacite = CAPACITE_INITIALE_FIFO;
+	res->elements = xmalloc( sizeof(intptr_t) * res->capacite );
+	res->debut = 0;
+	res->taille = 0;
 	return res;
 }
 
-void vider_list( List * list ){
-	if( list ){
-		vider_list( list->next );
-		xfree( list );
-	}
-}
-
 void liberer_fifo( Fifo* file ){
-	vider_list( file->list );
+	xfree( file->elements );
 	xfree( file );
 }
@@ -24,11 +24,17 @@
 
 #include <stdint.h>
 
+#pragma GCC visibility push(default)
+
 /*
  * Définit le type d'une file first-in first-out contenant des entiers ou 
- * des pointerus vers des stucture plus complexes.
+ * des pointeurs vers des structures plus complexes.
  * La file n'est pas responsable de la mémoire des éléments qui y sont 
  * entreposés.
+ *
+ * La file est rangée dans un tableau circulaire dont la taille double
+ * lorsqu'il est plein : ajouter et retirer un élément se font en temps
+ * constant amorti, sans allocation par élément.
  */
 typedef struct Fifo Fifo;
 
@@ -39,7 +45,7 @@ Fifo* creer_fifo();
 
 /*
  * Supprimme la mémoire associée à la file.
- * La mamoir associée aux élément de la file ne sont pas supprimé.
+ * La mémoire associée aux éléments de la file n'est pas supprimée.
  */
 void liberer_fifo( Fifo* fifo );
 
@@ -49,19 +55,32 @@ void liberer_fifo( Fifo* fifo );
 int est_vide( Fifo* fifo );
 
 /*
- * Ajoute un élément au dessus de la pile.
+ * Renvoie le nombre d'éléments de la file.
+ */
+int taille_fifo( Fifo* fifo );
+
+/*
+ * Ajoute un élément à la fin de la file.
  */
 void ajouter_fifo( Fifo* fifo, intptr_t element );
 
 /*
- * Retire un élément du dessus de la pile et le renvoie.
+ * Retire l'élément du début de la file (le plus ancien) et le renvoie.
+ * La file ne doit pas être vide.
  */
 intptr_t retirer_fifo( Fifo* fifo );
 
 /*
- * Renvoie l'élement qui se trouve au dessus de la pile. L'élément n'est pas
- * retiré de la pile.
+ * Renvoie l'élement qui se trouve au début de la file. L'élément n'est pas
+ * retiré de la file.
  */
 intptr_t obtenir_fifo( Fifo* fifo );
 
+/*
+ * Retire tous les éléments de la file, sans libérer son tableau.
+ */
+void vider_fifo( Fifo* fifo );
+
+#pragma GCC visibility pop
+
 #endif
@@ -0,0 +1,227 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2014, 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "files_concurrentes.h"
+#include "outils.h"
+
+#include <sched.h>
+#include <stdatomic.h>
+
+/*
+ * Les indices des producteurs et des consommateurs sont séparés par une
+ * ligne de cache, pour que leurs mises à jour ne se gênent pas.
+ */
+#define LIGNE_DE_CACHE 64
+
+struct File_spsc {
+	intptr_t * elements;
+	size_t masque;
+	char separation_1[LIGNE_DE_CACHE];
+	atomic_size_t tete; //!< Prochaine case à lire (consommateur).
+	size_t queue_connue; //!< Copie de queue lue par le consommateur.
+	char separation_2[LIGNE_DE_CACHE];
+	atomic_size_t queue; //!< Prochaine case à écrire (producteur).
+	size_t tete_connue; //!< Copie de tete lue par le producteur.
+	char separation_3[LIGNE_DE_CACHE];
+};
+
+typedef struct Case_mpmc {
+	atomic_size_t sequence;
+	intptr_t element;
+} Case_mpmc;
+
+struct File_mpmc {
+	Case_mpmc * cases;
+	size_t masque;
+	char separation_1[LIGNE_DE_CACHE];
+	atomic_size_t queue;
+	char separation_2[LIGNE_DE_CACHE];
+	atomic_size_t tete;
+	char separation_3[LIGNE_DE_CACHE];
+};
+
+static size_t puissance_de_2( size_t n ){
+	size_t res = 1;
+	while( res < n ){
+		res *= 2;
+	}
+	return res;
+}
+
+File_spsc * creer_file_spsc( size_t capacite ){
+	File_spsc * file = xmalloc( sizeof(File_spsc) );
+	capacite = puissance_de_2( capacite );
+	file->elements = xmalloc( sizeof(intptr_t) * capacite );
+	file->masque = capacite - 1;
+	atomic_init( &file->tete, 0 );
+	atomic_init( &file->queue, 0 );
+	file->queue_connue = 0;
+	file->tete_connue = 0;
+	return file;
+}
+
+void liberer_file_spsc( File_spsc * file ){
+	xfree( file->elements );
+	xfree( file );
+}
+
+int deposer_spsc( File_spsc * file, intptr_t element ){
+	size_t queue = atomic_load_explicit( &file->queue, memory_order_relaxed );
+	if( queue - file->tete_connue > file->masque ){
+		file->tete_connue = atomic_load_explicit(
+			&file->tete, memory_order_acquire
+		);
+		if( queue - file->tete_connue > file->masque ){
+			return 0;
+		}
+	}
+	file->elements[ queue & file->masque ] = element;
+	atomic_store_explicit( &file->queue, queue + 1, memory_order_release );
+	return 1;
+}
+
+int prelever_spsc( File_spsc * file, intptr_t * element ){
+	size_t tete = atomic_load_explicit( &file->tete, memory_order_relaxed );
+	if( tete == file->queue_connue ){
+		file->queue_connue = atomic_load_explicit(
+			&file->queue, memory_order_acquire
+		);
+		if( tete == file->queue_connue ){
+			return 0;
+		}
+	}
+	*element = file->elements[ tete & file->masque ];
+	atomic_store_explicit( &file->tete, tete + 1, memory_order_release );
+	return 1;
+}
+
+File_mpmc * creer_file_mpmc( size_t capacite ){
+	File_mpmc * file = xmalloc( sizeof(File_mpmc) );
+	capacite = puissance_de_2( capacite < 2 ? 2 : capacite );
+	file->cases = xmalloc( sizeof(Case_mpmc) * capacite );
+	file->masque = capacite - 1;
+	for( size_t i = 0; i < capacite; i++ ){
+		atomic_init( &file->cases[i].sequence, i );
+	}
+	atomic_init( &file->queue, 0 );
+	atomic_init( &file->tete, 0 );
+	return file;
+}
+
+void liberer_file_mpmc( File_mpmc * file ){
+	xfree( file->cases );
+	xfree( file );
+}
+
+/*
+ * La case d'indice i (modulo la capacité) a pour numéro de séquence i
+ * lorsqu'elle est libre pour le dépôt d'indice i, et i+1 lorsqu'elle
+ * contient l'élément déposé à l'indice i. Un prélèvement lui redonne le
+ * numéro i+capacité, celui du dépôt suivant dans cette case.
+ */
+int deposer_mpmc( File_mpmc * file, intptr_t element ){
+	Case_mpmc * c;
+	size_t position = atomic_load_explicit( &file->queue, memory_order_relaxed );
+	for( ;; ){
+		c = &file->cases[ position & file->masque ];
+		size_t sequence = atomic_load_explicit(
+			&c->sequence, memory_order_acquire
+		);
+		intptr_t difference = (intptr_t) sequence - (intptr_t) position;
+		if( difference == 0 ){
+			if( atomic_compare_exchange_weak_explicit(
+				&file->queue, &position, position + 1,
+				memory_order_relaxed, memory_order_relaxed
+			) ){
+				break;
+			}
+		}else if( difference < 0 ){
+			return 0;
+		}else{
+			position = atomic_load_explicit(
+				&file->queue, memory_order_relaxed
+			);
+		}
+	}
+	c->element = element;
+	atomic_store_explicit( &c->sequence, position + 1, memory_order_release );
+	return 1;
+}
+
+int prelever_mpmc( File_mpmc * file, intptr_t * element ){
+	Case_mpmc * c;
+	size_t position = atomic_load_explicit( &file->tete, memory_order_relaxed );
+	for( ;; ){
+		c = &file->cases[ position & file->masque ];
+		size_t sequence = atomic_load_explicit(
+			&c->sequence, memory_order_acquire
+		);
+		intptr_t difference = (intptr_t) sequence - (intptr_t) ( position + 1 );
+		if( difference == 0 ){
+			if( atomic_compare_exchange_weak_explicit(
+				&file->tete, &position, position + 1,
+				memory_order_relaxed, memory_order_relaxed
+			) ){
+				break;
+			}
+		}else if( difference < 0 ){
+			return 0;
+		}else{
+			position = atomic_load_explicit(
+				&file->tete, memory_order_relaxed
+			);
+		}
+	}
+	*element = c->element;
+	atomic_store_explicit(
+		&c->sequence, position + file->masque + 1, memory_order_release
+	);
+	return 1;
+}
+
+void deposer_spsc_attendre( File_spsc * file, intptr_t element ){
+	while( ! deposer_spsc( file, element ) ){
+		sched_yield();
+	}
+}
+
+intptr_t prelever_spsc_attendre( File_spsc * file ){
+	intptr_t element;
+	while( ! prelever_spsc( file, &element ) ){
+		sched_yield();
+	}
+	return element;
+}
+
+void deposer_mpmc_attendre( File_mpmc * file, intptr_t element ){
+	while( ! deposer_mpmc( file, element ) ){
+		sched_yield();
+	}
+}
+
+intptr_t prelever_mpmc_attendre( File_mpmc * file ){
+	intptr_t element;
+	while( ! prelever_mpmc( file, &element ) ){
+		sched_yield();
+	}
+	return element;
+}
@@ -0,0 +1,135 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2014, 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file files_concurrentes.h */
+
+#ifndef __FILES_CONCURRENTES_H__
+#define __FILES_CONCURRENTES_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#pragma GCC visibility push(default)
+
+/**
+ * @brief Le type d'une file bornée à un seul producteur et un seul
+ *        consommateur.
+ *
+ * La file est un tableau circulaire sans verrou (atomiques de C11) : un
+ * seul fil d'exécution peut y déposer des éléments et un seul autre peut en
+ * prélever, simultanément. Aucune allocation n'a lieu après la création.
+ */
+typedef struct File_spsc File_spsc;
+
+/**
+ * @brief Le type d'une file bornée à plusieurs producteurs et plusieurs
+ *        consommateurs.
+ *
+ * La file est un tableau circulaire sans verrou dont chaque case porte un
+ * numéro de séquence : producteurs et consommateurs réservent une case par
+ * une opération compare-and-swap sur leur indice, puis publient la case en
+ * mettant à jour son numéro de séquence. Aucune allocation n'a lieu après
+ * la création.
+ */
+typedef struct File_mpmc File_mpmc;
+
+/**
+ * @brief Crée une file SPSC vide.
+ *
+ * @param capacite Le nombre minimal d'éléments que la file peut contenir
+ *        (arrondi à la puissance de 2 supérieure).
+ * @return La file.
+ */
+File_spsc * creer_file_spsc( size_t capacite );
+
+/**
+ * @brief Détruit une file SPSC. Aucun fil ne doit plus l'utiliser.
+ *
+ * @param file La file.
+ */
+void liberer_file_spsc( File_spsc * file );
+
+/**
+ * @brief Dépose un élément à la fin d'une file SPSC, si elle n'est pas
+ *        pleine. Ne doit être appelée que par le producteur.
+ *
+ * @param file La file.
+ * @param element L'élément.
+ * @return 1 si l'élément a été déposé, 0 si la file est pleine.
+ */
+int deposer_spsc( File_spsc * file, intptr_t element );
+
+/**
+ * @brief Prélève l'élément du début d'une file SPSC, si elle n'est pas vide.
+ *        Ne doit être appelée que par le consommateur.
+ *
+ * @param file La file.
+ * @param element Un pointeur qui reçoit l'élément prélevé.
+ * @return 1 si un élément a été prélevé, 0 si la file est vide.
+ */
+int prelever_spsc( File_spsc * file, intptr_t * element );
+
+/**
+ * @brief Crée une file MPMC vide.
+ *
+ * @param capacite Le nombre minimal d'éléments que la file peut contenir
+ *        (arrondi à la puissance de 2 supérieure, et au moins 2).
+ * @return La file.
+ */
+File_mpmc * creer_file_mpmc( size_t capacite );
+
+/**
+ * @brief Détruit une file MPMC. Aucun fil ne doit plus l'utiliser.
+ *
+ * @param file La file.
+ */
+void liberer_file_mpmc( File_mpmc * file );
+
+/**
+ * @brief Dépose un élément à la fin d'une file MPMC, si elle n'est pas
+ *        pleine.
+ *
+ * @param file La file.
+ * @param element L'élément.
+ * @return 1 si l'élément a été déposé, 0 si la file est pleine.
+ */
+int deposer_mpmc( File_mpmc * file, intptr_t element );
+
+/**
+ * @brief Prélève l'élément du début d'une file MPMC, si elle n'est pas vide.
+ *
+ * @param file La file.
+ * @param element Un pointeur qui reçoit l'élément prélevé.
+ * @return 1 si un élément a été prélevé, 0 si la file est vide.
+ */
+int prelever_mpmc( File_mpmc * file, intptr_t * element );
+
+/**
+ * @brief Versions bloquantes : attendent, en cédant le processeur, que la
+ *        file ait de la place (dépôt) ou un élément (prélèvement).
+ */
+void deposer_spsc_attendre( File_spsc * file, intptr_t element );
+intptr_t prelever_spsc_attendre( File_spsc * file );
+void deposer_mpmc_attendre( File_mpmc * file, intptr_t element );
+intptr_t prelever_mpmc_attendre( File_mpmc * file );
+
+#pragma GCC visibility pop
+
+#endif
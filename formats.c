@@ -0,0 +1,633 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2014, 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "formats.h"
+#include "outils.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <assert.h>
+
+#define TAILLE_TAMPON (1 << 16)
+#define LONGUEUR_LIGNE_MAX 4096
+
+/*
+ * Tampon d'écriture vers un flux ou, si le flux vaut NULL, vers un
+ * descripteur de fichier.
+ */
+typedef struct {
+	FILE * flux;
+	int fd;
+	size_t taille;
+	int erreur;
+	char donnees[TAILLE_TAMPON];
+} Tampon_ecriture;
+
+static void vider_tampon( Tampon_ecriture * t ){
+	size_t ecrit = 0;
+	if( t->flux ){
+		if( t->taille && fwrite( t->donnees, t->taille, 1, t->flux ) != 1 ){
+			t->erreur = 1;
+		}
+	}else{
+		while( ecrit < t->taille ){
+			ssize_t n = write( t->fd, t->donnees + ecrit, t->taille - ecrit );
+			if( n < 0 && errno == EINTR ) continue;
+			if( n <= 0 ){
+				t->erreur = 1;
+				break;
+			}
+			ecrit += n;
+		}
+	}
+	t->taille = 0;
+}
+
+static void ecrire_octets( Tampon_ecriture * t, const char * octets, size_t n ){
+	if( t->taille + n > TAILLE_TAMPON ){
+		vider_tampon( t );
+	}
+	memcpy( t->donnees + t->taille, octets, n );
+	t->taille += n;
+}
+
+static void ecrire_chaine( Tampon_ecriture * t, const char * chaine ){
+	ecrire_octets( t, chaine, strlen( chaine ) );
+}
+
+static void ecrire_caractere( Tampon_ecriture * t, char c ){
+	ecrire_octets( t, &c, 1 );
+}
+
+static void ecrire_entier( Tampon_ecriture * t, int n ){
+	char chiffres[16];
+	int i = sizeof(chiffres);
+	// On travaille sur un non signé pour que INT_MIN ne déborde pas.
+	unsigned int u = n < 0 ? - (unsigned int) n : (unsigned int) n;
+	do {
+		chiffres[--i] = '0' + u % 10;
+		u /= 10;
+	} while( u );
+	if( n < 0 ) chiffres[--i] = '-';
+	ecrire_octets( t, chiffres + i, sizeof(chiffres) - i );
+}
+
+static int est_imprimable( unsigned char c ){
+	return c > ' ' && c < 127;
+}
+
+static void ecrire_lettre( Tampon_ecriture * t, char lettre ){
+	static const char hexa[] = "0123456789abcdef";
+	unsigned char c = lettre;
+	if( est_imprimable( c ) ){
+		ecrire_caractere( t, lettre );
+	}else{
+		char code[4] = { '\\', 'x', hexa[c >> 4], hexa[c & 15] };
+		ecrire_octets( t, code, 4 );
+	}
+}
+
+/*
+ * Écriture au format AT&T : les transitions de l'état initial d'abord, pour
+ * que l'origine de la première ligne soit l'état initial.
+ */
+typedef struct {
+	Tampon_ecriture * tampon;
+	int initial;
+	int depuis_initial; //!< 1 pour n'écrire que les transitions de l'initial.
+	int nb_ecrites;
+} Ecriture_att;
+
+static void ecrire_transition_att( int origine, char lettre, int fin, void * data ){
+	Ecriture_att * e = (Ecriture_att *) data;
+	if( ( origine == e->initial ) != e->depuis_initial ) return;
+	ecrire_entier( e->tampon, origine );
+	ecrire_caractere( e->tampon, '\t' );
+	ecrire_entier( e->tampon, fin );
+	ecrire_caractere( e->tampon, '\t' );
+	ecrire_lettre( e->tampon, lettre );
+	ecrire_caractere( e->tampon, '\n' );
+	e->nb_ecrites++;
+}
+
+static void ecrire_etats(
+	Tampon_ecriture * t, const Ensemble * etats, const char * avant,
+	const char * apres
+){
+	Ensemble_iterateur it;
+	for(
+		it = premier_iterateur_ensemble( etats );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		ecrire_chaine( t, avant );
+		ecrire_entier( t, get_element( it ) );
+		ecrire_chaine( t, apres );
+	}
+}
+
+static int ecrire_att( const Automate * automate, Tampon_ecriture * t ){
+	const Ensemble * initiaux = get_initiaux( automate );
+	Ecriture_att e;
+
+	if( taille_ensemble( initiaux ) > 1 ) return 0;
+	if( taille_ensemble( initiaux ) == 0 ) return 1;
+
+	e.tampon = t;
+	e.initial = get_element( premier_iterateur_ensemble( initiaux ) );
+	e.depuis_initial = 1;
+	e.nb_ecrites = 0;
+	pour_toute_transition( automate, ecrire_transition_att, &e );
+	if( e.nb_ecrites == 0 ){
+		// Seul le mot vide peut être reconnu.
+		if( est_un_etat_final_de_l_automate( automate, e.initial ) ){
+			ecrire_entier( t, e.initial );
+			ecrire_caractere( t, '\n' );
+		}
+		return 1;
+	}
+	e.depuis_initial = 0;
+	pour_toute_transition( automate, ecrire_transition_att, &e );
+	ecrire_etats( t, get_finaux( automate ), "", "\n" );
+	return 1;
+}
+
+static void ecrire_transition_ba( int origine, char lettre, int fin, void * data ){
+	Tampon_ecriture * t = (Tampon_ecriture *) data;
+	ecrire_lettre( t, lettre );
+	ecrire_chaine( t, ",[" );
+	ecrire_entier( t, origine );
+	ecrire_chaine( t, "]->[" );
+	ecrire_entier( t, fin );
+	ecrire_chaine( t, "]\n" );
+}
+
+static void compter_transition( int origine, char lettre, int fin, void * data ){
+	( *(int *) data )++;
+}
+
+static int ecrire_ba( const Automate * automate, Tampon_ecriture * t ){
+	const Ensemble * initiaux = get_initiaux( automate );
+	const Ensemble * finaux = get_finaux( automate );
+	Ensemble_iterateur it;
+	int nb_transitions = 0;
+
+	// Un fichier sans état final aurait tous ses états finaux : le langage
+	// vide est écrit comme un fichier vide.
+	if( taille_ensemble( initiaux ) == 0 || taille_ensemble( finaux ) == 0 ){
+		return 1;
+	}
+	pour_toute_transition( automate, compter_transition, &nb_transitions );
+	if( nb_transitions == 0 ){
+		// Seul le mot vide peut être reconnu.
+		for(
+			it = premier_iterateur_ensemble( initiaux );
+			! iterateur_ensemble_est_vide( it );
+			it = iterateur_suivant_ensemble( it )
+		){
+			if( est_dans_l_ensemble( finaux, get_element( it ) ) ){
+				ecrire_chaine( t, "[" );
+				ecrire_entier( t, get_element( it ) );
+				ecrire_chaine( t, "]\n[" );
+				ecrire_entier( t, get_element( it ) );
+				ecrire_chaine( t, "]\n" );
+				break;
+			}
+		}
+		return 1;
+	}
+	ecrire_etats( t, initiaux, "[", "]\n" );
+	pour_toute_transition( automate, ecrire_transition_ba, t );
+	ecrire_etats( t, finaux, "[", "]\n" );
+	return 1;
+}
+
+static void ecrire_transition_dot( int origine, char lettre, int fin, void * data ){
+	Tampon_ecriture * t = (Tampon_ecriture *) data;
+	unsigned char c = lettre;
+	ecrire_caractere( t, '\t' );
+	ecrire_entier( t, origine );
+	ecrire_chaine( t, " -> " );
+	ecrire_entier( t, fin );
+	ecrire_chaine( t, " [label=\"" );
+	if( c == '"' || c == '\\' ){
+		ecrire_caractere( t, '\\' );
+		ecrire_caractere( t, lettre );
+	}else if( est_imprimable( c ) ){
+		ecrire_caractere( t, lettre );
+	}else{
+		// Le code hexadécimal est affiché tel quel.
+		ecrire_caractere( t, '\\' );
+		ecrire_lettre( t, lettre );
+	}
+	ecrire_chaine( t, "\"];\n" );
+}
+
+static int ecrire_dot( const Automate * automate, Tampon_ecriture * t ){
+	Ensemble_iterateur it;
+	int i = 0;
+
+	ecrire_chaine( t, "digraph automate {\n\trankdir=LR;\n" );
+	ecrire_chaine( t, "\tnode [shape=circle];\n" );
+	ecrire_etats( t, get_etats( automate ), "\t", ";\n" );
+	ecrire_etats( t, get_finaux( automate ), "\t", " [shape=doublecircle];\n" );
+	for(
+		it = premier_iterateur_ensemble( get_initiaux( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it ), i++
+	){
+		ecrire_chaine( t, "\t_initial" );
+		ecrire_entier( t, i );
+		ecrire_chaine( t, " [shape=point];\n\t_initial" );
+		ecrire_entier( t, i );
+		ecrire_chaine( t, " -> " );
+		ecrire_entier( t, get_element( it ) );
+		ecrire_chaine( t, ";\n" );
+	}
+	pour_toute_transition( automate, ecrire_transition_dot, t );
+	ecrire_chaine( t, "}\n" );
+	return 1;
+}
+
+static int ecrire(
+	const Automate * automate, Format_automate format, FILE * flux, int fd
+){
+	Tampon_ecriture * t = xmalloc( sizeof(Tampon_ecriture) );
+	int res = 0;
+
+	t->flux = flux;
+	t->fd = fd;
+	t->taille = 0;
+	t->erreur = 0;
+	switch( format ){
+		case FORMAT_ATT : res = ecrire_att( automate, t ); break;
+		case FORMAT_BA : res = ecrire_ba( automate, t ); break;
+		case FORMAT_DOT : res = ecrire_dot( automate, t ); break;
+	}
+	vider_tampon( t );
+	if( flux && fflush( flux ) != 0 ) t->erreur = 1;
+	res = res && ! t->erreur;
+	xfree( t );
+	return res;
+}
+
+int ecrire_automate(
+	const Automate * automate, Format_automate format, FILE * flux
+){
+	assert( flux );
+	return ecrire( automate, format, flux, -1 );
+}
+
+int ecrire_automate_fd(
+	const Automate * automate, Format_automate format, int fd
+){
+	return ecrire( automate, format, NULL, fd );
+}
+
+/*
+ * Tampon de lecture depuis un flux ou, si le flux vaut NULL, depuis un
+ * descripteur de fichier.
+ */
+typedef struct {
+	FILE * flux;
+	int fd;
+	size_t debut;
+	size_t fin;
+	int termine;
+	int erreur;
+	char donnees[TAILLE_TAMPON];
+	char ligne[LONGUEUR_LIGNE_MAX + 1];
+} Tampon_lecture;
+
+static void remplir_tampon( Tampon_lecture * t ){
+	t->debut = 0;
+	t->fin = 0;
+	if( t->flux ){
+		t->fin = fread( t->donnees, 1, TAILLE_TAMPON, t->flux );
+		if( t->fin == 0 ){
+			t->termine = 1;
+			if( ferror( t->flux ) ) t->erreur = 1;
+		}
+	}else{
+		ssize_t n;
+		do {
+			n = read( t->fd, t->donnees, TAILLE_TAMPON );
+		} while( n < 0 && errno == EINTR );
+		if( n <= 0 ){
+			t->termine = 1;
+			if( n < 0 ) t->erreur = 1;
+		}else{
+			t->fin = n;
+		}
+	}
+}
+
+/*
+ * Lit la ligne suivante dans t->ligne, sans le retour à la ligne, et renvoie
+ * sa longueur. Renvoie -1 à la fin du fichier et -2 si la ligne est trop
+ * longue.
+ */
+static int lire_ligne( Tampon_lecture * t ){
+	int longueur = 0;
+	int lu = 0;
+	for( ;; ){
+		if( t->debut == t->fin ){
+			if( t->termine ) break;
+			remplir_tampon( t );
+			if( t->termine ) break;
+		}
+		char * debut = t->donnees + t->debut;
+		char * retour = memchr( debut, '\n', t->fin - t->debut );
+		size_t n = retour ? (size_t) ( retour - debut ) : t->fin - t->debut;
+		lu = 1;
+		if( longueur + n > LONGUEUR_LIGNE_MAX ) return -2;
+		memcpy( t->ligne + longueur, debut, n );
+		longueur += n;
+		t->debut += n;
+		if( retour ){
+			t->debut++;
+			break;
+		}
+	}
+	if( ! lu ) return -1;
+	if( longueur > 0 && t->ligne[longueur-1] == '\r' ) longueur--;
+	t->ligne[longueur] = '\0';
+	return longueur;
+}
+
+static int est_blanc( char c ){
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+static const char * sauter_blancs( const char * p ){
+	while( est_blanc( *p ) ) p++;
+	return p;
+}
+
+/*
+ * Lit un entier au début de *p, et avance *p après l'entier.
+ */
+static int lire_entier( const char ** p, int * valeur ){
+	const char * q = *p;
+	long long n = 0;
+	int signe = 1;
+	if( *q == '-' ){
+		signe = -1;
+		q++;
+	}
+	if( *q < '0' || *q > '9' ) return 0;
+	while( *q >= '0' && *q <= '9' ){
+		n = 10 * n + ( *q++ - '0' );
+		if( n > (long long) INT_MAX + 1 ) return 0;
+	}
+	n *= signe;
+	if( n > INT_MAX || n < INT_MIN ) return 0;
+	*valeur = (int) n;
+	*p = q;
+	return 1;
+}
+
+static int valeur_hexa( char c ){
+	if( c >= '0' && c <= '9' ) return c - '0';
+	if( c >= 'a' && c <= 'f' ) return c - 'a' + 10;
+	if( c >= 'A' && c <= 'F' ) return c - 'A' + 10;
+	return -1;
+}
+
+/*
+ * Décode une lettre écrite sur 'longueur' caractères.
+ */
+static int lire_lettre( const char * jeton, int longueur, char * lettre ){
+	if( longueur == 1 ){
+		*lettre = jeton[0];
+		return 1;
+	}
+	if(
+		longueur == 4 && jeton[0] == '\\' && jeton[1] == 'x'
+		&& valeur_hexa( jeton[2] ) >= 0 && valeur_hexa( jeton[3] ) >= 0
+	){
+		*lettre = (char) ( valeur_hexa( jeton[2] ) * 16 + valeur_hexa( jeton[3] ) );
+		return 1;
+	}
+	return 0;
+}
+
+/*
+ * Découpe une ligne en au plus 'nb_max' jetons séparés par des blancs, et
+ * renvoie le nombre de jetons.
+ */
+static int decouper( const char * ligne, const char ** jetons, int * longueurs, int nb_max ){
+	int nb = 0;
+	const char * p = sauter_blancs( ligne );
+	while( *p && nb < nb_max ){
+		jetons[nb] = p;
+		while( *p && ! est_blanc( *p ) ) p++;
+		longueurs[nb] = p - jetons[nb];
+		nb++;
+		p = sauter_blancs( p );
+	}
+	return *p ? nb_max + 1 : nb;
+}
+
+/*
+ * Lit un jeton qui doit être exactement un entier.
+ */
+static int lire_entier_jeton( const char * jeton, int longueur, int * valeur ){
+	const char * p = jeton;
+	return lire_entier( &p, valeur ) && p == jeton + longueur;
+}
+
+static int lire_ligne_att(
+	Automate * automate, const char * ligne, int * premiere
+){
+	const char * jetons[5];
+	int longueurs[5];
+	int nb = decouper( ligne, jetons, longueurs, 5 );
+	int origine, fin;
+	char lettre;
+
+	if( nb == 0 ) return 1;
+	if( nb > 5 || ! lire_entier_jeton( jetons[0], longueurs[0], &origine ) ){
+		return 0;
+	}
+	if( nb >= 3 && (
+		! lire_entier_jeton( jetons[1], longueurs[1], &fin )
+		|| ! lire_lettre( jetons[2], longueurs[2], &lettre )
+	) ){
+		return 0;
+	}
+	if( *premiere ){
+		ajouter_etat_initial( automate, origine );
+		*premiere = 0;
+	}
+	if( nb <= 2 ){
+		ajouter_etat_final( automate, origine );
+	}else{
+		ajouter_transition( automate, origine, lettre, fin );
+	}
+	return 1;
+}
+
+/*
+ * Lit un état « [entier] » au début de *p, et avance *p après l'état.
+ */
+static int lire_etat_ba( const char ** p, int * etat ){
+	const char * q = sauter_blancs( *p );
+	if( *q != '[' ) return 0;
+	q++;
+	if( ! lire_entier( &q, etat ) || *q != ']' ) return 0;
+	*p = sauter_blancs( q + 1 );
+	return 1;
+}
+
+/*
+ * Les lignes d'états lues avant la première transition : ce sont les états
+ * initiaux, sauf si le fichier n'a aucune transition.
+ */
+typedef struct {
+	int nb_transitions;
+	int nb_finaux;
+	int nb_avant;
+	int capacite_avant;
+	int * avant;
+} Lecture_ba;
+
+static int lire_ligne_ba(
+	Automate * automate, const char * ligne, Lecture_ba * l
+){
+	const char * p = sauter_blancs( ligne );
+	const char * fleche = strstr( p, "->" );
+	int origine, fin;
+	char lettre;
+
+	if( *p == '\0' ) return 1;
+	if( ! fleche ){
+		if( ! lire_etat_ba( &p, &origine ) || *p != '\0' ) return 0;
+		if( l->nb_transitions == 0 ){
+			if( l->nb_avant == l->capacite_avant ){
+				l->capacite_avant = 2 * l->capacite_avant + 1;
+				l->avant = xrealloc( l->avant, sizeof(int) * l->capacite_avant );
+			}
+			l->avant[ l->nb_avant++ ] = origine;
+		}else{
+			ajouter_etat_final( automate, origine );
+			l->nb_finaux++;
+		}
+		return 1;
+	}
+
+	// La lettre se termine à la première virgule suivie d'un état : elle
+	// peut elle-même être une virgule.
+	const char * virgule = p;
+	while( virgule < fleche && ! ( virgule[0] == ',' && virgule[1] == '[' ) ){
+		virgule++;
+	}
+	if( virgule == fleche || ! lire_lettre( p, virgule - p, &lettre ) ){
+		return 0;
+	}
+	p = virgule + 1;
+	if( ! lire_etat_ba( &p, &origine ) || p != fleche ) return 0;
+	p = fleche + 2;
+	if( ! lire_etat_ba( &p, &fin ) || *p != '\0' ) return 0;
+
+	if( l->nb_transitions++ == 0 ){
+		int i;
+		for( i=0; i<l->nb_avant; i++ ){
+			ajouter_etat_initial( automate, l->avant[i] );
+		}
+	}
+	ajouter_transition( automate, origine, lettre, fin );
+	return 1;
+}
+
+static void terminer_ba( Automate * automate, Lecture_ba * l ){
+	int i;
+	if( l->nb_transitions == 0 && l->nb_avant > 0 ){
+		ajouter_etat_initial( automate, l->avant[0] );
+		for( i=1; i<l->nb_avant; i++ ){
+			ajouter_etat_final( automate, l->avant[i] );
+			l->nb_finaux++;
+		}
+	}
+	if( l->nb_finaux == 0 && ( l->nb_avant > 0 || l->nb_transitions > 0 ) ){
+		ajouter_elements( automate->finaux, get_etats( automate ) );
+	}
+}
+
+static Automate * lire(
+	Format_automate format, FILE * flux, int fd, int * ligne_erreur
+){
+	Tampon_lecture * t = xmalloc( sizeof(Tampon_lecture) );
+	Automate * automate = creer_automate();
+	Lecture_ba ba = { 0, 0, 0, 0, NULL };
+	int premiere = 1;
+	int numero = 0;
+	int ok = ( format != FORMAT_DOT );
+	int longueur;
+
+	t->flux = flux;
+	t->fd = fd;
+	t->debut = 0;
+	t->fin = 0;
+	t->termine = 0;
+	t->erreur = 0;
+	while( ok && ( longueur = lire_ligne( t ) ) != -1 ){
+		numero++;
+		if( longueur == -2 ){
+			ok = 0;
+		}else if( format == FORMAT_ATT ){
+			ok = lire_ligne_att( automate, t->ligne, &premiere );
+		}else{
+			ok = lire_ligne_ba( automate, t->ligne, &ba );
+		}
+	}
+	if( ok && format == FORMAT_BA ){
+		terminer_ba( automate, &ba );
+	}
+	if( ligne_erreur ){
+		*ligne_erreur = ok ? 0 : numero;
+	}
+	if( t->erreur ) ok = 0;
+	xfree( ba.avant );
+	xfree( t );
+	if( ! ok ){
+		liberer_automate( automate );
+		return NULL;
+	}
+	return automate;
+}
+
+Automate * lire_automate(
+	Format_automate format, FILE * flux, int * ligne_erreur
+){
+	assert( flux );
+	return lire( format, flux, -1, ligne_erreur );
+}
+
+Automate * lire_automate_fd(
+	Format_automate format, int fd, int * ligne_erreur
+){
+	return lire( format, NULL, fd, ligne_erreur );
+}
@@ -0,0 +1,128 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2014, 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file formats.h */
+
+#ifndef __FORMATS_H__
+#define __FORMATS_H__
+
+#include "automate.h"
+
+#include <stdio.h>
+
+#pragma GCC visibility push(default)
+
+/**
+ * @brief Les formats textuels d'échange d'automates.
+ *
+ * Dans tous les formats, une lettre est écrite telle quelle si c'est un
+ * caractère imprimable autre que l'espace, et sous la forme \\xHH (code
+ * hexadécimal) sinon. Les états sont des entiers.
+ *
+ * - FORMAT_ATT : la liste de transitions du format texte d'AT&T et
+ *   d'OpenFST, pour un accepteur. Chaque ligne est soit une transition
+ *   « origine fin lettre » (les colonnes suivantes, étiquette de sortie et
+ *   poids, sont ignorées à la lecture), soit un état final « etat » (suivi
+ *   éventuellement d'un poids, ignoré). L'état initial, unique, est l'origine
+ *   de la première ligne.
+ * - FORMAT_BA : le format BA des outils d'inclusion d'automates (variante
+ *   pour les mots du format Timbuk). Le fichier contient les états initiaux
+ *   « [etat] », puis les transitions « lettre,[origine]->[fin] », puis les
+ *   états finaux « [etat] ». Si un fichier ne contient aucun état final, tous
+ *   ses états sont finaux. Si un fichier ne contient aucune transition, sa
+ *   première ligne est l'état initial et les suivantes sont finales.
+ * - FORMAT_DOT : le langage de Graphviz, en écriture seulement.
+ *
+ * Les lignes vides et les blancs en début et en fin de ligne sont ignorés.
+ */
+typedef enum {
+	FORMAT_ATT,
+	FORMAT_BA,
+	FORMAT_DOT
+} Format_automate;
+
+/**
+ * @brief Écrit un automate dans un flux, au format demandé.
+ *
+ * L'automate écrit reconnaît le même langage, mais les états isolés et les
+ * lettres qui n'apparaissent dans aucune transition ne sont pas écrits.
+ * Au format FORMAT_ATT, l'automate doit avoir au plus un état initial :
+ * sinon, rien n'est écrit et la fonction renvoie 0.
+ *
+ * L'écriture passe par un tampon interne, qui est vidé dans le flux avant
+ * que la fonction ne se termine.
+ *
+ * @param automate Un automate.
+ * @param format Le format.
+ * @param flux Le flux, ouvert en écriture.
+ * @return 1 si l'automate a été écrit, 0 en cas d'erreur.
+ */
+int ecrire_automate(
+	const Automate * automate, Format_automate format, FILE * flux
+);
+
+/**
+ * @brief Écrit un automate dans un descripteur de fichier, au format demandé.
+ *
+ * Voir ecrire_automate().
+ *
+ * @param automate Un automate.
+ * @param format Le format.
+ * @param fd Le descripteur de fichier, ouvert en écriture.
+ * @return 1 si l'automate a été écrit, 0 en cas d'erreur.
+ */
+int ecrire_automate_fd(
+	const Automate * automate, Format_automate format, int fd
+);
+
+/**
+ * @brief Lit un automate dans un flux, au format demandé.
+ *
+ * Le flux est lu jusqu'à sa fin. Au format FORMAT_BA, seuls les noms
+ * d'états entiers sont acceptés. Le format FORMAT_DOT ne peut pas être lu.
+ *
+ * @param format Le format.
+ * @param flux Le flux, ouvert en lecture.
+ * @param ligne_erreur Un pointeur qui recevra le numéro (à partir de 1) de
+ *        la ligne erronée en cas d'erreur de syntaxe, et 0 sinon, ou NULL.
+ * @return L'automate lu, ou NULL en cas d'erreur.
+ */
+Automate * lire_automate(
+	Format_automate format, FILE * flux, int * ligne_erreur
+);
+
+/**
+ * @brief Lit un automate dans un descripteur de fichier, au format demandé.
+ *
+ * Voir lire_automate().
+ *
+ * @param format Le format.
+ * @param fd Le descripteur de fichier, ouvert en lecture.
+ * @param ligne_erreur Un pointeur qui recevra le numéro de la ligne erronée,
+ *        ou NULL.
+ * @return L'automate lu, ou NULL en cas d'erreur.
+ */
+Automate * lire_automate_fd(
+	Format_automate format, int fd, int * ligne_erreur
+);
+
+#pragma GCC visibility pop
+
+#endif
@@ -0,0 +1,779 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2014, 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "langage.h"
+#include "automate_compile.h"
+#include "outils.h"
+#include "ensemble.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <assert.h>
+
+/*
+ * Reconstruit le mot lu depuis la racine jusqu'au noeud 'noeud' en remontant
+ * les tableaux 'parents' et 'lettres'.
+ */
+static char * reconstruire_mot(
+	const int * parents, const char * lettres, int noeud
+){
+	int longueur = 0;
+	int n;
+	for( n = noeud; parents[n] != -1; n = parents[n] ){
+		longueur++;
+	}
+	char * mot = xmalloc( longueur + 1 );
+	mot[longueur] = '\0';
+	for( n = noeud; parents[n] != -1; n = parents[n] ){
+		mot[--longueur] = lettres[n];
+	}
+	return mot;
+}
+
+char * mot_le_plus_court( const Automate * automate ){
+	Automate_indexe * index = indexer_automate( automate );
+	int n = index->nb_etats;
+	int L = index->nb_lettres;
+	int * parents = xmalloc( sizeof(int) * ( n + 1 ) );
+	char * lettres = xmalloc( n + 1 );
+	int * file = xmalloc( sizeof(int) * ( n + 1 ) );
+	unsigned char * vu = xmalloc( n + 1 );
+	int debut_file = 0, fin_file = 0;
+	int trouve = -1;
+	int i, l, t;
+
+	memset( vu, 0, n + 1 );
+	for( i=0; i<index->nb_initiaux; i++ ){
+		int e = index->initiaux[i];
+		vu[e] = 1;
+		parents[e] = -1;
+		file[fin_file++] = e;
+	}
+	while( debut_file < fin_file && trouve == -1 ){
+		int e = file[debut_file++];
+		if( index->finaux[e] ){
+			trouve = e;
+			break;
+		}
+		for( l=0; l<L; l++ ){
+			int k = e * L + l;
+			for( t=index->debut[k]; t<index->debut[k+1]; t++ ){
+				int f = index->fins[t];
+				if( ! vu[f] ){
+					vu[f] = 1;
+					parents[f] = e;
+					lettres[f] = index->lettres[l];
+					file[fin_file++] = f;
+				}
+			}
+		}
+	}
+
+	char * mot = ( trouve == -1 ) ? NULL : reconstruire_mot(
+		parents, lettres, trouve
+	);
+	xfree( parents );
+	xfree( lettres );
+	xfree( file );
+	xfree( vu );
+	liberer_automate_indexe( index );
+	return mot;
+}
+
+int est_vide_langage( const Automate * automate, char ** mot ){
+	char * res = mot_le_plus_court( automate );
+	int vide = ( res == NULL );
+	if( mot ){
+		*mot = res;
+	}else{
+		xfree( res );
+	}
+	return vide;
+}
+
+/*
+ * Un noeud de l'antichaîne : un état du premier automate associé à un
+ * ensemble trié d'états du second automate, rangé dans 'Antichaine.valeurs'.
+ */
+typedef struct {
+	int etat;
+	int debut;
+	int taille;
+	int suivant; //!< Noeud suivant ayant le même état, ou -1.
+	int vivant;
+} Noeud_antichaine;
+
+typedef struct {
+	Noeud_antichaine * noeuds;
+	int * parents;
+	char * lettres;
+	int nb_noeuds;
+	int capacite;
+	int * valeurs;
+	int taille_valeurs;
+	int capacite_valeurs;
+	int * tetes; //!< Pour chaque état du premier automate, son premier noeud.
+} Antichaine;
+
+static int est_sous_ensemble(
+	const int * a, int taille_a, const int * b, int taille_b
+){
+	int i = 0, j = 0;
+	if( taille_a > taille_b ){
+		return 0;
+	}
+	while( i < taille_a ){
+		if( j == taille_b || a[i] < b[j] ){
+			return 0;
+		}
+		if( a[i] == b[j] ){
+			i++;
+		}
+		j++;
+	}
+	return 1;
+}
+
+/*
+ * Ajoute le noeud (etat, elements) à l'antichaîne, sauf s'il contient déjà un
+ * noeud plus petit. Les noeuds plus grands sont retirés de l'antichaîne.
+ * Renvoie le numéro du noeud ajouté, ou -1.
+ */
+static int ajouter_antichaine(
+	Antichaine * ac, int etat, const int * elements, int taille,
+	int parent, char lettre
+){
+	int n, precedent;
+	for( n = ac->tetes[etat]; n != -1; n = ac->noeuds[n].suivant ){
+		const Noeud_antichaine * noeud = &ac->noeuds[n];
+		if(
+			est_sous_ensemble(
+				ac->valeurs + noeud->debut, noeud->taille, elements, taille
+			)
+		){
+			return -1;
+		}
+	}
+	precedent = -1;
+	for( n = ac->tetes[etat]; n != -1; n = ac->noeuds[n].suivant ){
+		Noeud_antichaine * noeud = &ac->noeuds[n];
+		if(
+			est_sous_ensemble(
+				elements, taille, ac->valeurs + noeud->debut, noeud->taille
+			)
+		){
+			noeud->vivant = 0;
+			if( precedent == -1 ){
+				ac->tetes[etat] = noeud->suivant;
+			}else{
+				ac->noeuds[precedent].suivant = noeud->suivant;
+			}
+		}else{
+			precedent = n;
+		}
+	}
+
+	if( ac->nb_noeuds == ac->capacite ){
+		ac->capacite *= 2;
+		ac->noeuds = xrealloc(
+			ac->noeuds, sizeof(Noeud_antichaine) * ac->capacite
+		);
+		ac->parents = xrealloc( ac->parents, sizeof(int) * ac->capacite );
+		ac->lettres = xrealloc( ac->lettres, ac->capacite );
+	}
+	while( ac->taille_valeurs + taille > ac->capacite_valeurs ){
+		ac->capacite_valeurs *= 2;
+		ac->valeurs = xrealloc(
+			ac->valeurs, sizeof(int) * ac->capacite_valeurs
+		);
+	}
+	n = ac->nb_noeuds++;
+	Noeud_antichaine * noeud = &ac->noeuds[n];
+	noeud->etat = etat;
+	noeud->debut = ac->taille_valeurs;
+	noeud->taille = taille;
+	noeud->vivant = 1;
+	noeud->suivant = ac->tetes[etat];
+	ac->tetes[etat] = n;
+	ac->parents[n] = parent;
+	ac->lettres[n] = lettre;
+	memcpy( ac->valeurs + ac->taille_valeurs, elements, sizeof(int) * taille );
+	ac->taille_valeurs += taille;
+	return n;
+}
+
+static int intersecte_finaux(
+	const Automate_indexe * automate, const int * elements, int taille
+){
+	int i;
+	for( i=0; i<taille; i++ ){
+		if( automate->finaux[ elements[i] ] ){
+			return 1;
+		}
+	}
+	return 0;
+}
+
+static int comparer_entiers( const void * a, const void * b ){
+	int x = *(const int *) a;
+	int y = *(const int *) b;
+	return ( x > y ) - ( x < y );
+}
+
+int est_inclus(
+	const Automate * automate_1, const Automate * automate_2,
+	char ** contre_exemple
+){
+	Automate_indexe * a = indexer_automate( automate_1 );
+	Automate_indexe * b = indexer_automate( automate_2 );
+	int i, l, t, j;
+	int mauvais = -1;
+
+	Antichaine ac;
+	ac.capacite = 16;
+	ac.nb_noeuds = 0;
+	ac.noeuds = xmalloc( sizeof(Noeud_antichaine) * ac.capacite );
+	ac.parents = xmalloc( sizeof(int) * ac.capacite );
+	ac.lettres = xmalloc( ac.capacite );
+	ac.capacite_valeurs = 64;
+	ac.taille_valeurs = 0;
+	ac.valeurs = xmalloc( sizeof(int) * ac.capacite_valeurs );
+	ac.tetes = xmalloc( sizeof(int) * ( a->nb_etats + 1 ) );
+	for( i=0; i<a->nb_etats; i++ ){
+		ac.tetes[i] = -1;
+	}
+
+	int * successeurs = xmalloc( sizeof(int) * ( b->nb_etats + 1 ) );
+	int * marque = xmalloc( sizeof(int) * ( b->nb_etats + 1 ) );
+	for( i=0; i<b->nb_etats; i++ ){
+		marque[i] = -1;
+	}
+	int tampon = 0;
+
+	for( i=0; i<a->nb_initiaux && mauvais == -1; i++ ){
+		int n = ajouter_antichaine(
+			&ac, a->initiaux[i], b->initiaux, b->nb_initiaux, -1, '\0'
+		);
+		if(
+			n != -1 && a->finaux[ a->initiaux[i] ] &&
+			! intersecte_finaux( b, b->initiaux, b->nb_initiaux )
+		){
+			mauvais = n;
+		}
+	}
+
+	// Les noeuds sont numérotés dans l'ordre de leur création : la file du
+	// parcours en largeur est 0, 1, ..., ac.nb_noeuds-1.
+	int courant;
+	for( courant = 0; courant < ac.nb_noeuds && mauvais == -1; courant++ ){
+		if( ! ac.noeuds[courant].vivant ){
+			continue;
+		}
+		for( l=0; l<a->nb_lettres && mauvais == -1; l++ ){
+			char lettre = a->lettres[l];
+			int lb = b->indice_lettre[(unsigned char) lettre];
+
+			// L'ensemble des successeurs dans le second automate
+			int nb_successeurs = 0;
+			tampon++;
+			if( lb != -1 ){
+				Noeud_antichaine noeud = ac.noeuds[courant];
+				for( j=noeud.debut; j<noeud.debut+noeud.taille; j++ ){
+					int k = ac.valeurs[j] * b->nb_lettres + lb;
+					for( t=b->debut[k]; t<b->debut[k+1]; t++ ){
+						int f = b->fins[t];
+						if( marque[f] != tampon ){
+							marque[f] = tampon;
+							successeurs[nb_successeurs++] = f;
+						}
+					}
+				}
+				qsort(
+					successeurs, nb_successeurs, sizeof(int), comparer_entiers
+				);
+			}
+			int accepte_b = intersecte_finaux( b, successeurs, nb_successeurs );
+
+			int k = ac.noeuds[courant].etat * a->nb_lettres + l;
+			for( t=a->debut[k]; t<a->debut[k+1]; t++ ){
+				int p = a->fins[t];
+				int n = ajouter_antichaine(
+					&ac, p, successeurs, nb_successeurs, courant, lettre
+				);
+				if( n != -1 && a->finaux[p] && ! accepte_b ){
+					mauvais = n;
+					break;
+				}
+			}
+		}
+	}
+
+	if( contre_exemple ){
+		*contre_exemple = ( mauvais == -1 ) ? NULL : reconstruire_mot(
+			ac.parents, ac.lettres, mauvais
+		);
+	}
+
+	xfree( successeurs );
+	xfree( marque );
+	xfree( ac.noeuds );
+	xfree( ac.parents );
+	xfree( ac.lettres );
+	xfree( ac.valeurs );
+	xfree( ac.tetes );
+	liberer_automate_indexe( a );
+	liberer_automate_indexe( b );
+	return mauvais == -1;
+}
+
+int sont_equivalents(
+	const Automate * automate_1, const Automate * automate_2,
+	char ** contre_exemple
+){
+	return est_inclus( automate_1, automate_2, contre_exemple )
+		&& est_inclus( automate_2, automate_1, contre_exemple );
+}
+
+/*
+ * État atteint après une lettre qui n'appartient pas à l'alphabet d'un
+ * automate compilé : le mot ne peut plus être reconnu, même si le puits est
+ * final.
+ */
+#define ETAT_REJET (-2)
+
+/*
+ * Les couples (p, q) visités par parcourir_produit(), numérotés dans l'ordre
+ * où ils sont découverts : les numéros servent aussi de file au parcours en
+ * largeur. La clé d'un couple est (p+2)*largeur + (q+2), de sorte que
+ * ETAT_PUITS et ETAT_REJET aient aussi une clé. Une table de hachage à 
+ * adressage ouvert associe sa clé au numéro d'un couple : seuls les couples
+ * accessibles occupent de la mémoire.
+ */
+typedef struct {
+	int nb_couples;
+	int capacite_couples;
+	int64_t * couples; //!< Clé de chaque couple.
+	int * parents;
+	char * lettres;
+	int capacite_table; //!< Une puissance de 2.
+	int64_t * cles;
+	int * numeros;
+} Couples_visites;
+
+/*
+ * Renvoie la case de la table où se trouve la clé, ou bien la case vide où
+ * elle doit être ajoutée.
+ */
+static int case_couple( const Couples_visites * v, int64_t cle ){
+	int masque = v->capacite_table - 1;
+	int i = (int) ( empreinte_element( (intptr_t) cle ) & masque );
+	while( v->cles[i] != -1 && v->cles[i] != cle ){
+		i = ( i + 1 ) & masque;
+	}
+	return i;
+}
+
+static void allouer_table_couples( Couples_visites * v, int capacite ){
+	int i;
+	v->capacite_table = capacite;
+	v->cles = xmalloc( sizeof(int64_t) * capacite );
+	v->numeros = xmalloc( sizeof(int) * capacite );
+	for( i=0; i<capacite; i++ ){
+		v->cles[i] = -1;
+	}
+}
+
+static void agrandir_table_couples( Couples_visites * v ){
+	int64_t * cles = v->cles;
+	int * numeros = v->numeros;
+	int capacite = v->capacite_table;
+	int i;
+
+	allouer_table_couples( v, 2 * capacite );
+	for( i=0; i<capacite; i++ ){
+		if( cles[i] != -1 ){
+			int j = case_couple( v, cles[i] );
+			v->cles[j] = cles[i];
+			v->numeros[j] = numeros[i];
+		}
+	}
+	xfree( cles );
+	xfree( numeros );
+}
+
+/*
+ * Ajoute le couple de clé 'cle' s'il n'a pas encore été visité. Renvoie son
+ * numéro, ou -1 s'il était déjà visité.
+ */
+static int visiter_couple(
+	Couples_visites * v, int64_t cle, int parent, char lettre
+){
+	int i = case_couple( v, cle );
+	if( v->cles[i] != -1 ){
+		return -1;
+	}
+	if( 2 * ( v->nb_couples + 1 ) > v->capacite_table ){
+		agrandir_table_couples( v );
+		i = case_couple( v, cle );
+	}
+	if( v->nb_couples == v->capacite_couples ){
+		v->capacite_couples *= 2;
+		v->couples = xrealloc(
+			v->couples, sizeof(int64_t) * v->capacite_couples
+		);
+		v->parents = xrealloc( v->parents, sizeof(int) * v->capacite_couples );
+		v->lettres = xrealloc( v->lettres, v->capacite_couples );
+	}
+	int n = v->nb_couples++;
+	v->cles[i] = cle;
+	v->numeros[i] = n;
+	v->couples[n] = cle;
+	v->parents[n] = parent;
+	v->lettres[n] = lettre;
+	return n;
+}
+
+/*
+ * Parcours en largeur de l'automate produit de deux automates compilés.
+ * Renvoie le plus court mot reconnu par le premier automate et pas par le
+ * second ou, si 'symetrique' vaut 1, reconnu par un seul des deux automates.
+ * Renvoie NULL s'il n'existe pas de tel mot.
+ */
+static char * parcourir_produit(
+	const Automate_compile * automate_1, const Automate_compile * automate_2,
+	int symetrique
+){
+	const Automate_compile * automates[2] = { automate_1, automate_2 };
+	int64_t largeur = (int64_t) automate_2->nb_etats + 2;
+	Couples_visites v;
+	int courant;
+	int mauvais = -1;
+	int l;
+
+	v.nb_couples = 0;
+	v.capacite_couples = 64;
+	v.couples = xmalloc( sizeof(int64_t) * v.capacite_couples );
+	v.parents = xmalloc( sizeof(int) * v.capacite_couples );
+	v.lettres = xmalloc( v.capacite_couples );
+	allouer_table_couples( &v, 128 );
+	visiter_couple(
+		&v, ( automate_1->initial + 2 ) * largeur + automate_2->initial + 2,
+		-1, '\0'
+	);
+	for( courant=0; courant<v.nb_couples; courant++ ){
+		int p = (int) ( v.couples[courant] / largeur ) - 2;
+		int q = (int) ( v.couples[courant] % largeur ) - 2;
+		int final_p = ( p != ETAT_REJET ) && est_final_compile( automate_1, p );
+		int final_q = ( q != ETAT_REJET ) && est_final_compile( automate_2, q );
+		if( ( final_p && ! final_q ) || ( symetrique && final_q && ! final_p ) ){
+			mauvais = courant;
+			break;
+		}
+		if(
+			( p == ETAT_REJET || ( p == ETAT_PUITS && ! automate_1->puits_final ) )
+			&& ( ! symetrique || q == ETAT_REJET ||
+				( q == ETAT_PUITS && ! automate_2->puits_final ) )
+		){
+			continue;
+		}
+		// On lit les lettres du premier automate, puis, pour la différence
+		// symétrique, celles qui n'appartiennent qu'au second.
+		int a;
+		for( a=0; a<=symetrique; a++ ){
+			const Automate_compile * lecteur = automates[a];
+			for( l=0; l<lecteur->nb_lettres; l++ ){
+				char lettre = lecteur->lettres[l];
+				if(
+					a == 1 &&
+					automate_1->indice_lettre[(unsigned char) lettre] != -1
+				){
+					continue;
+				}
+				int p2 = ETAT_REJET;
+				int q2 = ETAT_REJET;
+				if(
+					p != ETAT_REJET &&
+					automate_1->indice_lettre[(unsigned char) lettre] != -1
+				){
+					p2 = delta_compile( automate_1, p, lettre );
+				}
+				if(
+					q != ETAT_REJET &&
+					automate_2->indice_lettre[(unsigned char) lettre] != -1
+				){
+					q2 = delta_compile( automate_2, q, lettre );
+				}
+				visiter_couple(
+					&v, ( p2 + 2 ) * largeur + q2 + 2, courant, lettre
+				);
+			}
+		}
+	}
+
+	char * mot = ( mauvais == -1 ) ? NULL : reconstruire_mot(
+		v.parents, v.lettres, mauvais
+	);
+	xfree( v.couples );
+	xfree( v.parents );
+	xfree( v.lettres );
+	xfree( v.cles );
+	xfree( v.numeros );
+	return mot;
+}
+
+int est_inclus_compile(
+	const Automate_compile * automate_1, const Automate_compile * automate_2,
+	char ** contre_exemple
+){
+	char * mot = parcourir_produit( automate_1, automate_2, 0 );
+	int inclus = ( mot == NULL );
+	if( contre_exemple ){
+		*contre_exemple = mot;
+	}else{
+		xfree( mot );
+	}
+	return inclus;
+}
+
+char * mot_distinguant( const Automate * automate_1, const Automate * automate_2 ){
+	Automate_compile * dfa_1 = compiler_automate( automate_1 );
+	Automate_compile * dfa_2 = compiler_automate( automate_2 );
+	char * mot = parcourir_produit( dfa_1, dfa_2, 1 );
+	liberer_automate_compile( dfa_1 );
+	liberer_automate_compile( dfa_2 );
+	return mot;
+}
+
+/*
+ * Une entrée de la file de priorité de mots_les_plus_courts() : un chemin
+ * de longueur 'longueur' depuis l'état initial jusqu'à 'etat', rangé dans
+ * l'arène des chemins sous le numéro 'noeud'.
+ */
+typedef struct {
+	int priorite; //!< longueur + distance de 'etat' à un état final.
+	int ordre; //!< Numéro d'insertion, pour départager les égalités.
+	int longueur;
+	int etat;
+	int noeud;
+} Entree_tas;
+
+/*
+ * État virtuel atteint depuis chaque état final par une transition vide :
+ * les chemins vers cet état sont exactement les mots reconnus.
+ */
+#define ETAT_CIBLE (-2)
+
+typedef struct {
+	Entree_tas * entrees;
+	int taille;
+	int capacite;
+} Tas;
+
+static int est_avant( const Entree_tas * a, const Entree_tas * b ){
+	if( a->priorite != b->priorite ){
+		return a->priorite < b->priorite;
+	}
+	return a->ordre < b->ordre;
+}
+
+static void ajouter_tas( Tas * tas, Entree_tas entree ){
+	if( tas->taille == tas->capacite ){
+		tas->capacite *= 2;
+		tas->entrees = xrealloc(
+			tas->entrees, sizeof(Entree_tas) * tas->capacite
+		);
+	}
+	int i = tas->taille++;
+	while( i > 0 && est_avant( &entree, &tas->entrees[(i-1)/2] ) ){
+		tas->entrees[i] = tas->entrees[(i-1)/2];
+		i = (i-1)/2;
+	}
+	tas->entrees[i] = entree;
+}
+
+static Entree_tas retirer_tas( Tas * tas ){
+	Entree_tas res = tas->entrees[0];
+	Entree_tas dernier = tas->entrees[--tas->taille];
+	int i = 0;
+	for(;;){
+		int fils = 2*i + 1;
+		if( fils >= tas->taille ){
+			break;
+		}
+		if(
+			fils + 1 < tas->taille &&
+			est_avant( &tas->entrees[fils+1], &tas->entrees[fils] )
+		){
+			fils++;
+		}
+		if( ! est_avant( &tas->entrees[fils], &dernier ) ){
+			break;
+		}
+		tas->entrees[i] = tas->entrees[fils];
+		i = fils;
+	}
+	tas->entrees[i] = dernier;
+	return res;
+}
+
+/*
+ * Calcule, pour chaque état d'un automate compilé, la longueur du plus court
+ * mot menant à un état final (-1 si aucun état final n'est accessible).
+ */
+static int * distances_aux_finaux( const Automate_compile * automate ){
+	int n = automate->nb_etats;
+	int L = automate->nb_lettres;
+	int * distances = xmalloc( sizeof(int) * ( n + 1 ) );
+	int * debut = xmalloc( sizeof(int) * ( n + 2 ) );
+	int * origines = xmalloc( sizeof(int) * ( n * L + 1 ) );
+	int * file = xmalloc( sizeof(int) * ( n + 1 ) );
+	int debut_file = 0, fin_file = 0;
+	int e, l, t;
+
+	// Les transitions inversées, au format CSR
+	memset( debut, 0, sizeof(int) * ( n + 2 ) );
+	for( e=0; e<n*L; e++ ){
+		if( automate->transitions[e] != ETAT_PUITS ){
+			debut[ automate->transitions[e] + 2 ]++;
+		}
+	}
+	for( e=0; e<n; e++ ){
+		debut[e+2] += debut[e+1];
+	}
+	for( e=0; e<n; e++ ){
+		for( l=0; l<L; l++ ){
+			int fin = automate->transitions[e*L + l];
+			if( fin != ETAT_PUITS ){
+				origines[ debut[fin+1]++ ] = e;
+			}
+		}
+	}
+
+	for( e=0; e<n; e++ ){
+		distances[e] = -1;
+		if( automate->finaux[e] ){
+			distances[e] = 0;
+			file[fin_file++] = e;
+		}
+	}
+	while( debut_file < fin_file ){
+		e = file[debut_file++];
+		for( t=debut[e]; t<debut[e+1]; t++ ){
+			int origine = origines[t];
+			if( distances[origine] == -1 ){
+				distances[origine] = distances[e] + 1;
+				file[fin_file++] = origine;
+			}
+		}
+	}
+	xfree( debut );
+	xfree( origines );
+	xfree( file );
+	return distances;
+}
+
+char ** mots_les_plus_courts( const Automate * automate, int k, int * nb_mots ){
+	if( k <= 0 ){
+		*nb_mots = 0;
+		return xmalloc( sizeof(char *) );
+	}
+	Automate_compile * dfa = compiler_automate( automate );
+	int * distances = distances_aux_finaux( dfa );
+	int * nb_sorties = xmalloc( sizeof(int) * ( dfa->nb_etats + 1 ) );
+	char ** mots = xmalloc( sizeof(char *) * ( k + 1 ) );
+	int L = dfa->nb_lettres;
+	int ordre = 0;
+	int l;
+
+	memset( nb_sorties, 0, sizeof(int) * ( dfa->nb_etats + 1 ) );
+	*nb_mots = 0;
+
+	// L'arène des chemins : chaque chemin est son dernier état et son père
+	int capacite_noeuds = 64;
+	int nb_noeuds = 0;
+	int * parents = xmalloc( sizeof(int) * capacite_noeuds );
+	char * lettres = xmalloc( capacite_noeuds );
+
+	Tas tas;
+	tas.taille = 0;
+	tas.capacite = 64;
+	tas.entrees = xmalloc( sizeof(Entree_tas) * tas.capacite );
+
+	if( dfa->initial != ETAT_PUITS && distances[dfa->initial] != -1 ){
+		parents[nb_noeuds++] = -1;
+		Entree_tas entree = {
+			distances[dfa->initial], ordre++, 0, dfa->initial, 0
+		};
+		ajouter_tas( &tas, entree );
+	}
+
+	// Recherche A* des k plus courts chemins vers ETAT_CIBLE : un état n'est
+	// développé qu'au plus k fois, ce qui borne la taille du tas.
+	while( tas.taille > 0 && *nb_mots < k ){
+		Entree_tas entree = retirer_tas( &tas );
+		if( entree.etat == ETAT_CIBLE ){
+			mots[(*nb_mots)++] = reconstruire_mot( parents, lettres, entree.noeud );
+			continue;
+		}
+		if( nb_sorties[entree.etat] >= k ){
+			continue;
+		}
+		nb_sorties[entree.etat]++;
+		if( dfa->finaux[entree.etat] ){
+			Entree_tas cible = {
+				entree.longueur, ordre++, entree.longueur, ETAT_CIBLE,
+				entree.noeud
+			};
+			ajouter_tas( &tas, cible );
+		}
+		for( l=0; l<L; l++ ){
+			int fin = dfa->transitions[ entree.etat * L + l ];
+			if(
+				fin == ETAT_PUITS || distances[fin] == -1 ||
+				nb_sorties[fin] >= k
+			){
+				continue;
+			}
+			if( nb_noeuds == capacite_noeuds ){
+				capacite_noeuds *= 2;
+				parents = xrealloc( parents, sizeof(int) * capacite_noeuds );
+				lettres = xrealloc( lettres, capacite_noeuds );
+			}
+			parents[nb_noeuds] = entree.noeud;
+			lettres[nb_noeuds] = dfa->lettres[l];
+			Entree_tas suivante = {
+				entree.longueur + 1 + distances[fin], ordre++,
+				entree.longueur + 1, fin, nb_noeuds
+			};
+			nb_noeuds++;
+			ajouter_tas( &tas, suivante );
+		}
+	}
+
+	xfree( tas.entrees );
+	xfree( parents );
+	xfree( lettres );
+	xfree( nb_sorties );
+	xfree( distances );
+	liberer_automate_compile( dfa );
+	return mots;
+}
@@ -0,0 +1,159 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2014, 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file langage.h */
+
+#ifndef __LANGAGE_H__
+#define __LANGAGE_H__
+
+#include "automate.h"
+#include "automate_compile.h"
+
+#pragma GCC visibility push(default)
+
+/**
+ * @brief Renvoie le plus court mot reconnu par l'automate, ou NULL si
+ *        l'automate ne reconnaît aucun mot.
+ *
+ * Le mot est obtenu par un parcours en largeur depuis les états initiaux, en
+ * temps linéaire en le nombre d'états et de transitions de l'automate.
+ * La mémoire du mot renvoyé est laissée à la charge de l'utilisateur, qui
+ * devra la libérer avec xfree().
+ *
+ * @param automate Un automate.
+ * @return Le plus court mot reconnu, ou NULL.
+ */
+char * mot_le_plus_court( const Automate * automate );
+
+/**
+ * @brief Renvoie les k plus courts mots reconnus par l'automate.
+ *
+ * Les mots sont renvoyés par longueur croissante. S'il y a moins de k mots
+ * reconnus, ils sont tous renvoyés. L'automate est d'abord compilé (et donc
+ * déterminisé), afin que deux chemins distincts donnent deux mots distincts.
+ * La recherche utilise une file de priorité dans laquelle chaque état n'est
+ * développé qu'au plus k fois. Si k est négatif ou nul, le tableau renvoyé
+ * est vide.
+ *
+ * Le tableau renvoyé et chacun des mots qu'il contient sont à libérer avec
+ * xfree().
+ *
+ * @param automate Un automate.
+ * @param k Le nombre de mots voulus.
+ * @param nb_mots Un pointeur qui recevra le nombre de mots renvoyés.
+ * @return Le tableau des mots.
+ */
+char ** mots_les_plus_courts( const Automate * automate, int k, int * nb_mots );
+
+/**
+ * @brief Renvoie le plus court mot reconnu par un seul des deux automates,
+ *        ou NULL si les deux automates sont équivalents.
+ *
+ * Les deux automates sont compilés, puis leur produit est parcouru en
+ * largeur. Le mot renvoyé est à libérer avec xfree().
+ *
+ * @param automate_1 Le premier automate.
+ * @param automate_2 Le second automate.
+ * @return Le plus court mot qui distingue les deux automates, ou NULL.
+ */
+char * mot_distinguant( const Automate * automate_1, const Automate * automate_2 );
+
+/**
+ * @brief Renvoie 1 si l'automate ne reconnaît aucun mot et 0 sinon.
+ *
+ * Si le langage n'est pas vide et si 'mot' est différent de NULL, alors *mot
+ * reçoit le plus court mot reconnu par l'automate (voir mot_le_plus_court()).
+ * La mémoire de ce mot est laissée à la charge de l'utilisateur, qui devra la
+ * libérer avec xfree().
+ * Sinon, *mot reçoit NULL.
+ *
+ * @param automate Un automate.
+ * @param mot Un pointeur qui recevra un mot reconnu, ou NULL.
+ * @return 1 ou 0.
+ */
+int est_vide_langage( const Automate * automate, char ** mot );
+
+/**
+ * @brief Renvoie 1 si le langage du premier automate est inclus dans celui du
+ *        second, et 0 sinon.
+ *
+ * Les automates peuvent être non déterministes : l'inclusion est testée
+ * sans déterminiser le second automate, par un parcours en largeur des
+ * couples (état du premier automate, ensemble d'états du second) dans lequel
+ * on ne conserve que les couples minimaux pour l'inclusion (antichaîne).
+ *
+ * Si l'inclusion est fausse et si 'contre_exemple' est différent de NULL,
+ * alors *contre_exemple reçoit un mot reconnu par le premier automate et pas
+ * par le second. Ce mot est à libérer avec xfree(). Sinon, *contre_exemple
+ * reçoit NULL.
+ *
+ * @param automate_1 Le premier automate.
+ * @param automate_2 Le second automate.
+ * @param contre_exemple Un pointeur qui recevra le contre-exemple, ou NULL.
+ * @return 1 ou 0.
+ */
+int est_inclus(
+	const Automate * automate_1, const Automate * automate_2,
+	char ** contre_exemple
+);
+
+/**
+ * @brief Renvoie 1 si les deux automates reconnaissent le même langage, et 0
+ *        sinon.
+ *
+ * Si les langages sont différents et si 'contre_exemple' est différent de
+ * NULL, alors *contre_exemple reçoit un mot reconnu par un seul des deux
+ * automates. Ce mot est à libérer avec xfree(). Sinon, *contre_exemple
+ * reçoit NULL.
+ *
+ * @param automate_1 Le premier automate.
+ * @param automate_2 Le second automate.
+ * @param contre_exemple Un pointeur qui recevra le contre-exemple, ou NULL.
+ * @return 1 ou 0.
+ */
+int sont_equivalents(
+	const Automate * automate_1, const Automate * automate_2,
+	char ** contre_exemple
+);
+
+/**
+ * @brief Renvoie 1 si le langage du premier automate compilé est inclus dans
+ *        celui du second, et 0 sinon.
+ *
+ * Le test se fait par un parcours en largeur de l'automate produit. Le
+ * contre-exemple éventuel est le plus court possible. Il est à libérer avec
+ * xfree().
+ *
+ * C'est l'algorithme naïf : appliqué à deux automates non déterministes
+ * après compiler_automate(), il nécessite de déterminiser les deux automates.
+ *
+ * @param automate_1 Le premier automate compilé.
+ * @param automate_2 Le second automate compilé.
+ * @param contre_exemple Un pointeur qui recevra le contre-exemple, ou NULL.
+ * @return 1 ou 0.
+ */
+int est_inclus_compile(
+	const Automate_compile * automate_1, const Automate_compile * automate_2,
+	char ** contre_exemple
+);
+
+#pragma GCC visibility pop
+
+#endif
@@ -20,8 +20,14 @@
 
 
 #include "outils.h"
+#include "statistiques.h"
 
 #include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#ifdef INSTRUMENTER_ALLOCATIONS
+#include <stdatomic.h>
+#endif
 
 int test( int result, int ligne ){
 	if( ! result ){
@@ -31,14 +37,262 @@ int test( int result, int ligne ){
 	return 0;
 }
 
-void* xmalloc( size_t n ){
-	void* result = malloc( n );
+static void* allouer_par_defaut( size_t n, void* data ){
+	return malloc( n );
+}
+
+static void* reallouer_par_defaut( void* ptr, size_t n, void* data ){
+	return realloc( ptr, n );
+}
+
+static void liberer_par_defaut( void* ptr, void* data ){
+	free( ptr );
+}
+
+static const Allocateur allocateur_par_defaut = {
+	allouer_par_defaut, reallouer_par_defaut, liberer_par_defaut, NULL
+};
+
+static Allocateur allocateur = {
+	allouer_par_defaut, reallouer_par_defaut, liberer_par_defaut, NULL
+};
+
+void definir_allocateur( const Allocateur* nouvel_allocateur ){
+	allocateur = nouvel_allocateur ? *nouvel_allocateur : allocateur_par_defaut;
+}
+
+static const char* noms_etiquettes[NB_ETIQUETTES] = {
+	"autre", "table", "ensemble", "automate", "fifo"
+};
+
+const char* nom_etiquette_allocation( Etiquette_allocation etiquette ){
+	if( etiquette < 0 || etiquette >= NB_ETIQUETTES ){
+		return "?";
+	}
+	return noms_etiquettes[etiquette];
+}
+
+#ifdef INSTRUMENTER_ALLOCATIONS
+
+/*
+ * L'en-tête occupe sizeof(max_align_t) octets, pour que le bloc rendu à
+ * l'utilisateur reste correctement aligné.
+ */
+typedef union Entete_allocation {
+	struct {
+		size_t taille;
+		Etiquette_allocation etiquette;
+	} info;
+	max_align_t alignement;
+} Entete_allocation;
+
+static atomic_size_t octets_vivants;
+static atomic_size_t pic_octets;
+static atomic_ulong nb_allocations;
+static atomic_ulong nb_reallocations;
+static atomic_ulong nb_liberations;
+static atomic_ulong histogramme[NB_CLASSES_ALLOCATIONS];
+static atomic_size_t octets_vivants_par_etiquette[NB_ETIQUETTES];
+static atomic_ulong nb_allocations_par_etiquette[NB_ETIQUETTES];
+
+static int classe_allocation( size_t n ){
+	int classe = 0;
+	while( n > 1 && classe < NB_CLASSES_ALLOCATIONS - 1 ){
+		n >>= 1;
+		classe++;
+	}
+	return classe;
+}
+
+static void compter_octets( Etiquette_allocation etiquette, size_t n ){
+	size_t vivants = atomic_fetch_add_explicit(
+		&octets_vivants, n, memory_order_relaxed
+	) + n;
+	atomic_fetch_add_explicit(
+		&octets_vivants_par_etiquette[etiquette], n, memory_order_relaxed
+	);
+	size_t pic = atomic_load_explicit( &pic_octets, memory_order_relaxed );
+	while( pic < vivants && ! atomic_compare_exchange_weak_explicit(
+		&pic_octets, &pic, vivants,
+		memory_order_relaxed, memory_order_relaxed
+	) );
+}
+
+static void decompter_octets( Etiquette_allocation etiquette, size_t n ){
+	atomic_fetch_sub_explicit( &octets_vivants, n, memory_order_relaxed );
+	atomic_fetch_sub_explicit(
+		&octets_vivants_par_etiquette[etiquette], n, memory_order_relaxed
+	);
+}
+
+static void compter_demande( size_t n ){
+	atomic_fetch_add_explicit(
+		&histogramme[ classe_allocation( n ) ], 1, memory_order_relaxed
+	);
+}
+
+void* xmalloc_etiquete( size_t n, Etiquette_allocation etiquette ){
+	COMPTER_OPERATION( allocations, 1 );
+	Entete_allocation* entete = allocateur.allouer(
+		sizeof( Entete_allocation ) + n, allocateur.data
+	);
+	if( ! entete ){
+		ERREUR( "Espace insuffisant" );
+	}
+	entete->info.taille = n;
+	entete->info.etiquette = etiquette;
+	atomic_fetch_add_explicit( &nb_allocations, 1, memory_order_relaxed );
+	atomic_fetch_add_explicit(
+		&nb_allocations_par_etiquette[etiquette], 1, memory_order_relaxed
+	);
+	compter_demande( n );
+	compter_octets( etiquette, n );
+	return entete + 1;
+}
+
+void* xrealloc_etiquete(
+	void* ptr, size_t n, Etiquette_allocation etiquette
+){
+	if( ! ptr ){
+		return xmalloc_etiquete( n, etiquette );
+	}
+	COMPTER_OPERATION( allocations, 1 );
+	if( ! n ){
+		xfree( ptr );
+		return NULL;
+	}
+	Entete_allocation* entete = (Entete_allocation*) ptr - 1;
+	size_t ancienne_taille = entete->info.taille;
+	etiquette = entete->info.etiquette;
+	entete = allocateur.reallouer(
+		entete, sizeof( Entete_allocation ) + n, allocateur.data
+	);
+	if( ! entete ){
+		ERREUR( "Espace insuffisant" );
+	}
+	entete->info.taille = n;
+	atomic_fetch_add_explicit( &nb_reallocations, 1, memory_order_relaxed );
+	compter_demande( n );
+	if( n > ancienne_taille ){
+		compter_octets( etiquette, n - ancienne_taille );
+	}else{
+		decompter_octets( etiquette, ancienne_taille - n );
+	}
+	return entete + 1;
+}
+
+void* (xmalloc)( size_t n ){
+	return xmalloc_etiquete( n, ETIQUETTE_AUTRE );
+}
+
+void* (xrealloc)( void* ptr, size_t n ){
+	return xrealloc_etiquete( ptr, n, ETIQUETTE_AUTRE );
+}
+
+void xfree( void* ptr ){
+	if( ! ptr ){
+		return;
+	}
+	Entete_allocation* entete = (Entete_allocation*) ptr - 1;
+	atomic_fetch_add_explicit( &nb_liberations, 1, memory_order_relaxed );
+	decompter_octets( entete->info.etiquette, entete->info.taille );
+	allocateur.liberer( entete, allocateur.data );
+}
+
+int lire_statistiques_allocations( Statistiques_allocations* statistiques ){
+	statistiques->octets_vivants = atomic_load( &octets_vivants );
+	statistiques->pic_octets = atomic_load( &pic_octets );
+	statistiques->nb_allocations = atomic_load( &nb_allocations );
+	statistiques->nb_reallocations = atomic_load( &nb_reallocations );
+	statistiques->nb_liberations = atomic_load( &nb_liberations );
+	for( int i = 0; i < NB_CLASSES_ALLOCATIONS; i++ ){
+		statistiques->histogramme[i] = atomic_load( &histogramme[i] );
+	}
+	for( int i = 0; i < NB_ETIQUETTES; i++ ){
+		statistiques->octets_vivants_par_etiquette[i] =
+			atomic_load( &octets_vivants_par_etiquette[i] );
+		statistiques->nb_allocations_par_etiquette[i] =
+			atomic_load( &nb_allocations_par_etiquette[i] );
+	}
+	return 1;
+}
+
+void reinitialiser_pic_allocations( void ){
+	atomic_store( &pic_octets, atomic_load( &octets_vivants ) );
+}
+
+#else
+
+void* xmalloc_etiquete( size_t n, Etiquette_allocation etiquette ){
+	COMPTER_OPERATION( allocations, 1 );
+	void* result = allocateur.allouer( n, allocateur.data );
 	if( ! result ){
 		ERREUR( "Espace insuffisant" );
 	}
 	return result;
 }
 
+void* xrealloc_etiquete(
+	void* ptr, size_t n, Etiquette_allocation etiquette
+){
+	COMPTER_OPERATION( allocations, 1 );
+	void* result = allocateur.reallouer( ptr, n, allocateur.data );
+	if( ! result && n ){
+		ERREUR( "Espace insuffisant" );
+	}
+	return result;
+}
+
+void* xmalloc( size_t n ){
+	return xmalloc_etiquete( n, ETIQUETTE_AUTRE );
+}
+
+void* xrealloc( void* ptr, size_t n ){
+	return xrealloc_etiquete( ptr, n, ETIQUETTE_AUTRE );
+}
+
 void xfree( void* ptr ){
-	free(ptr);
+	if( ptr ){
+		allocateur.liberer( ptr, allocateur.data );
+	}
+}
+
+int lire_statistiques_allocations( Statistiques_allocations* statistiques ){
+	memset( statistiques, 0, sizeof( Statistiques_allocations ) );
+	return 0;
+}
+
+void reinitialiser_pic_allocations( void ){
+}
+
+#endif
+
+void ecrire_statistiques_allocations( FILE* fichier ){
+	Statistiques_allocations s;
+	if( ! lire_statistiques_allocations( &s ) ){
+		fprintf( fichier, "allocations non instrumentées\n" );
+		return;
+	}
+	fprintf(
+		fichier, "octets vivants : %zu, pic : %zu\n",
+		s.octets_vivants, s.pic_octets
+	);
+	fprintf(
+		fichier, "allocations : %lu, réallocations : %lu, libérations : %lu\n",
+		s.nb_allocations, s.nb_reallocations, s.nb_liberations
+	);
+	for( int i = 0; i < NB_ETIQUETTES; i++ ){
+		fprintf(
+			fichier, "  %-10s %12zu octets vivants, %10lu allocations\n",
+			nom_etiquette_allocation( i ), s.octets_vivants_par_etiquette[i],
+			s.nb_allocations_par_etiquette[i]
+		);
+	}
+	for( int i = 0; i < NB_CLASSES_ALLOCATIONS; i++ ){
+		if( s.histogramme[i] ){
+			fprintf(
+				fichier, "  [2^%d, 2^%d[ : %lu\n", i, i+1, s.histogramme[i]
+			);
+		}
+	}
 }
@@ -25,13 +25,101 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#pragma GCC visibility push(default)
+
 #define DEBUG(x) do { fprintf(stderr,"DEBUG : %s - ligne : %d, fichier : %s\n", (x), __LINE__, __FILE__ ); } while(0)
 #define DEBUGO(x) do { fprintf(stdout,"DEBUG : %s - ligne : %d, fichier : %s\n", (x), __LINE__, __FILE__ ); } while(0)
 #define ERREUR(x) do { fprintf(stderr,"ERREUR : %s - ligne : %d, fichier : %s\n", (x), __LINE__, __FILE__ ); exit(EXIT_FAILURE); } while(0)
 
+/*
+ * Allocateur utilisé par xmalloc(), xrealloc() et xfree().
+ *
+ * Par défaut, ce sont malloc(), realloc() et free(). definir_allocateur()
+ * permet d'en brancher un autre (par exemple une arène de jemalloc) ; il doit
+ * être appelé avant toute allocation, car un bloc doit être libéré par
+ * l'allocateur qui l'a alloué. Passer NULL rétablit l'allocateur par défaut.
+ * Le champ data est transmis tel quel aux trois fonctions.
+ */
+typedef struct Allocateur {
+	void* (*allouer)( size_t n, void* data );
+	void* (*reallouer)( void* ptr, size_t n, void* data );
+	void (*liberer)( void* ptr, void* data );
+	void* data;
+} Allocateur;
+
+void definir_allocateur( const Allocateur* allocateur );
+
+/*
+ * Étiquettes des sous-systèmes, pour la comptabilité des allocations.
+ *
+ * Un fichier source choisit son étiquette en définissant
+ * ETIQUETTE_ALLOCATIONS avant tout #include ; sinon, ses allocations sont
+ * comptées dans ETIQUETTE_AUTRE. Les noeuds des arbres AVL sont comptés
+ * avec ETIQUETTE_TABLE.
+ */
+typedef enum Etiquette_allocation {
+	ETIQUETTE_AUTRE,
+	ETIQUETTE_TABLE,
+	ETIQUETTE_ENSEMBLE,
+	ETIQUETTE_AUTOMATE,
+	ETIQUETTE_FIFO,
+	NB_ETIQUETTES
+} Etiquette_allocation;
+
 void* xmalloc( size_t n );
+void* xrealloc( void* ptr, size_t n );
 void xfree( void* ptr );
 
+void* xmalloc_etiquete( size_t n, Etiquette_allocation etiquette );
+void* xrealloc_etiquete(
+	void* ptr, size_t n, Etiquette_allocation etiquette
+);
+
+/*
+ * Comptabilité des allocations.
+ *
+ * Elle n'est compilée que si INSTRUMENTER_ALLOCATIONS est défini, par exemple
+ * avec : make clean && make OPTIONS=-DINSTRUMENTER_ALLOCATIONS check
+ * Chaque bloc est alors précédé d'un en-tête qui retient sa taille et son
+ * étiquette, et les compteurs sont mis à jour de façon atomique.
+ *
+ * La classe i de l'histogramme compte les demandes de taille comprise entre
+ * 2^i et 2^(i+1)-1 (la classe 0 compte aussi les demandes de taille nulle,
+ * la dernière classe toutes les demandes plus grandes).
+ */
+#define NB_CLASSES_ALLOCATIONS 32
+
+typedef struct Statistiques_allocations {
+	size_t octets_vivants;
+	size_t pic_octets;
+	unsigned long nb_allocations;
+	unsigned long nb_reallocations;
+	unsigned long nb_liberations;
+	unsigned long histogramme[NB_CLASSES_ALLOCATIONS];
+	size_t octets_vivants_par_etiquette[NB_ETIQUETTES];
+	unsigned long nb_allocations_par_etiquette[NB_ETIQUETTES];
+} Statistiques_allocations;
+
+/*
+ * Remplit *statistiques et renvoie 1 si la comptabilité est compilée ;
+ * sinon, remplit *statistiques de zéros et renvoie 0.
+ */
+int lire_statistiques_allocations( Statistiques_allocations* statistiques );
+
+/* Ramène le pic au nombre d'octets vivants. */
+void reinitialiser_pic_allocations( void );
+
+const char* nom_etiquette_allocation( Etiquette_allocation etiquette );
+void ecrire_statistiques_allocations( FILE* fichier );
+
+#ifdef INSTRUMENTER_ALLOCATIONS
+#ifndef ETIQUETTE_ALLOCATIONS
+#define ETIQUETTE_ALLOCATIONS ETIQUETTE_AUTRE
+#endif
+#define xmalloc( n ) xmalloc_etiquete( (n), ETIQUETTE_ALLOCATIONS )
+#define xrealloc( ptr, n ) xrealloc_etiquete( (ptr), (n), ETIQUETTE_ALLOCATIONS )
+#endif
+
 #define TEST(y,x) do { x &= (y); if(!(y)){ fprintf(stdout, "\033[31mEchec du test %s() -- ligne : %d, fichier : %s\033[0m\n", __FUNCTION__, __LINE__, __FILE__ ); } } while(0)
 #define TEST1(x) test( x, __LINE__)
 
@@ -40,5 +128,7 @@ void xfree( void* ptr );
 
 int test( int result, int ligne );
 
+#pragma GCC visibility pop
+
 #endif
 
@@ -0,0 +1,537 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2014, 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "parallele.h"
+#include "outils.h"
+#include "statistiques.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Nombre d'états de la frontière pris d'un coup par un fil, et taille des
+ * frontières locales.
+ */
+#define TAILLE_BLOC 64
+#define TAILLE_FRONTIERE_LOCALE 1024
+
+/*
+ * Un fil de travail exécute 'travail' et relève ses compteurs d'opérations,
+ * qui sont tenus par fil.
+ */
+typedef struct Fil_de_travail {
+	void * (* travail )( void * data );
+	void * data;
+	Statistiques_operation compteurs;
+} Fil_de_travail;
+
+static void * executer_fil_de_travail( void * data ){
+	Fil_de_travail * fil = (Fil_de_travail *) data;
+	Statistiques_operation depart = compteurs_operations;
+	fil->travail( fil->data );
+	fil->compteurs = compteurs_depuis( &depart );
+	return NULL;
+}
+
+void executer_en_parallele(
+	void * (* travail )( void * data ), void * data, int nb_fils
+){
+	Fil_de_travail * fils = xmalloc( sizeof(Fil_de_travail) * nb_fils );
+	pthread_t * identifiants = xmalloc( sizeof(pthread_t) * nb_fils );
+	int i;
+	for( i=1; i<nb_fils; i++ ){
+		fils[i].travail = travail;
+		fils[i].data = data;
+		if( pthread_create(
+			&identifiants[i], NULL, executer_fil_de_travail, &fils[i]
+		) ){
+			ERREUR( "Impossible de créer un fil d'exécution" );
+		}
+	}
+	travail( data );
+	for( i=1; i<nb_fils; i++ ){
+		pthread_join( identifiants[i], NULL );
+		ajouter_compteurs_operations( &fils[i].compteurs );
+	}
+	xfree( identifiants );
+	xfree( fils );
+}
+
+typedef struct Parcours_parallele {
+	const Automate_indexe * automate;
+	_Atomic uint64_t * visites;
+	int * courante;
+	int * suivante;
+	int taille_courante;
+	atomic_int taille_suivante;
+	atomic_int prochain; //!< Prochain bloc de la frontière courante.
+	pthread_barrier_t barriere;
+} Parcours_parallele;
+
+/*
+ * Renvoie 1 si l'état n'était pas encore visité, en le marquant.
+ */
+static int visiter( _Atomic uint64_t * visites, int etat ){
+	uint64_t bit = (uint64_t) 1 << ( etat & 63 );
+	_Atomic uint64_t * mot = &visites[ etat >> 6 ];
+	if( atomic_load_explicit( mot, memory_order_relaxed ) & bit ){
+		return 0;
+	}
+	return ! ( atomic_fetch_or_explicit( mot, bit, memory_order_relaxed ) & bit );
+}
+
+static void verser_frontiere_locale(
+	Parcours_parallele * parcours, int * locale, int * taille
+){
+	if( *taille == 0 ){
+		return;
+	}
+	int position = atomic_fetch_add_explicit(
+		&parcours->taille_suivante, *taille, memory_order_relaxed
+	);
+	memcpy( parcours->suivante + position, locale, sizeof(int) * *taille );
+	*taille = 0;
+}
+
+static void * parcourir( void * data ){
+	Parcours_parallele * parcours = (Parcours_parallele *) data;
+	const Automate_indexe * automate = parcours->automate;
+	int L = automate->nb_lettres;
+	int locale[TAILLE_FRONTIERE_LOCALE];
+	int taille_locale = 0;
+
+	for( ;; ){
+		int debut;
+		while( ( debut = atomic_fetch_add_explicit(
+			&parcours->prochain, TAILLE_BLOC, memory_order_relaxed
+		) ) < parcours->taille_courante ){
+			int fin = debut + TAILLE_BLOC;
+			if( fin > parcours->taille_courante ){
+				fin = parcours->taille_courante;
+			}
+			COMPTER_OPERATION( etats_visites, fin - debut );
+			for( int i = debut; i < fin; i++ ){
+				int e = parcours->courante[i];
+				// Les cases de l'état e sont contiguës dans le CSR.
+				COMPTER_OPERATION(
+					transitions_parcourues,
+					automate->debut[(e+1)*L] - automate->debut[e*L]
+				);
+				for( int t = automate->debut[e*L]; t < automate->debut[(e+1)*L]; t++ ){
+					int f = automate->fins[t];
+					if( visiter( parcours->visites, f ) ){
+						if( taille_locale == TAILLE_FRONTIERE_LOCALE ){
+							verser_frontiere_locale( parcours, locale, &taille_locale );
+						}
+						locale[taille_locale++] = f;
+					}
+				}
+			}
+		}
+		verser_frontiere_locale( parcours, locale, &taille_locale );
+
+		// Fin du niveau : un seul fil échange les frontières, puis tous
+		// repartent sur la nouvelle.
+		if( pthread_barrier_wait( &parcours->barriere )
+			== PTHREAD_BARRIER_SERIAL_THREAD
+		){
+			int * tmp = parcours->courante;
+			parcours->courante = parcours->suivante;
+			parcours->suivante = tmp;
+			parcours->taille_courante = atomic_load( &parcours->taille_suivante );
+			atomic_store( &parcours->taille_suivante, 0 );
+			atomic_store( &parcours->prochain, 0 );
+		}
+		pthread_barrier_wait( &parcours->barriere );
+		if( parcours->taille_courante == 0 ){
+			return NULL;
+		}
+	}
+}
+
+void marquer_accessibles_indexe_parallele(
+	const Automate_indexe * automate, unsigned char * marques, int nb_fils
+){
+	int n = automate->nb_etats;
+	int nb_mots = n / 64 + 1;
+	int i;
+	if( nb_fils < 1 ){
+		nb_fils = 1;
+	}
+
+	Parcours_parallele parcours;
+	parcours.automate = automate;
+	parcours.visites = xmalloc( sizeof(_Atomic uint64_t) * nb_mots );
+	for( i=0; i<nb_mots; i++ ){
+		atomic_init( &parcours.visites[i], 0 );
+	}
+	// Chaque état entre au plus une fois dans une frontière.
+	parcours.courante = xmalloc( sizeof(int) * ( n + 1 ) );
+	parcours.suivante = xmalloc( sizeof(int) * ( n + 1 ) );
+	parcours.taille_courante = 0;
+	for( i=0; i<automate->nb_initiaux; i++ ){
+		int e = automate->initiaux[i];
+		if( visiter( parcours.visites, e ) ){
+			parcours.courante[ parcours.taille_courante++ ] = e;
+		}
+	}
+	atomic_init( &parcours.taille_suivante, 0 );
+	atomic_init( &parcours.prochain, 0 );
+	pthread_barrier_init( &parcours.barriere, NULL, nb_fils );
+	executer_en_parallele( parcourir, &parcours, nb_fils );
+
+	for( i=0; i<n; i++ ){
+		marques[i] = ( atomic_load_explicit(
+			&parcours.visites[ i >> 6 ], memory_order_relaxed
+		) >> ( i & 63 ) ) & 1;
+	}
+
+	pthread_barrier_destroy( &parcours.barriere );
+	xfree( parcours.visites );
+	xfree( parcours.courante );
+	xfree( parcours.suivante );
+}
+
+/*
+ * Construction parallèle des sous-ensembles.
+ *
+ * Un sous-ensemble est enregistré une seule fois dans une table partagée en
+ * NB_TRANCHES tranches, choisies par les bits de poids fort de son
+ * empreinte ; chaque tranche est une table à adressage ouvert protégée par
+ * un verrou. Un sous-ensemble enregistré pendant un niveau n'a pas encore de
+ * numéro : il le reçoit lors de la numérotation séquentielle de fin de
+ * niveau, au premier couple (état, lettre) qui y mène.
+ */
+#define NB_TRANCHES 64
+#define BLOC_DETERMINISATION 16
+
+typedef struct Sous_ensemble_partage {
+	unsigned int empreinte;
+	int taille;
+	int numero; //!< -1 tant que le sous-ensemble n'est pas numéroté.
+	int elements[];
+} Sous_ensemble_partage;
+
+typedef struct Tranche {
+	pthread_mutex_t verrou;
+	Sous_ensemble_partage ** cases;
+	int nb_cases;
+	int nb;
+	char separation[64];
+} Tranche;
+
+typedef struct Determinisation {
+	const Automate_indexe * index;
+	Automate_compile * res;
+	Tranche tranches[NB_TRANCHES];
+	Sous_ensemble_partage ** etats; //!< Les sous-ensembles, par numéro.
+	int capacite_etats;
+	int nb_etats;
+	int debut_niveau;
+	int fin_niveau;
+	Sous_ensemble_partage ** successeurs; //!< Par couple (état du niveau, lettre).
+	long capacite_successeurs;
+	atomic_int prochain;
+	pthread_barrier_t barriere;
+} Determinisation;
+
+static unsigned int empreinte_sous_ensemble( const int * elements, int taille ){
+	unsigned int h = 2166136261u;
+	int i;
+	for( i=0; i<taille; i++ ){
+		h = ( h ^ (unsigned int) elements[i] ) * 16777619u;
+	}
+	// Mélange final, pour que les bits de poids fort (qui choisissent la
+	// tranche) dépendent de tous les éléments.
+	h ^= h >> 15;
+	h *= 0x2c1b3c6du;
+	h ^= h >> 12;
+	return h;
+}
+
+static void agrandir_tranche( Tranche * tranche ){
+	int ancien_nb_cases = tranche->nb_cases;
+	Sous_ensemble_partage ** anciennes = tranche->cases;
+	tranche->nb_cases *= 2;
+	tranche->cases = xmalloc( sizeof(Sous_ensemble_partage *) * tranche->nb_cases );
+	memset( tranche->cases, 0, sizeof(Sous_ensemble_partage *) * tranche->nb_cases );
+	for( int i = 0; i < ancien_nb_cases; i++ ){
+		if( anciennes[i] ){
+			unsigned int c = anciennes[i]->empreinte & ( tranche->nb_cases - 1 );
+			while( tranche->cases[c] ){
+				c = ( c + 1 ) & ( tranche->nb_cases - 1 );
+			}
+			tranche->cases[c] = anciennes[i];
+		}
+	}
+	xfree( anciennes );
+}
+
+/*
+ * Renvoie le sous-ensemble partagé égal à 'elements', en l'enregistrant
+ * (sans numéro) s'il n'a jamais été rencontré.
+ */
+static Sous_ensemble_partage * interner_sous_ensemble(
+	Determinisation * d, const int * elements, int taille
+){
+	unsigned int h = empreinte_sous_ensemble( elements, taille );
+	Tranche * tranche = &d->tranches[ h >> 26 ];
+	pthread_mutex_lock( &tranche->verrou );
+	unsigned int c = h & ( tranche->nb_cases - 1 );
+	Sous_ensemble_partage * e;
+	while( ( e = tranche->cases[c] ) ){
+		if(
+			e->empreinte == h && e->taille == taille &&
+			memcmp( e->elements, elements, sizeof(int) * taille ) == 0
+		){
+			pthread_mutex_unlock( &tranche->verrou );
+			return e;
+		}
+		c = ( c + 1 ) & ( tranche->nb_cases - 1 );
+	}
+	e = xmalloc( sizeof(Sous_ensemble_partage) + sizeof(int) * taille );
+	e->empreinte = h;
+	e->taille = taille;
+	e->numero = -1;
+	memcpy( e->elements, elements, sizeof(int) * taille );
+	tranche->cases[c] = e;
+	tranche->nb++;
+	if( 2 * tranche->nb > tranche->nb_cases ){
+		agrandir_tranche( tranche );
+	}
+	pthread_mutex_unlock( &tranche->verrou );
+	return e;
+}
+
+/*
+ * Donne le numéro suivant à un sous-ensemble, en agrandissant les tableaux
+ * de l'automate compilé si besoin. N'est appelée que par un seul fil.
+ */
+static void numeroter_sous_ensemble(
+	Determinisation * d, Sous_ensemble_partage * e
+){
+	if( d->nb_etats == d->capacite_etats ){
+		int L = d->res->nb_lettres;
+		d->capacite_etats *= 2;
+		d->etats = xrealloc(
+			d->etats, sizeof(Sous_ensemble_partage *) * d->capacite_etats
+		);
+		d->res->transitions = xrealloc(
+			d->res->transitions, sizeof(int) * d->capacite_etats * ( L + 1 )
+		);
+		d->res->finaux = xrealloc( d->res->finaux, d->capacite_etats );
+	}
+	e->numero = d->nb_etats;
+	d->etats[ d->nb_etats++ ] = e;
+}
+
+/*
+ * Fin d'un niveau : numérote les nouveaux sous-ensembles dans l'ordre
+ * (état, lettre), remplit les transitions, et passe au niveau suivant.
+ */
+static void terminer_niveau( Determinisation * d ){
+	int L = d->res->nb_lettres;
+	int i, l;
+	for( i=d->debut_niveau; i<d->fin_niveau; i++ ){
+		for( l=0; l<L; l++ ){
+			Sous_ensemble_partage * e =
+				d->successeurs[ (long) ( i - d->debut_niveau ) * L + l ];
+			if( ! e ){
+				d->res->transitions[i*L + l] = ETAT_PUITS;
+				continue;
+			}
+			if( e->numero == -1 ){
+				numeroter_sous_ensemble( d, e );
+			}
+			d->res->transitions[i*L + l] = e->numero;
+		}
+	}
+	d->debut_niveau = d->fin_niveau;
+	d->fin_niveau = d->nb_etats;
+	long taille = (long) ( d->fin_niveau - d->debut_niveau ) * L;
+	if( taille > d->capacite_successeurs ){
+		d->capacite_successeurs = taille;
+		xfree( d->successeurs );
+		d->successeurs = xmalloc( sizeof(Sous_ensemble_partage *) * taille );
+	}
+	atomic_store( &d->prochain, 0 );
+}
+
+static int comparer_entiers( const void * a, const void * b ){
+	int x = *(const int *) a;
+	int y = *(const int *) b;
+	return ( x > y ) - ( x < y );
+}
+
+static void * determiniser( void * data ){
+	Determinisation * d = (Determinisation *) data;
+	const Automate_indexe * index = d->index;
+	int L = index->nb_lettres;
+	// Tampons propres au fil pour le calcul des successeurs.
+	int * successeurs = xmalloc( sizeof(int) * ( index->nb_etats + 1 ) );
+	int * marque = xmalloc( sizeof(int) * ( index->nb_etats + 1 ) );
+	int tampon = 0;
+	for( int i = 0; i < index->nb_etats; i++ ){
+		marque[i] = -1;
+	}
+
+	for( ;; ){
+		int taille_niveau = d->fin_niveau - d->debut_niveau;
+		int debut;
+		while( ( debut = atomic_fetch_add_explicit(
+			&d->prochain, BLOC_DETERMINISATION, memory_order_relaxed
+		) ) < taille_niveau ){
+			int fin = debut + BLOC_DETERMINISATION;
+			if( fin > taille_niveau ){
+				fin = taille_niveau;
+			}
+			for( int k = debut; k < fin; k++ ){
+				int i = d->debut_niveau + k;
+				const Sous_ensemble_partage * s = d->etats[i];
+				COMPTER_OPERATION( etats_visites, 1 );
+				d->res->finaux[i] = 0;
+				for( int j = 0; j < s->taille; j++ ){
+					if( index->finaux[ s->elements[j] ] ){
+						d->res->finaux[i] = 1;
+						break;
+					}
+				}
+				for( int l = 0; l < L; l++ ){
+					int nb_successeurs = 0;
+					tampon++;
+					for( int j = 0; j < s->taille; j++ ){
+						int c = s->elements[j] * L + l;
+						for( int t = index->debut[c]; t < index->debut[c+1]; t++ ){
+							int f = index->fins[t];
+							if( marque[f] != tampon ){
+								marque[f] = tampon;
+								successeurs[nb_successeurs++] = f;
+							}
+						}
+					}
+					Sous_ensemble_partage * e = NULL;
+					if( nb_successeurs ){
+						qsort(
+							successeurs, nb_successeurs, sizeof(int),
+							comparer_entiers
+						);
+						e = interner_sous_ensemble(
+							d, successeurs, nb_successeurs
+						);
+					}
+					d->successeurs[ (long) k * L + l ] = e;
+				}
+			}
+		}
+		if( pthread_barrier_wait( &d->barriere )
+			== PTHREAD_BARRIER_SERIAL_THREAD
+		){
+			terminer_niveau( d );
+		}
+		pthread_barrier_wait( &d->barriere );
+		if( d->debut_niveau == d->fin_niveau ){
+			break;
+		}
+	}
+
+	xfree( successeurs );
+	xfree( marque );
+	return NULL;
+}
+
+Automate_compile * compiler_automate_parallele(
+	const Automate * automate, int nb_fils
+){
+	Mesure_operation mesure;
+	debut_operation( &mesure, "compiler_automate_parallele" );
+	if( nb_fils < 1 ){
+		nb_fils = 1;
+	}
+	Automate_indexe * index = indexer_automate( automate );
+	Automate_compile * res = xmalloc( sizeof(Automate_compile) );
+	int L = index->nb_lettres;
+	int i;
+
+	res->nb_lettres = L;
+	memcpy( res->lettres, index->lettres, sizeof(res->lettres) );
+	memcpy( res->indice_lettre, index->indice_lettre, sizeof(res->indice_lettre) );
+	res->complet = 0;
+	res->puits_final = 0;
+
+	Determinisation d;
+	d.index = index;
+	d.res = res;
+	for( i=0; i<NB_TRANCHES; i++ ){
+		pthread_mutex_init( &d.tranches[i].verrou, NULL );
+		d.tranches[i].nb_cases = 16;
+		d.tranches[i].nb = 0;
+		d.tranches[i].cases = xmalloc( sizeof(Sous_ensemble_partage *) * 16 );
+		memset( d.tranches[i].cases, 0, sizeof(Sous_ensemble_partage *) * 16 );
+	}
+	d.capacite_etats = 16;
+	d.nb_etats = 0;
+	d.etats = xmalloc( sizeof(Sous_ensemble_partage *) * d.capacite_etats );
+	res->transitions = xmalloc( sizeof(int) * d.capacite_etats * ( L + 1 ) );
+	res->finaux = xmalloc( d.capacite_etats );
+	d.capacite_successeurs = L;
+	d.successeurs = xmalloc( sizeof(Sous_ensemble_partage *) * ( L + 1 ) );
+	atomic_init( &d.prochain, 0 );
+
+	if( index->nb_initiaux == 0 ){
+		res->initial = ETAT_PUITS;
+	}else{
+		int * initiaux = xmalloc( sizeof(int) * index->nb_initiaux );
+		memcpy( initiaux, index->initiaux, sizeof(int) * index->nb_initiaux );
+		qsort( initiaux, index->nb_initiaux, sizeof(int), comparer_entiers );
+		numeroter_sous_ensemble(
+			&d, interner_sous_ensemble( &d, initiaux, index->nb_initiaux )
+		);
+		res->initial = 0;
+		xfree( initiaux );
+	}
+	d.debut_niveau = 0;
+	d.fin_niveau = d.nb_etats;
+
+	if( d.nb_etats ){
+		pthread_barrier_init( &d.barriere, NULL, nb_fils );
+		executer_en_parallele( determiniser, &d, nb_fils );
+		pthread_barrier_destroy( &d.barriere );
+	}
+	res->nb_etats = d.nb_etats;
+
+	// Tous les sous-ensembles enregistrés ont été numérotés.
+	for( i=0; i<d.nb_etats; i++ ){
+		xfree( d.etats[i] );
+	}
+	for( i=0; i<NB_TRANCHES; i++ ){
+		xfree( d.tranches[i].cases );
+		pthread_mutex_destroy( &d.tranches[i].verrou );
+	}
+	xfree( d.etats );
+	xfree( d.successeurs );
+	liberer_automate_indexe( index );
+	fin_operation( &mesure );
+	return res;
+}
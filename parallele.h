@@ -0,0 +1,90 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2014, 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file parallele.h */
+
+#ifndef __PARALLELE_H__
+#define __PARALLELE_H__
+
+#include "automate_compile.h"
+
+#pragma GCC visibility push(default)
+
+/**
+ * @brief Exécute une même fonction dans plusieurs fils d'exécution.
+ *
+ * 'travail' est appelée avec 'data' dans nb_fils fils, dont le fil appelant,
+ * et la fonction rend la main quand tous ont terminé. Les compteurs 
+ * d'opérations des autres fils sont alors ajoutés à ceux du fil appelant.
+ *
+ * @param travail La fonction à exécuter.
+ * @param data L'argument de 'travail', partagé par tous les fils.
+ * @param nb_fils Le nombre de fils d'exécution (au moins 1).
+ */
+void executer_en_parallele(
+	void * (* travail )( void * data ), void * data, int nb_fils
+);
+
+/**
+ * @brief Marque les états accessibles d'un automate indexé en répartissant
+ *        le parcours sur plusieurs fils d'exécution.
+ *
+ * Le parcours en largeur est synchronisé niveau par niveau : les fils se
+ * partagent la frontière courante par blocs, marquent les états atteints
+ * dans un tableau de bits atomique (un état n'est donc ajouté qu'une fois)
+ * et les rangent d'abord dans une frontière locale, versée par blocs dans
+ * la frontière suivante. Le fil appelant participe au parcours.
+ *
+ * Le résultat est le même que celui de marquer_accessibles_indexe().
+ *
+ * @param automate Un automate indexé.
+ * @param marques Un tableau de nb_etats cases, qui reçoit 1 pour les états
+ *        accessibles et 0 pour les autres.
+ * @param nb_fils Le nombre de fils d'exécution (au moins 1).
+ */
+void marquer_accessibles_indexe_parallele(
+	const Automate_indexe * automate, unsigned char * marques, int nb_fils
+);
+
+/**
+ * @brief Compile un automate en un automate déterministe, en répartissant la
+ *        construction des sous-ensembles sur plusieurs fils d'exécution.
+ *
+ * La construction avance niveau par niveau du parcours en largeur : les
+ * fils se partagent les sous-ensembles de la frontière, calculent leurs
+ * successeurs avec des tampons qui leur sont propres, et les enregistrent
+ * dans une table de sous-ensembles partagée, découpée en tranches protégées
+ * chacune par un verrou. Les nouveaux sous-ensembles d'un niveau sont
+ * ensuite numérotés par un seul fil, dans l'ordre (état, lettre).
+ *
+ * La numérotation ne dépend donc pas du nombre de fils : le résultat est
+ * identique à celui de compiler_automate().
+ *
+ * @param automate Un automate.
+ * @param nb_fils Le nombre de fils d'exécution (au moins 1).
+ * @return L'automate compilé.
+ */
+Automate_compile * compiler_automate_parallele(
+	const Automate * automate, int nb_fils
+);
+
+#pragma GCC visibility pop
+
+#endif
@@ -0,0 +1,186 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2014, 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "pipeline.h"
+#include "files_concurrentes.h"
+#include "outils.h"
+#include "statistiques.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+/*
+ * Nombre de cases (mots en cours de traitement) par fil de reconnaissance.
+ */
+#define CASES_PAR_FIL 256
+
+/*
+ * Indice de case spécial, déposé une fois par fil de reconnaissance pour
+ * lui signaler la fin du flot de mots.
+ */
+#define FIN_DU_FLOT (-1)
+
+typedef struct Case_pipeline {
+	const char * mot;
+	long indice;
+	int reconnu;
+} Case_pipeline;
+
+typedef struct Pipeline {
+	const Automate_compile * automate;
+	Lecteur_mots lire;
+	void * data_lecture;
+	int nb_fils;
+	Case_pipeline * cases;
+	File_spsc * cases_libres; //!< Du fil appelant vers le fil de lecture.
+	File_mpmc * mots; //!< Du fil de lecture vers les fils de reconnaissance.
+	File_spsc ** resultats; //!< D'un fil de reconnaissance vers le fil appelant.
+	long nb_mots;
+} Pipeline;
+
+typedef struct Fil_reconnaissance {
+	Pipeline * pipeline;
+	File_spsc * resultats;
+	Statistiques_operation compteurs; //!< Relevés à la fin du fil.
+} Fil_reconnaissance;
+
+static void * lecture( void * data ){
+	Pipeline * pipeline = (Pipeline *) data;
+	const char * mot;
+	long indice = 0;
+	while( ( mot = pipeline->lire( pipeline->data_lecture ) ) ){
+		intptr_t c = prelever_spsc_attendre( pipeline->cases_libres );
+		pipeline->cases[c].mot = mot;
+		pipeline->cases[c].indice = indice++;
+		deposer_mpmc_attendre( pipeline->mots, c );
+	}
+	pipeline->nb_mots = indice;
+	for( int i = 0; i < pipeline->nb_fils; i++ ){
+		deposer_mpmc_attendre( pipeline->mots, FIN_DU_FLOT );
+	}
+	return NULL;
+}
+
+static void * reconnaissance( void * data ){
+	Fil_reconnaissance * fil = (Fil_reconnaissance *) data;
+	Pipeline * pipeline = fil->pipeline;
+	Statistiques_operation depart = compteurs_operations;
+	intptr_t c;
+	while( ( c = prelever_mpmc_attendre( pipeline->mots ) ) != FIN_DU_FLOT ){
+		Case_pipeline * case_mot = &pipeline->cases[c];
+		case_mot->reconnu = le_mot_est_reconnu_compile(
+			pipeline->automate, case_mot->mot
+		);
+		deposer_spsc_attendre( fil->resultats, c );
+	}
+	fil->compteurs = compteurs_depuis( &depart );
+	deposer_spsc_attendre( fil->resultats, FIN_DU_FLOT );
+	return NULL;
+}
+
+long reconnaitre_en_pipeline(
+	const Automate_compile * automate,
+	Lecteur_mots lire, void * data_lecture,
+	Emetteur_resultats emettre, void * data_emission,
+	int nb_fils
+){
+	if( nb_fils < 1 ){
+		nb_fils = 1;
+	}
+	int nb_cases = CASES_PAR_FIL * nb_fils;
+	Pipeline pipeline;
+	pipeline.automate = automate;
+	pipeline.lire = lire;
+	pipeline.data_lecture = data_lecture;
+	pipeline.nb_fils = nb_fils;
+	pipeline.nb_mots = 0;
+	pipeline.cases = xmalloc( sizeof(Case_pipeline) * nb_cases );
+	pipeline.cases_libres = creer_file_spsc( nb_cases );
+	// Chaque file peut contenir toutes les cases et les marques de fin :
+	// un dépôt n'attend donc jamais un étage en aval.
+	pipeline.mots = creer_file_mpmc( nb_cases + nb_fils );
+	pipeline.resultats = xmalloc( sizeof(File_spsc *) * nb_fils );
+	for( int c = 0; c < nb_cases; c++ ){
+		deposer_spsc( pipeline.cases_libres, c );
+	}
+
+	Fil_reconnaissance * fils = xmalloc( sizeof(Fil_reconnaissance) * nb_fils );
+	pthread_t * identifiants = xmalloc( sizeof(pthread_t) * nb_fils );
+	pthread_t identifiant_lecture;
+	for( int i = 0; i < nb_fils; i++ ){
+		pipeline.resultats[i] = creer_file_spsc( nb_cases + 1 );
+		fils[i].pipeline = &pipeline;
+		fils[i].resultats = pipeline.resultats[i];
+		if( pthread_create( &identifiants[i], NULL, reconnaissance, &fils[i] ) ){
+			ERREUR( "Impossible de créer un fil d'exécution" );
+		}
+	}
+	if( pthread_create( &identifiant_lecture, NULL, lecture, &pipeline ) ){
+		ERREUR( "Impossible de créer un fil d'exécution" );
+	}
+
+	// Collecte : on passe d'une file de résultats à l'autre jusqu'à avoir
+	// reçu la marque de fin de chaque fil de reconnaissance.
+	int nb_fils_actifs = nb_fils;
+	unsigned char * fil_termine = xmalloc( nb_fils );
+	for( int i = 0; i < nb_fils; i++ ){
+		fil_termine[i] = 0;
+	}
+	while( nb_fils_actifs ){
+		int recu = 0;
+		for( int i = 0; i < nb_fils; i++ ){
+			intptr_t c;
+			while( ! fil_termine[i] && prelever_spsc( pipeline.resultats[i], &c ) ){
+				recu = 1;
+				if( c == FIN_DU_FLOT ){
+					fil_termine[i] = 1;
+					nb_fils_actifs--;
+					break;
+				}
+				Case_pipeline * case_mot = &pipeline.cases[c];
+				emettre(
+					case_mot->indice, case_mot->mot, case_mot->reconnu,
+					data_emission
+				);
+				deposer_spsc( pipeline.cases_libres, c );
+			}
+		}
+		if( ! recu ){
+			sched_yield();
+		}
+	}
+
+	pthread_join( identifiant_lecture, NULL );
+	for( int i = 0; i < nb_fils; i++ ){
+		pthread_join( identifiants[i], NULL );
+		ajouter_compteurs_operations( &fils[i].compteurs );
+		liberer_file_spsc( pipeline.resultats[i] );
+	}
+	xfree( fil_termine );
+	xfree( identifiants );
+	xfree( fils );
+	xfree( pipeline.resultats );
+	liberer_file_mpmc( pipeline.mots );
+	liberer_file_spsc( pipeline.cases_libres );
+	xfree( pipeline.cases );
+	return pipeline.nb_mots;
+}
@@ -0,0 +1,82 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2014, 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file pipeline.h */
+
+#ifndef __PIPELINE_H__
+#define __PIPELINE_H__
+
+#include "automate_compile.h"
+
+#pragma GCC visibility push(default)
+
+/**
+ * @brief Le type de la fonction qui fournit les mots au pipeline.
+ *
+ * Elle renvoie le mot suivant, ou NULL lorsqu'il n'y en a plus. Le mot doit
+ * rester valide jusqu'à ce que son résultat ait été émis.
+ */
+typedef const char * (* Lecteur_mots)( void * data );
+
+/**
+ * @brief Le type de la fonction qui reçoit les résultats du pipeline.
+ *
+ * 'indice' est le rang du mot dans l'ordre de lecture (à partir de 0), et
+ * 'reconnu' vaut 1 si le mot est reconnu et 0 sinon.
+ */
+typedef void (* Emetteur_resultats)(
+	long indice, const char * mot, int reconnu, void * data
+);
+
+/**
+ * @brief Reconnaît un flot de mots en répartissant le travail sur plusieurs
+ *        fils d'exécution.
+ *
+ * Le pipeline a trois étages reliés par des files sans verrou :
+ * - un fil de lecture appelle 'lire' et dépose les mots dans une file MPMC ;
+ * - nb_fils fils de reconnaissance les prélèvent, appellent
+ *   le_mot_est_reconnu_compile(), et déposent les résultats dans une file
+ *   SPSC propre à chacun ;
+ * - le fil appelant collecte ces résultats et appelle 'emettre'.
+ *
+ * Les mots en cours de traitement sont rangés dans un nombre fixe de cases,
+ * rendues au fil de lecture par une file SPSC après l'émission : aucune
+ * allocation n'a lieu par mot. 'lire' n'est appelée que par le fil de
+ * lecture et 'emettre' que par le fil appelant. Les résultats sont émis
+ * dans un ordre quelconque.
+ *
+ * @param automate L'automate compilé, qui n'est pas modifié.
+ * @param lire La fonction qui fournit les mots.
+ * @param data_lecture Le paramètre transmis à 'lire'.
+ * @param emettre La fonction qui reçoit les résultats.
+ * @param data_emission Le paramètre transmis à 'emettre'.
+ * @param nb_fils Le nombre de fils de reconnaissance (au moins 1).
+ * @return Le nombre de mots traités.
+ */
+long reconnaitre_en_pipeline(
+	const Automate_compile * automate,
+	Lecteur_mots lire, void * data_lecture,
+	Emetteur_resultats emettre, void * data_emission,
+	int nb_fils
+);
+
+#pragma GCC visibility pop
+
+#endif
@@ -0,0 +1,146 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define ETIQUETTE_ALLOCATIONS ETIQUETTE_ENSEMBLE
+
+#include "pool_ensembles.h"
+#include "outils.h"
+
+#include <stdlib.h>
+
+#include <assert.h>
+
+/*
+ * Les ensembles internés sont rangés dans l'ordre de leurs identifiants. La
+ * table de hachage 'cases' (adressage ouvert, sondage linéaire) contient les
+ * identifiants, ou -1 pour une case libre. Elle est toujours remplie à moins
+ * de moitié.
+ */
+struct Pool_ensembles {
+	int nb;
+	int capacite;
+	Ensemble ** ensembles;
+	int * cases;
+	int nb_cases;
+};
+
+Pool_ensembles * creer_pool_ensembles(){
+	Pool_ensembles * res = xmalloc( sizeof(Pool_ensembles) );
+	int i;
+	res->nb = 0;
+	res->capacite = 16;
+	res->ensembles = xmalloc( sizeof(Ensemble *) * res->capacite );
+	res->nb_cases = 32;
+	res->cases = xmalloc( sizeof(int) * res->nb_cases );
+	for( i=0; i<res->nb_cases; i++ ){
+		res->cases[i] = -1;
+	}
+	return res;
+}
+
+void liberer_pool_ensembles( Pool_ensembles * pool ){
+	int i;
+	for( i=0; i<pool->nb; i++ ){
+		liberer_ensemble( pool->ensembles[i] );
+	}
+	xfree( pool->ensembles );
+	xfree( pool->cases );
+	xfree( pool );
+}
+
+static int sont_egaux( const Ensemble * ens1, const Ensemble * ens2 ){
+	return empreinte_ensemble( ens1 ) == empreinte_ensemble( ens2 )
+		&& taille_ensemble( ens1 ) == taille_ensemble( ens2 )
+		&& comparer_ensemble( ens1, ens2 ) == 0;
+}
+
+/*
+ * Renvoie la case qui contient l'identifiant de l'ensemble, ou la case libre
+ * où il faudrait le ranger.
+ */
+static int chercher_case( const Pool_ensembles * pool, const Ensemble * ensemble ){
+	int masque = pool->nb_cases - 1;
+	int c = (int) ( empreinte_ensemble( ensemble ) & masque );
+	while(
+		pool->cases[c] != -1
+		&& ! sont_egaux( pool->ensembles[ pool->cases[c] ], ensemble )
+	){
+		c = ( c + 1 ) & masque;
+	}
+	return c;
+}
+
+static void agrandir_cases( Pool_ensembles * pool ){
+	int i;
+	xfree( pool->cases );
+	pool->nb_cases *= 2;
+	pool->cases = xmalloc( sizeof(int) * pool->nb_cases );
+	for( i=0; i<pool->nb_cases; i++ ){
+		pool->cases[i] = -1;
+	}
+	int masque = pool->nb_cases - 1;
+	for( i=0; i<pool->nb; i++ ){
+		int c = (int) ( empreinte_ensemble( pool->ensembles[i] ) & masque );
+		while( pool->cases[c] != -1 ){
+			c = ( c + 1 ) & masque;
+		}
+		pool->cases[c] = i;
+	}
+}
+
+int interner_ensemble(
+	Pool_ensembles * pool, const Ensemble * ensemble, int * nouveau
+){
+	assert( ensemble->comparer_element == NULL );
+	int c = chercher_case( pool, ensemble );
+	if( pool->cases[c] != -1 ){
+		if( nouveau ) *nouveau = 0;
+		return pool->cases[c];
+	}
+	if( pool->nb == pool->capacite ){
+		pool->capacite *= 2;
+		pool->ensembles = xrealloc(
+			pool->ensembles, sizeof(Ensemble *) * pool->capacite
+		);
+	}
+	int id = pool->nb++;
+	pool->ensembles[id] = partager_ensemble( ensemble );
+	pool->cases[c] = id;
+	if( 2 * pool->nb > pool->nb_cases ){
+		agrandir_cases( pool );
+	}
+	if( nouveau ) *nouveau = 1;
+	return id;
+}
+
+int trouver_ensemble_pool(
+	const Pool_ensembles * pool, const Ensemble * ensemble
+){
+	return pool->cases[ chercher_case( pool, ensemble ) ];
+}
+
+const Ensemble * get_ensemble_pool( const Pool_ensembles * pool, int id ){
+	assert( id >= 0 && id < pool->nb );
+	return pool->ensembles[id];
+}
+
+int taille_pool_ensembles( const Pool_ensembles * pool ){
+	return pool->nb;
+}
@@ -0,0 +1,84 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux.
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __POOL_ENSEMBLES_H__
+#define __POOL_ENSEMBLES_H__
+
+#include "ensemble.h"
+
+#pragma GCC visibility push(default)
+
+/*
+ * Définit le type d'un pool d'ensembles internés.
+ *
+ * Un pool associe à chaque contenu d'ensemble d'entiers un identifiant 
+ * unique : deux ensembles sont égaux si et seulement si ils ont le même 
+ * identifiant. La recherche d'un ensemble dans le pool utilise son empreinte
+ * (voir empreinte_ensemble()), et se fait donc en temps constant en moyenne,
+ * plus une comparaison complète lorsque l'ensemble est trouvé.
+ *
+ * Le pool ne copie pas les ensembles internés : il en garde une copie 
+ * partagée (voir partager_ensemble()).
+ */
+typedef struct Pool_ensembles Pool_ensembles;
+
+/*
+ * Renvoie un nouveau pool vide.
+ */
+Pool_ensembles * creer_pool_ensembles();
+
+/*
+ * Détruit un pool et les copies partagées des ensembles qu'il contient.
+ */
+void liberer_pool_ensembles( Pool_ensembles * pool );
+
+/*
+ * Renvoie l'identifiant du contenu de l'ensemble, en l'ajoutant au pool s'il
+ * n'y est pas déjà. Les identifiants sont attribués dans l'ordre, à partir de
+ * 0. 
+ * Si 'nouveau' est différent de NULL, *nouveau reçoit 1 si l'ensemble a été
+ * ajouté et 0 sinon.
+ */
+int interner_ensemble(
+	Pool_ensembles * pool, const Ensemble * ensemble, int * nouveau
+);
+
+/*
+ * Renvoie l'identifiant du contenu de l'ensemble, ou -1 si aucun ensemble de
+ * même contenu n'a été interné.
+ */
+int trouver_ensemble_pool(
+	const Pool_ensembles * pool, const Ensemble * ensemble
+);
+
+/*
+ * Renvoie l'ensemble interné d'identifiant donné. Cet ensemble appartient au
+ * pool et ne doit pas être modifié.
+ */
+const Ensemble * get_ensemble_pool( const Pool_ensembles * pool, int id );
+
+/*
+ * Renvoie le nombre d'ensembles internés.
+ */
+int taille_pool_ensembles( const Pool_ensembles * pool );
+
+#pragma GCC visibility pop
+
+#endif
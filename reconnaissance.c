@@ -0,0 +1,283 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2014, 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "reconnaissance.h"
+#include "automate_compile.h"
+#include "outils.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <assert.h>
+
+struct Reconnaisseur {
+	Automate_indexe * index;
+	//! 1 si l'index appartient au reconnaisseur, 0 si c'est la copie de
+	//! l'index passé à creer_reconnaisseur_indexe().
+	int possede_index;
+	//! 1 si l'index inverse a été construit par le reconnaisseur.
+	int possede_inverse;
+	Automate_indexe miroir; //!< Vue miroir de l'index.
+	unsigned char * co_accessible;
+	unsigned char * accessible;
+	int nb_initiaux; //!< Nombre d'états initiaux co-accessibles.
+	int * initiaux;
+	int nb_finaux; //!< Nombre d'états finaux accessibles.
+	int * finaux;
+	int * courants;
+	int * suivants;
+	unsigned int * marques; //!< Numéro de la dernière étape où l'état a été vu.
+	unsigned int etape;
+};
+
+/*
+ * Crée un reconnaisseur à partir d'un automate indexé, dont il ne fait
+ * qu'utiliser les tableaux.
+ */
+static Reconnaisseur * creer_reconnaisseur_depuis( Automate_indexe * index ){
+	Reconnaisseur * res = xmalloc( sizeof(Reconnaisseur) );
+	int n = index->nb_etats;
+	int i;
+
+	res->index = index;
+	res->possede_inverse = ( index->debut_inverse == NULL );
+	res->miroir = miroir_indexe( index );
+	res->co_accessible = xmalloc( n + 1 );
+	marquer_accessibles_indexe( &res->miroir, res->co_accessible );
+	res->accessible = xmalloc( n + 1 );
+	marquer_accessibles_indexe( index, res->accessible );
+
+	res->initiaux = xmalloc( sizeof(int) * ( index->nb_initiaux + 1 ) );
+	res->nb_initiaux = 0;
+	for( i=0; i<index->nb_initiaux; i++ ){
+		if( res->co_accessible[ index->initiaux[i] ] ){
+			res->initiaux[ res->nb_initiaux++ ] = index->initiaux[i];
+		}
+	}
+	res->finaux = xmalloc( sizeof(int) * ( index->nb_finaux + 1 ) );
+	res->nb_finaux = 0;
+	for( i=0; i<index->nb_finaux; i++ ){
+		if( res->accessible[ index->liste_finaux[i] ] ){
+			res->finaux[ res->nb_finaux++ ] = index->liste_finaux[i];
+		}
+	}
+	res->courants = xmalloc( sizeof(int) * ( n + 1 ) );
+	res->suivants = xmalloc( sizeof(int) * ( n + 1 ) );
+	res->marques = xmalloc( sizeof(unsigned int) * ( n + 1 ) );
+	memset( res->marques, 0, sizeof(unsigned int) * ( n + 1 ) );
+	res->etape = 0;
+	return res;
+}
+
+Reconnaisseur * creer_reconnaisseur( const Automate * automate ){
+	Reconnaisseur * res = creer_reconnaisseur_depuis(
+		indexer_automate( automate )
+	);
+	res->possede_index = 1;
+	return res;
+}
+
+Reconnaisseur * creer_reconnaisseur_indexe( const Automate_indexe * index ){
+	Automate_indexe * copie = xmalloc( sizeof(Automate_indexe) );
+	*copie = *index;
+	Reconnaisseur * res = creer_reconnaisseur_depuis( copie );
+	res->possede_index = 0;
+	return res;
+}
+
+void liberer_reconnaisseur( Reconnaisseur * reconnaisseur ){
+	if( reconnaisseur->possede_index ){
+		liberer_automate_indexe( reconnaisseur->index );
+	}else{
+		if( reconnaisseur->possede_inverse ){
+			xfree( reconnaisseur->index->debut_inverse );
+			xfree( reconnaisseur->index->origines );
+		}
+		xfree( reconnaisseur->index );
+	}
+	xfree( reconnaisseur->co_accessible );
+	xfree( reconnaisseur->accessible );
+	xfree( reconnaisseur->initiaux );
+	xfree( reconnaisseur->finaux );
+	xfree( reconnaisseur->courants );
+	xfree( reconnaisseur->suivants );
+	xfree( reconnaisseur->marques );
+	xfree( reconnaisseur );
+}
+
+/*
+ * Commence une nouvelle étape : un état est dans l'ensemble en construction
+ * si et seulement si sa marque vaut le numéro de l'étape.
+ */
+static void nouvelle_etape( Reconnaisseur * r ){
+	if( ++r->etape == 0 ){
+		memset( r->marques, 0, sizeof(unsigned int) * r->index->nb_etats );
+		r->etape = 1;
+	}
+}
+
+/*
+ * Ajoute aux états courants ceux des états passés en paramètre qui sont
+ * utiles et qui n'y sont pas déjà, puis renvoie le nombre d'états courants.
+ */
+static int ajouter_etats(
+	Reconnaisseur * r, const unsigned char * utiles, const int * etats,
+	int nb_etats, int nb
+){
+	int i;
+	for( i=0; i<nb_etats; i++ ){
+		int e = etats[i];
+		if( utiles[e] && r->marques[e] != r->etape ){
+			r->marques[e] = r->etape;
+			r->courants[nb++] = e;
+		}
+	}
+	return nb;
+}
+
+/*
+ * Remplace les 'nb' états courants par les états utiles atteints en lisant
+ * une lettre dans l'automate indexé (ou sa vue miroir), et renvoie leur
+ * nombre.
+ */
+static int avancer(
+	Reconnaisseur * r, const Automate_indexe * index,
+	const unsigned char * utiles, int nb, char lettre
+){
+	int L = index->nb_lettres;
+	int l = index->indice_lettre[ (unsigned char) lettre ];
+	int nb_suivants = 0;
+	int i, t;
+
+	nouvelle_etape( r );
+	if( l != -1 ){
+		for( i=0; i<nb; i++ ){
+			int k = r->courants[i] * L + l;
+			for( t=index->debut[k]; t<index->debut[k+1]; t++ ){
+				int f = index->fins[t];
+				if( utiles[f] && r->marques[f] != r->etape ){
+					r->marques[f] = r->etape;
+					r->suivants[nb_suivants++] = f;
+				}
+			}
+		}
+	}
+	int * tmp = r->courants;
+	r->courants = r->suivants;
+	r->suivants = tmp;
+	return nb_suivants;
+}
+
+static int contient_final(
+	const Reconnaisseur * r, const Automate_indexe * index, int nb
+){
+	int i;
+	for( i=0; i<nb; i++ ){
+		if( index->finaux[ r->courants[i] ] ) return 1;
+	}
+	return 0;
+}
+
+/*
+ * Lit le mot depuis les états initiaux. Si 'prefixe' vaut 1, la lecture
+ * s'arrête dès qu'un état final est atteint, et la fonction renvoie la
+ * longueur lue. Sinon, elle renvoie la longueur du mot si le mot est reconnu.
+ * Dans les autres cas, elle renvoie -1.
+ */
+static int lire( Reconnaisseur * r, const char * mot, int prefixe ){
+	int longueur = 0;
+	int nb;
+
+	nouvelle_etape( r );
+	nb = ajouter_etats( r, r->co_accessible, r->initiaux, r->nb_initiaux, 0 );
+	for( ;; longueur++ ){
+		if(
+			( prefixe || mot[longueur] == '\0' )
+			&& contient_final( r, r->index, nb )
+		){
+			return longueur;
+		}
+		if( mot[longueur] == '\0' || nb == 0 ) return -1;
+		nb = avancer( r, r->index, r->co_accessible, nb, mot[longueur] );
+	}
+}
+
+int reconnaitre_mot( Reconnaisseur * reconnaisseur, const char * mot ){
+	return lire( reconnaisseur, mot, 0 ) != -1;
+}
+
+int reconnaitre_prefixe(
+	Reconnaisseur * reconnaisseur, const char * mot, int * longueur
+){
+	int res = lire( reconnaisseur, mot, 1 );
+	if( res == -1 ) return 0;
+	if( longueur ) *longueur = res;
+	return 1;
+}
+
+int rechercher_fins(
+	Reconnaisseur * reconnaisseur, const char * texte,
+	void (* action )( int position, void * data ), void * data
+){
+	Reconnaisseur * r = reconnaisseur;
+	int nb_positions = 0;
+	int position = 0;
+	int nb = 0;
+
+	nouvelle_etape( r );
+	// Les états initiaux sont ajoutés à chaque position : c'est une boucle
+	// implicite sur les états initiaux, pour toutes les lettres.
+	for( ;; position++ ){
+		nb = ajouter_etats(
+			r, r->co_accessible, r->initiaux, r->nb_initiaux, nb
+		);
+		if( contient_final( r, r->index, nb ) ){
+			nb_positions++;
+			if( action ) action( position, data );
+		}
+		if( texte[position] == '\0' ) return nb_positions;
+		nb = avancer( r, r->index, r->co_accessible, nb, texte[position] );
+	}
+}
+
+int rechercher_debuts(
+	Reconnaisseur * reconnaisseur, const char * texte,
+	void (* action )( int position, void * data ), void * data
+){
+	Reconnaisseur * r = reconnaisseur;
+	int nb_positions = 0;
+	int position = strlen( texte );
+	int nb = 0;
+
+	// Le même parcours que rechercher_fins(), dans l'automate miroir et de
+	// la fin du texte vers son début. Dans le miroir, les états initiaux
+	// sont les finaux de l'automate et les états utiles sont ses états
+	// accessibles.
+	nouvelle_etape( r );
+	for( ;; position-- ){
+		nb = ajouter_etats( r, r->accessible, r->finaux, r->nb_finaux, nb );
+		if( contient_final( r, &r->miroir, nb ) ){
+			nb_positions++;
+			if( action ) action( position, data );
+		}
+		if( position == 0 ) return nb_positions;
+		nb = avancer( r, &r->miroir, r->accessible, nb, texte[position-1] );
+	}
+}
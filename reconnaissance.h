@@ -0,0 +1,157 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2014, 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file reconnaissance.h */
+
+#ifndef __RECONNAISSANCE_H__
+#define __RECONNAISSANCE_H__
+
+#include "automate.h"
+#include "automate_compile.h"
+
+#pragma GCC visibility push(default)
+
+/**
+ * @brief Le type d'un reconnaisseur.
+ *
+ * Un reconnaisseur est construit une fois pour toutes à partir d'un automate
+ * (éventuellement non déterministe), pour reconnaître ensuite de nombreux
+ * mots. Il contient l'automate indexé, l'ensemble de ses états
+ * co-accessibles, et les tampons utilisés lors de la lecture d'un mot :
+ *  - les états qui ne sont pas co-accessibles ne sont jamais ajoutés aux
+ *    états courants, puisqu'ils ne peuvent mener à aucun état final ;
+ *  - la lecture s'arrête dès que l'ensemble des états courants est vide ;
+ *  - la lecture d'un mot ne fait aucune allocation.
+ *
+ * Le reconnaisseur ne dépend plus de l'automate après sa création. Comme il
+ * contient ses propres tampons, il ne doit pas être utilisé par deux threads
+ * en même temps.
+ */
+typedef struct Reconnaisseur Reconnaisseur;
+
+/**
+ * @brief Crée le reconnaisseur d'un automate.
+ *
+ * @param automate Un automate.
+ * @return Le reconnaisseur.
+ */
+Reconnaisseur * creer_reconnaisseur( const Automate * automate );
+
+/**
+ * @brief Crée le reconnaisseur d'un automate indexé.
+ *
+ * Le reconnaisseur utilise directement les tableaux de l'automate indexé,
+ * sans les copier : l'automate indexé doit donc rester valide tant que le
+ * reconnaisseur existe. Il n'est jamais modifié. Si son index inverse n'est
+ * pas construit, le reconnaisseur construit le sien.
+ *
+ * La création est en temps linéaire en la taille de l'automate, pour le
+ * calcul des états accessibles et co-accessibles.
+ *
+ * @param index Un automate indexé.
+ * @return Le reconnaisseur.
+ */
+Reconnaisseur * creer_reconnaisseur_indexe( const Automate_indexe * index );
+
+/**
+ * @brief Détruit un reconnaisseur.
+ *
+ * @param reconnaisseur Le reconnaisseur à détruire.
+ */
+void liberer_reconnaisseur( Reconnaisseur * reconnaisseur );
+
+/**
+ * @brief Renvoie 1 si le mot est reconnu et 0 sinon.
+ *
+ * @param reconnaisseur Un reconnaisseur.
+ * @param mot Le mot à reconnaître.
+ * @return 1 ou 0.
+ */
+int reconnaitre_mot( Reconnaisseur * reconnaisseur, const char * mot );
+
+/**
+ * @brief Renvoie 1 si un préfixe du mot est reconnu et 0 sinon.
+ *
+ * La lecture s'arrête dès qu'un état final est atteint : c'est le mode à
+ * utiliser pour un motif ancré seulement au début du mot. Si 'longueur' est
+ * différent de NULL et si un préfixe est reconnu, *longueur reçoit la
+ * longueur du plus court préfixe reconnu.
+ *
+ * @param reconnaisseur Un reconnaisseur.
+ * @param mot Le mot à lire.
+ * @param longueur Un pointeur qui recevra la longueur du préfixe, ou NULL.
+ * @return 1 ou 0.
+ */
+int reconnaitre_prefixe(
+	Reconnaisseur * reconnaisseur, const char * mot, int * longueur
+);
+
+/**
+ * @brief Recherche les occurrences des mots reconnus dans un texte, et
+ *        renvoie le nombre de positions de fin d'occurrence.
+ *
+ * Une position p (entre 0 et la longueur du texte) est une fin d'occurrence
+ * s'il existe une position d <= p telle que le facteur du texte qui commence
+ * à la position d et se termine juste avant la position p est reconnu.
+ * Le texte est lu une seule fois, de gauche à droite : tout se passe comme
+ * si les états initiaux bouclaient sur eux-mêmes pour toutes les lettres.
+ *
+ * Si 'action' est différent de NULL, la fonction 'action' est appelée pour
+ * chaque fin d'occurrence, par ordre croissant, avec la position et le
+ * paramètre 'data'.
+ *
+ * @param reconnaisseur Un reconnaisseur.
+ * @param texte Le texte.
+ * @param action La fonction à appeler pour chaque position, ou NULL.
+ * @param data La donnée supplémentaire à passer à la fonction 'action'.
+ * @return Le nombre de fins d'occurrence.
+ */
+int rechercher_fins(
+	Reconnaisseur * reconnaisseur, const char * texte,
+	void (* action )( int position, void * data ), void * data
+);
+
+/**
+ * @brief Recherche les positions de début d'occurrence des mots reconnus
+ *        dans un texte, et renvoie leur nombre.
+ *
+ * Une position d est un début d'occurrence s'il existe une position p >= d
+ * telle que le facteur du texte qui commence à la position d et se termine
+ * juste avant la position p est reconnu. Le texte est lu une seule fois, de
+ * droite à gauche, avec l'automate miroir.
+ *
+ * Si 'action' est différent de NULL, la fonction 'action' est appelée pour
+ * chaque début d'occurrence, par ordre <b>décroissant</b>, avec la position
+ * et le paramètre 'data'.
+ *
+ * @param reconnaisseur Un reconnaisseur.
+ * @param texte Le texte.
+ * @param action La fonction à appeler pour chaque position, ou NULL.
+ * @param data La donnée supplémentaire à passer à la fonction 'action'.
+ * @return Le nombre de débuts d'occurrence.
+ */
+int rechercher_debuts(
+	Reconnaisseur * reconnaisseur, const char * texte,
+	void (* action )( int position, void * data ), void * data
+);
+
+#pragma GCC visibility pop
+
+#endif
@@ -0,0 +1,364 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2014, 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "sauvegarde.h"
+#include "outils.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <assert.h>
+
+#define MAGIE_FORMAT_AUTOMATE "AUTOMATE"
+#define BOUTISME 0x01020304u
+
+/*
+ * Les tableaux de l'automate indexé, dans l'ordre où ils sont rangés dans
+ * le fichier.
+ */
+enum {
+	TABLEAU_ETATS,
+	TABLEAU_DEBUT,
+	TABLEAU_FINS,
+	TABLEAU_INITIAUX,
+	TABLEAU_FINAUX,
+	TABLEAU_LISTE_FINAUX,
+	TABLEAU_EST_INITIAL,
+	TABLEAU_DEBUT_INVERSE,
+	TABLEAU_ORIGINES,
+	NB_TABLEAUX
+};
+
+typedef struct {
+	char magie[8];
+	uint32_t version;
+	uint32_t boutisme;
+	uint32_t taille_int;
+	int nb_etats;
+	int nb_lettres;
+	int nb_transitions;
+	int nb_initiaux;
+	int nb_finaux;
+	uint64_t taille; //!< Taille du fichier, en octets.
+	uint64_t somme; //!< Somme de contrôle du fichier, ce champ valant 0.
+	uint64_t positions[NB_TABLEAUX]; //!< Position de chaque tableau.
+	char lettres[NB_LETTRES_MAX];
+	int indice_lettre[NB_LETTRES_MAX];
+} Entete;
+
+_Static_assert( sizeof(Entete) % 8 == 0, "Les tableaux doivent être alignés" );
+
+struct Automate_charge {
+	Automate_indexe index;
+	const unsigned char * projection;
+	size_t taille;
+};
+
+static uint64_t arrondir( uint64_t taille ){
+	return ( taille + 7 ) & ~(uint64_t) 7;
+}
+
+/*
+ * Calcule la taille en octets de chaque tableau à partir des tailles de
+ * l'automate.
+ */
+static void tailles_tableaux(
+	const Entete * entete, uint64_t tailles[NB_TABLEAUX]
+){
+	uint64_t nb_cases = (uint64_t) entete->nb_etats * entete->nb_lettres;
+	tailles[TABLEAU_ETATS] = (uint64_t) entete->nb_etats * sizeof(int);
+	tailles[TABLEAU_DEBUT] = ( nb_cases + 1 ) * sizeof(int);
+	tailles[TABLEAU_FINS] = (uint64_t) entete->nb_transitions * sizeof(int);
+	tailles[TABLEAU_INITIAUX] = (uint64_t) entete->nb_initiaux * sizeof(int);
+	tailles[TABLEAU_FINAUX] = entete->nb_etats;
+	tailles[TABLEAU_LISTE_FINAUX] = (uint64_t) entete->nb_finaux * sizeof(int);
+	tailles[TABLEAU_EST_INITIAL] = entete->nb_etats;
+	tailles[TABLEAU_DEBUT_INVERSE] = ( nb_cases + 1 ) * sizeof(int);
+	tailles[TABLEAU_ORIGINES] = (uint64_t) entete->nb_transitions * sizeof(int);
+}
+
+/*
+ * La somme de contrôle est calculée mot de 64 bits par mot de 64 bits ; un
+ * dernier mot incomplet est complété par des zéros, comme dans le fichier.
+ */
+static uint64_t sommer( uint64_t somme, const void * donnees, uint64_t taille ){
+	const unsigned char * octets = donnees;
+	uint64_t i;
+	for( i=0; i<taille; i+=8 ){
+		uint64_t mot = 0;
+		memcpy( &mot, octets + i, taille - i < 8 ? taille - i : 8 );
+		somme = ( somme ^ mot ) * UINT64_C(0x100000001B3);
+	}
+	return somme;
+}
+
+/*
+ * Calcule la somme de contrôle de l'en-tête, son champ 'somme' compté comme
+ * nul.
+ */
+static uint64_t sommer_entete( const Entete * entete ){
+	Entete copie = *entete;
+	copie.somme = 0;
+	return sommer( UINT64_C(0xCBF29CE484222325), &copie, sizeof(Entete) );
+}
+
+int sauver_automate( const Automate * automate, const char * fichier ){
+	Automate_indexe * index = indexer_automate( automate );
+	int res = sauver_automate_indexe( index, fichier );
+	liberer_automate_indexe( index );
+	return res;
+}
+
+int sauver_automate_indexe( Automate_indexe * index, const char * fichier ){
+	static const char zeros[8];
+	const void * tableaux[NB_TABLEAUX];
+	uint64_t tailles[NB_TABLEAUX];
+	Entete entete;
+	int i;
+
+	indexer_inverse( index );
+	tableaux[TABLEAU_ETATS] = index->etats;
+	tableaux[TABLEAU_DEBUT] = index->debut;
+	tableaux[TABLEAU_FINS] = index->fins;
+	tableaux[TABLEAU_INITIAUX] = index->initiaux;
+	tableaux[TABLEAU_FINAUX] = index->finaux;
+	tableaux[TABLEAU_LISTE_FINAUX] = index->liste_finaux;
+	tableaux[TABLEAU_EST_INITIAL] = index->est_initial;
+	tableaux[TABLEAU_DEBUT_INVERSE] = index->debut_inverse;
+	tableaux[TABLEAU_ORIGINES] = index->origines;
+
+	memset( &entete, 0, sizeof(Entete) );
+	memcpy( entete.magie, MAGIE_FORMAT_AUTOMATE, sizeof(entete.magie) );
+	entete.version = VERSION_FORMAT_AUTOMATE;
+	entete.boutisme = BOUTISME;
+	entete.taille_int = sizeof(int);
+	entete.nb_etats = index->nb_etats;
+	entete.nb_lettres = index->nb_lettres;
+	entete.nb_transitions = index->nb_transitions;
+	entete.nb_initiaux = index->nb_initiaux;
+	entete.nb_finaux = index->nb_finaux;
+	memcpy( entete.lettres, index->lettres, index->nb_lettres );
+	memcpy( entete.indice_lettre, index->indice_lettre, sizeof(entete.indice_lettre) );
+
+	tailles_tableaux( &entete, tailles );
+	entete.taille = sizeof(Entete);
+	for( i=0; i<NB_TABLEAUX; i++ ){
+		entete.positions[i] = entete.taille;
+		entete.taille += arrondir( tailles[i] );
+	}
+	entete.somme = sommer_entete( &entete );
+	for( i=0; i<NB_TABLEAUX; i++ ){
+		entete.somme = sommer( entete.somme, tableaux[i], tailles[i] );
+	}
+
+	FILE * f = fopen( fichier, "wb" );
+	if( ! f ) return 0;
+	int ok = fwrite( &entete, sizeof(Entete), 1, f ) == 1;
+	for( i=0; ok && i<NB_TABLEAUX; i++ ){
+		uint64_t bourrage = arrondir( tailles[i] ) - tailles[i];
+		ok = ( tailles[i] == 0 || fwrite( tableaux[i], tailles[i], 1, f ) == 1 )
+			&& ( bourrage == 0 || fwrite( zeros, bourrage, 1, f ) == 1 );
+	}
+	if( fclose( f ) != 0 ) ok = 0;
+	return ok;
+}
+
+/*
+ * Renvoie 1 si l'en-tête est celui d'un fichier valide de la taille donnée.
+ */
+static int entete_valide( const Entete * entete, uint64_t taille ){
+	uint64_t tailles[NB_TABLEAUX];
+	int i;
+	if(
+		memcmp( entete->magie, MAGIE_FORMAT_AUTOMATE, sizeof(entete->magie) ) != 0
+		|| entete->version != VERSION_FORMAT_AUTOMATE
+		|| entete->boutisme != BOUTISME
+		|| entete->taille_int != sizeof(int)
+		|| entete->taille != taille
+		|| entete->nb_etats < 0 || entete->nb_lettres < 0
+		|| entete->nb_lettres > NB_LETTRES_MAX
+		|| entete->nb_transitions < 0
+		|| entete->nb_initiaux < 0 || entete->nb_initiaux > entete->nb_etats
+		|| entete->nb_finaux < 0 || entete->nb_finaux > entete->nb_etats
+	){
+		return 0;
+	}
+	// L'indice d'une lettre sert à lire debut[] : il doit être dans les 
+	// bornes et désigner cette lettre.
+	for( i=0; i<NB_LETTRES_MAX; i++ ){
+		int indice = entete->indice_lettre[i];
+		if(
+			indice < -1 || indice >= entete->nb_lettres
+			|| ( indice >= 0 && (unsigned char) entete->lettres[indice] != i )
+		){
+			return 0;
+		}
+	}
+	for( i=0; i<entete->nb_lettres; i++ ){
+		if( entete->indice_lettre[(unsigned char) entete->lettres[i]] != i ){
+			return 0;
+		}
+	}
+	tailles_tableaux( entete, tailles );
+	for( i=0; i<NB_TABLEAUX; i++ ){
+		uint64_t position = entete->positions[i];
+		if(
+			position % 8 != 0 || position < sizeof(Entete)
+			|| position > taille || tailles[i] > taille - position
+		){
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/*
+ * Vérifie en temps constant que les bornes des deux index CSR sont 
+ * cohérentes avec le nombre de transitions. Cela ne remplace pas la somme de
+ * contrôle : voir verifier_automate_charge().
+ */
+static int bornes_valides( const Entete * entete, const unsigned char * octets ){
+	uint64_t nb_cases = (uint64_t) entete->nb_etats * entete->nb_lettres;
+	const int * debut = (const int *) ( octets + entete->positions[TABLEAU_DEBUT] );
+	const int * debut_inverse =
+		(const int *) ( octets + entete->positions[TABLEAU_DEBUT_INVERSE] );
+	return
+		debut[0] == 0 && debut[nb_cases] == entete->nb_transitions
+		&& debut_inverse[0] == 0
+		&& debut_inverse[nb_cases] == entete->nb_transitions;
+}
+
+Automate_charge * charger_automate( const char * fichier ){
+	struct stat etat;
+	int fd = open( fichier, O_RDONLY );
+	if( fd < 0 ) return NULL;
+	if( fstat( fd, &etat ) != 0 || (uint64_t) etat.st_size < sizeof(Entete) ){
+		close( fd );
+		return NULL;
+	}
+	void * projection = mmap( NULL, etat.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+	close( fd );
+	if( projection == MAP_FAILED ) return NULL;
+
+	const Entete * entete = projection;
+	if(
+		! entete_valide( entete, etat.st_size )
+		|| ! bornes_valides( entete, projection )
+	){
+		munmap( projection, etat.st_size );
+		return NULL;
+	}
+
+	Automate_charge * res = xmalloc( sizeof(Automate_charge) );
+	const unsigned char * octets = projection;
+	const uint64_t * positions = entete->positions;
+	Automate_indexe * index = &res->index;
+	res->projection = projection;
+	res->taille = etat.st_size;
+
+	index->nb_etats = entete->nb_etats;
+	index->nb_lettres = entete->nb_lettres;
+	index->nb_transitions = entete->nb_transitions;
+	index->nb_initiaux = entete->nb_initiaux;
+	index->nb_finaux = entete->nb_finaux;
+	memcpy( index->lettres, entete->lettres, sizeof(index->lettres) );
+	memcpy( index->indice_lettre, entete->indice_lettre, sizeof(index->indice_lettre) );
+	// La projection est en lecture seule : l'automate indexé ne doit jamais
+	// être modifié.
+	index->etats = (int *) ( octets + positions[TABLEAU_ETATS] );
+	index->debut = (int *) ( octets + positions[TABLEAU_DEBUT] );
+	index->fins = (int *) ( octets + positions[TABLEAU_FINS] );
+	index->initiaux = (int *) ( octets + positions[TABLEAU_INITIAUX] );
+	index->finaux = (unsigned char *) ( octets + positions[TABLEAU_FINAUX] );
+	index->liste_finaux = (int *) ( octets + positions[TABLEAU_LISTE_FINAUX] );
+	index->est_initial = (unsigned char *) ( octets + positions[TABLEAU_EST_INITIAL] );
+	index->debut_inverse = (int *) ( octets + positions[TABLEAU_DEBUT_INVERSE] );
+	index->origines = (int *) ( octets + positions[TABLEAU_ORIGINES] );
+	return res;
+}
+
+void liberer_automate_charge( Automate_charge * automate ){
+	assert( automate );
+	munmap( (void *) automate->projection, automate->taille );
+	xfree( automate );
+}
+
+const Automate_indexe * index_automate_charge( const Automate_charge * automate ){
+	return &automate->index;
+}
+
+/*
+ * Renvoie 1 si tous les indices rangés dans les tableaux sont dans leurs 
+ * bornes, en un parcours de chaque tableau.
+ */
+static int contenu_valide( const Automate_indexe * index ){
+	long nb_cases = (long) index->nb_etats * index->nb_lettres;
+	long i;
+	for( i=1; i<index->nb_etats; i++ ){
+		if( index->etats[i-1] >= index->etats[i] ) return 0;
+	}
+	for( i=0; i<nb_cases; i++ ){
+		if(
+			index->debut[i] > index->debut[i+1]
+			|| index->debut_inverse[i] > index->debut_inverse[i+1]
+		){
+			return 0;
+		}
+	}
+	for( i=0; i<index->nb_transitions; i++ ){
+		if(
+			index->fins[i] < 0 || index->fins[i] >= index->nb_etats
+			|| index->origines[i] < 0 || index->origines[i] >= index->nb_etats
+		){
+			return 0;
+		}
+	}
+	for( i=0; i<index->nb_initiaux; i++ ){
+		if( index->initiaux[i] < 0 || index->initiaux[i] >= index->nb_etats ){
+			return 0;
+		}
+	}
+	for( i=0; i<index->nb_finaux; i++ ){
+		if(
+			index->liste_finaux[i] < 0
+			|| index->liste_finaux[i] >= index->nb_etats
+		){
+			return 0;
+		}
+	}
+	return 1;
+}
+
+int verifier_automate_charge( const Automate_charge * automate ){
+	const Entete * entete = (const Entete *) automate->projection;
+	uint64_t somme = sommer(
+		sommer_entete( entete ), automate->projection + sizeof(Entete),
+		automate->taille - sizeof(Entete)
+	);
+	return somme == entete->somme && contenu_valide( &automate->index );
+}
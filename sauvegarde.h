@@ -0,0 +1,131 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2014, 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file sauvegarde.h */
+
+#ifndef __SAUVEGARDE_H__
+#define __SAUVEGARDE_H__
+
+#include "automate.h"
+#include "automate_compile.h"
+
+#pragma GCC visibility push(default)
+
+/**
+ * @brief Version du format binaire écrit par sauver_automate().
+ */
+#define VERSION_FORMAT_AUTOMATE 2
+
+/**
+ * @brief Le type d'un automate chargé depuis un fichier binaire.
+ *
+ * Le fichier contient l'automate indexé (voir Automate_indexe), index
+ * inverse compris, tel qu'il est rangé en mémoire : un en-tête qui donne
+ * les tailles, l'alphabet et la position de chaque tableau, puis les
+ * tableaux eux-mêmes, alignés sur 8 octets. Le chargement projette le
+ * fichier en mémoire (mmap) et fait pointer les tableaux de l'automate
+ * indexé dans cette projection : il ne lit ni ne copie aucun tableau, et
+ * son temps ne dépend pas de la taille de l'automate.
+ *
+ * Le format dépend du boutisme et de la taille des entiers de la machine
+ * qui a écrit le fichier : un fichier écrit sur une autre architecture est
+ * refusé au chargement.
+ */
+typedef struct Automate_charge Automate_charge;
+
+/**
+ * @brief Sauve un automate dans un fichier binaire.
+ *
+ * @param automate Un automate.
+ * @param fichier Le chemin du fichier.
+ * @return 1 si l'automate a été sauvé, 0 en cas d'erreur d'écriture.
+ */
+int sauver_automate( const Automate * automate, const char * fichier );
+
+/**
+ * @brief Sauve un automate indexé dans un fichier binaire.
+ *
+ * L'index inverse est construit s'il ne l'est pas déjà.
+ *
+ * @param index Un automate indexé.
+ * @param fichier Le chemin du fichier.
+ * @return 1 si l'automate a été sauvé, 0 en cas d'erreur d'écriture.
+ */
+int sauver_automate_indexe( Automate_indexe * index, const char * fichier );
+
+/**
+ * @brief Charge un automate sauvé par sauver_automate().
+ *
+ * Le chargement ne vérifie, en temps constant, que l'en-tête (tailles,
+ * positions des tableaux et indices des lettres) et les bornes des index :
+ * la somme de contrôle et le contenu des tableaux ne le sont que par
+ * verifier_automate_charge(). Un automate chargé qui n'a pas été vérifié 
+ * peut contenir des indices hors bornes : il ne doit être utilisé sans 
+ * vérification que si le fichier a été écrit par sauver_automate() et n'a 
+ * pas pu être modifié depuis.
+ *
+ * @param fichier Le chemin du fichier.
+ * @return L'automate chargé, ou NULL si le fichier ne peut pas être ouvert
+ *         ou si son en-tête ou les bornes de ses index ne sont pas valides.
+ */
+Automate_charge * charger_automate( const char * fichier );
+
+/**
+ * @brief Détruit un automate chargé, et libère la projection du fichier.
+ *
+ * @param automate L'automate chargé.
+ */
+void liberer_automate_charge( Automate_charge * automate );
+
+/**
+ * @brief Renvoie l'automate indexé d'un automate chargé.
+ *
+ * Ses tableaux sont en lecture seule, et ne sont valides que tant que
+ * l'automate chargé l'est. Il peut être passé à creer_reconnaisseur_indexe()
+ * ou à miroir_indexe() (sur une copie), mais pas à
+ * liberer_automate_indexe().
+ *
+ * @param automate Un automate chargé.
+ * @return L'automate indexé.
+ */
+const Automate_indexe * index_automate_charge( const Automate_charge * automate );
+
+/**
+ * @brief Renvoie 1 si un automate chargé est intact et cohérent, et 0 sinon.
+ *
+ * La vérification lit tout le fichier, en temps linéaire. Elle calcule la
+ * somme de contrôle de tout le fichier, en-tête compris, puis vérifie que 
+ * tous les indices rangés dans les tableaux (fins, origines, bornes des 
+ * index, initiaux et finaux) sont dans leurs bornes.
+ *
+ * La somme de contrôle détecte les corruptions accidentelles, mais ce n'est
+ * pas une signature : un fichier forgé peut la satisfaire. C'est la 
+ * vérification du contenu qui garantit qu'un automate vérifié se parcourt 
+ * sans accès hors de ses tableaux ; elle ne garantit pas qu'il soit 
+ * l'automate qui a été sauvé.
+ *
+ * @param automate Un automate chargé.
+ * @return 1 ou 0.
+ */
+int verifier_automate_charge( const Automate_charge * automate );
+
+#pragma GCC visibility pop
+
+#endif
@@ -0,0 +1,200 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2014, 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "statistiques.h"
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <time.h>
+
+atomic_int comptage_operations_actif = 0;
+_Thread_local Statistiques_operation compteurs_operations;
+
+// Ces variables sont lues par tous les fils : la fonction de trace est 
+// publiée après son paramètre, et lue avant lui.
+static atomic_int statistiques_demandees = 0;
+static _Atomic( Fonction_trace ) fonction_trace = NULL;
+static void * _Atomic donnees_trace = NULL;
+
+static _Thread_local int profondeur = 0;
+static _Thread_local Statistiques_operation derniere_operation;
+
+static uint64_t horloge_ns(){
+	struct timespec t;
+	clock_gettime( CLOCK_MONOTONIC, &t );
+	return (uint64_t) t.tv_sec * 1000000000u + (uint64_t) t.tv_nsec;
+}
+
+static void mettre_a_jour_comptage(){
+	atomic_store_explicit(
+		&comptage_operations_actif,
+		atomic_load_explicit( &statistiques_demandees, memory_order_relaxed )
+		|| atomic_load_explicit( &fonction_trace, memory_order_relaxed ),
+		memory_order_relaxed
+	);
+}
+
+/*
+ * Renvoie la fonction de trace installée, et son paramètre dans 'data'.
+ */
+static Fonction_trace lire_trace( void ** data ){
+	Fonction_trace trace = atomic_load_explicit(
+		&fonction_trace, memory_order_acquire
+	);
+	*data = atomic_load_explicit( &donnees_trace, memory_order_relaxed );
+	return trace;
+}
+
+void activer_statistiques( int actif ){
+	atomic_store_explicit( &statistiques_demandees, actif, memory_order_relaxed );
+	mettre_a_jour_comptage();
+}
+
+void lire_statistiques_operation( Statistiques_operation * statistiques ){
+	*statistiques = derniere_operation;
+}
+
+void definir_trace( Fonction_trace trace, void * data ){
+	// Le paramètre de l'ancienne trace reste en place après son retrait : un
+	// fil qui vient de lire l'ancienne fonction la rappelle avec lui.
+	atomic_store_explicit( &fonction_trace, NULL, memory_order_release );
+	if( trace ){
+		atomic_store_explicit( &donnees_trace, data, memory_order_relaxed );
+		atomic_store_explicit( &fonction_trace, trace, memory_order_release );
+	}
+	mettre_a_jour_comptage();
+}
+
+Statistiques_operation compteurs_depuis( const Statistiques_operation * depart ){
+	Statistiques_operation s = compteurs_operations;
+	s.nom = NULL;
+	s.etats_visites -= depart->etats_visites;
+	s.transitions_parcourues -= depart->transitions_parcourues;
+	s.operations_ensembles -= depart->operations_ensembles;
+	s.sondes_arbres -= depart->sondes_arbres;
+	s.allocations -= depart->allocations;
+	s.duree_ns = 0;
+	return s;
+}
+
+void ajouter_compteurs_operations( const Statistiques_operation * compteurs ){
+	compteurs_operations.etats_visites += compteurs->etats_visites;
+	compteurs_operations.transitions_parcourues +=
+		compteurs->transitions_parcourues;
+	compteurs_operations.operations_ensembles += compteurs->operations_ensembles;
+	compteurs_operations.sondes_arbres += compteurs->sondes_arbres;
+	compteurs_operations.allocations += compteurs->allocations;
+}
+
+void debut_operation( Mesure_operation * mesure, const char * nom ){
+	mesure->active = atomic_load_explicit(
+		&comptage_operations_actif, memory_order_relaxed
+	);
+	if( ! mesure->active ){
+		return;
+	}
+	mesure->nom = nom;
+	mesure->depart = compteurs_operations;
+	profondeur++;
+	mesure->debut = horloge_ns();
+	void * data;
+	Fonction_trace trace = lire_trace( &data );
+	if( trace ){
+		trace( nom, 'B', mesure->debut, NULL, data );
+	}
+}
+
+void fin_operation( Mesure_operation * mesure ){
+	if( ! mesure->active ){
+		return;
+	}
+	uint64_t fin = horloge_ns();
+	Statistiques_operation s = compteurs_depuis( &mesure->depart );
+	s.nom = mesure->nom;
+	s.duree_ns = fin - mesure->debut;
+	profondeur--;
+	if( profondeur == 0 ){
+		derniere_operation = s;
+	}
+	void * data;
+	Fonction_trace trace = lire_trace( &data );
+	if( trace ){
+		trace( mesure->nom, 'E', fin, &s, data );
+	}
+}
+
+/*
+ * Trace au format JSON de Chrome : un tableau d'événements, les
+ * horodatages étant en microsecondes depuis commencer_trace_chrome().
+ */
+static uint64_t origine_chrome;
+static int premier_evenement_chrome;
+static atomic_int nb_fils_chrome;
+static _Thread_local int numero_fil_chrome = 0;
+
+static void trace_chrome(
+	const char * nom, char phase, uint64_t horodatage_ns,
+	const Statistiques_operation * statistiques, void * data
+){
+	FILE * fichier = (FILE *) data;
+	if( ! numero_fil_chrome ){
+		numero_fil_chrome = atomic_fetch_add( &nb_fils_chrome, 1 ) + 1;
+	}
+	flockfile( fichier );
+	fprintf(
+		fichier, "%s{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,"
+		"\"tid\":%d",
+		premier_evenement_chrome ? "" : ",\n", nom, phase,
+		( horodatage_ns - origine_chrome ) / 1000.0, numero_fil_chrome
+	);
+	if( statistiques ){
+		fprintf(
+			fichier, ",\"args\":{\"etats_visites\":%lu,"
+			"\"transitions_parcourues\":%lu,\"operations_ensembles\":%lu,"
+			"\"sondes_arbres\":%lu,\"allocations\":%lu}",
+			statistiques->etats_visites, statistiques->transitions_parcourues,
+			statistiques->operations_ensembles, statistiques->sondes_arbres,
+			statistiques->allocations
+		);
+	}
+	fputc( '}', fichier );
+	premier_evenement_chrome = 0;
+	funlockfile( fichier );
+}
+
+void commencer_trace_chrome( FILE * fichier ){
+	fputs( "[\n", fichier );
+	premier_evenement_chrome = 1;
+	origine_chrome = horloge_ns();
+	definir_trace( trace_chrome, fichier );
+}
+
+void terminer_trace_chrome( void ){
+	void * data;
+	if( lire_trace( &data ) != trace_chrome ){
+		return;
+	}
+	FILE * fichier = (FILE *) data;
+	definir_trace( NULL, NULL );
+	fputs( "\n]\n", fichier );
+	fflush( fichier );
+}
@@ -0,0 +1,181 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2014, 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file statistiques.h */
+
+#ifndef __STATISTIQUES_H__
+#define __STATISTIQUES_H__
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdatomic.h>
+
+#pragma GCC visibility push(default)
+
+/**
+ * @brief Les compteurs d'une opération.
+ *
+ * Les compteurs sont tenus par fil d'exécution. Ceux d'une opération
+ * comprennent ceux des opérations qu'elle appelle.
+ */
+typedef struct Statistiques_operation {
+	const char * nom; //!< Nom de l'opération.
+	unsigned long etats_visites;
+	unsigned long transitions_parcourues;
+	unsigned long operations_ensembles;
+	unsigned long sondes_arbres; //!< Recherches, insertions et suppressions.
+	unsigned long allocations; //!< Appels à xmalloc() et xrealloc().
+	uint64_t duree_ns; //!< Durée de l'opération, en nanosecondes.
+} Statistiques_operation;
+
+/**
+ * @brief Active (1) ou désactive (0) le comptage des opérations.
+ *
+ * Le comptage est désactivé par défaut. Désactivé, il ne coûte qu'un test
+ * par compteur.
+ *
+ * @param actif 1 ou 0.
+ */
+void activer_statistiques( int actif );
+
+/**
+ * @brief Copie les compteurs de la dernière opération instrumentée terminée
+ *        par le fil d'exécution courant.
+ *
+ * Seules les opérations appelées directement par l'utilisateur sont
+ * retenues : celles qu'elles appellent sont comptées avec elles. Si aucune
+ * opération n'a été mesurée, tous les champs sont nuls.
+ *
+ * @param statistiques La structure qui reçoit les compteurs.
+ */
+void lire_statistiques_operation( Statistiques_operation * statistiques );
+
+/**
+ * @brief Le type d'une fonction de trace.
+ *
+ * La fonction est appelée au début (phase 'B') et à la fin (phase 'E') de
+ * chaque opération instrumentée, y compris des opérations imbriquées.
+ * À la fin, 'statistiques' contient les compteurs de l'opération ; au
+ * début, il vaut NULL. L'horodatage est celui de CLOCK_MONOTONIC.
+ */
+typedef void (* Fonction_trace)(
+	const char * nom, char phase, uint64_t horodatage_ns,
+	const Statistiques_operation * statistiques, void * data
+);
+
+/**
+ * @brief Installe une fonction de trace, ou la retire si 'trace' vaut NULL.
+ *
+ * Tant qu'une fonction de trace est installée, le comptage est actif.
+ * La fonction peut être appelée depuis plusieurs fils d'exécution à la fois.
+ * Un fil qui commence une opération pendant que la trace est remplacée peut
+ * appeler l'ancienne fonction avec le nouveau paramètre : on ne remplace une
+ * trace par une autre que lorsqu'aucune opération n'est en cours.
+ *
+ * @param trace La fonction de trace, ou NULL.
+ * @param data Le paramètre transmis à la fonction de trace.
+ */
+void definir_trace( Fonction_trace trace, void * data );
+
+/**
+ * @brief Installe une fonction de trace qui écrit les événements dans un
+ *        fichier, au format JSON des traces de Chrome (chrome://tracing,
+ *        Perfetto).
+ *
+ * Les compteurs de chaque opération figurent dans les arguments de son
+ * événement de fin. La trace doit être terminée par terminer_trace_chrome().
+ *
+ * @param fichier Le fichier, ouvert en écriture.
+ */
+void commencer_trace_chrome( FILE * fichier );
+
+/**
+ * @brief Retire la fonction de trace installée par commencer_trace_chrome()
+ *        et termine le tableau JSON. Le fichier n'est pas fermé.
+ */
+void terminer_trace_chrome( void );
+
+/**
+ * @brief Mesure d'une opération en cours, à usage interne de la librairie.
+ */
+typedef struct Mesure_operation {
+	const char * nom;
+	int active;
+	Statistiques_operation depart;
+	uint64_t debut;
+} Mesure_operation;
+
+/**
+ * @brief Commence la mesure d'une opération.
+ *
+ * @param mesure La mesure, à passer ensuite à fin_operation().
+ * @param nom Le nom de l'opération (une chaîne constante).
+ */
+void debut_operation( Mesure_operation * mesure, const char * nom );
+
+/**
+ * @brief Termine la mesure d'une opération.
+ *
+ * @param mesure La mesure passée à debut_operation().
+ */
+void fin_operation( Mesure_operation * mesure );
+
+/**
+ * @brief Renvoie les compteurs du fil d'exécution courant accumulés depuis
+ *        'depart', une copie antérieure de compteurs_operations.
+ *
+ * Les compteurs étant tenus par fil, une opération qui lance des fils de
+ * travail relève leurs compteurs avec cette fonction à la fin de chaque 
+ * fil, puis les ajoute aux siens avec ajouter_compteurs_operations() après
+ * la jointure.
+ *
+ * @param depart Les compteurs au début du travail.
+ * @return Les compteurs accumulés depuis.
+ */
+Statistiques_operation compteurs_depuis( const Statistiques_operation * depart );
+
+/**
+ * @brief Ajoute des compteurs à ceux du fil d'exécution courant.
+ *
+ * @param compteurs Les compteurs à ajouter (voir compteurs_depuis()).
+ */
+void ajouter_compteurs_operations( const Statistiques_operation * compteurs );
+
+/** @brief Vaut 1 lorsque le comptage est actif. */
+extern atomic_int comptage_operations_actif;
+
+/** @brief Les compteurs cumulés du fil d'exécution courant. */
+extern _Thread_local Statistiques_operation compteurs_operations;
+
+/**
+ * @brief Ajoute n au compteur 'champ' du fil d'exécution courant, si le
+ *        comptage est actif.
+ */
+#define COMPTER_OPERATION( champ, n ) do { \
+	if( atomic_load_explicit( \
+		&comptage_operations_actif, memory_order_relaxed \
+	) ){ \
+		compteurs_operations.champ += (n); \
+	} \
+} while(0)
+
+#pragma GCC visibility pop
+
+#endif
@@ -18,15 +18,19 @@
  *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#define ETIQUETTE_ALLOCATIONS ETIQUETTE_TABLE
+
 #include "table.h"
 #include "outils.h"
 #include "fifo.h"
 #include "avl.h"
+#include "statistiques.h"
 
 #include <assert.h>
 
 #include <search.h>
 #include <stdlib.h>
+#include <stdatomic.h>
 
 typedef struct Table_association {
 	void (*supprimer_cle)(intptr_t cle);
@@ -41,6 +45,7 @@ struct Table {
 	intptr_t (*copier_cle)( const intptr_t cle );
 	void (*supprimer_cle)(intptr_t cle);
 	struct avl_table * root;
+	atomic_int nb_references;
 };
 
 
@@ -114,28 +119,164 @@ void supprimer_table_association( Table_association * asso ){
 	xfree(asso);
 }
 
+/*
+ * Initialise une association de recherche, sur la pile : la clé n'est pas
+ * copiée, car l'association ne sert qu'à la comparaison.
+ */
+static void initialiser_sonde(
+	Table_association * sonde, const Table* table, const intptr_t cle
+){
+	sonde->cle = cle;
+	sonde->valeur = (intptr_t) NULL;
+	sonde->supprimer_cle = table->supprimer_cle;
+	sonde->copier_cle = table->copier_cle;
+	sonde->comparer_cle = table->comparer_cle;
+}
+
+/*
+ * Les noeuds des arbres AVL passent par xmalloc() et xfree(), afin d'être
+ * comptés dans la comptabilité des allocations.
+ */
+static void* allouer_noeud_avl(
+	struct libavl_allocator * allocateur, size_t taille
+){
+	return xmalloc( taille );
+}
+
+static void liberer_noeud_avl(
+	struct libavl_allocator * allocateur, void * bloc
+){
+	xfree( bloc );
+}
+
+static struct libavl_allocator allocateur_avl = {
+	allouer_noeud_avl, liberer_noeud_avl
+};
+
 Table* creer_table(
 	int (*comparer_cle)( const intptr_t cle1, const intptr_t cle2 ),
 	intptr_t (*copier_cle)( const intptr_t cle ),
 	void (*supprimer_cle)(intptr_t cle)
 ){
 	Table* res = xmalloc( sizeof(Table) );
-	res->root = avl_create ( compare_table_association, NULL, NULL );
+	res->root = avl_create ( compare_table_association, NULL, &allocateur_avl );
 
 	res->supprimer_cle = supprimer_cle;
 	res->comparer_cle = comparer_cle;
 	res->copier_cle = copier_cle;
+	atomic_init( &res->nb_references, 1 );
+	return res;
+}
+
+/*
+ * Construit l'arbre AVL équilibré des clés cles[debut], ..., cles[fin-1], 
+ * et écrit sa hauteur dans 'hauteur'. La clé du milieu est à la racine : les
+ * deux sous-arbres ont la même taille à un près, donc leurs hauteurs 
+ * diffèrent d'au plus un.
+ */
+static struct avl_node * construire_arbre_avl(
+	const Table * table, const intptr_t * cles, const intptr_t * valeurs,
+	int debut, int fin, int * hauteur
+){
+	if( debut >= fin ){
+		*hauteur = 0;
+		return NULL;
+	}
+	int milieu = debut + ( fin - debut ) / 2;
+	int hauteur_gauche, hauteur_droite;
+	struct avl_node * noeud = allouer_noeud_avl(
+		&allocateur_avl, sizeof( struct avl_node )
+	);
+	noeud->avl_link[0] = construire_arbre_avl(
+		table, cles, valeurs, debut, milieu, &hauteur_gauche
+	);
+	noeud->avl_data = creer_table_association(
+		table, cles[milieu], valeurs ? valeurs[milieu] : (intptr_t) NULL
+	);
+	noeud->avl_link[1] = construire_arbre_avl(
+		table, cles, valeurs, milieu + 1, fin, &hauteur_droite
+	);
+	noeud->avl_balance = hauteur_droite - hauteur_gauche;
+	*hauteur = 1 + (
+		hauteur_gauche > hauteur_droite ? hauteur_gauche : hauteur_droite
+	);
+	return noeud;
+}
+
+Table* creer_table_depuis_cles_triees(
+	const intptr_t * cles, const intptr_t * valeurs, int nb_cles,
+	int (*comparer_cle)( const intptr_t cle1, const intptr_t cle2 ),
+	intptr_t (*copier_cle)( const intptr_t cle ),
+	void (*supprimer_cle)(intptr_t cle)
+){
+	Table* res = creer_table( comparer_cle, copier_cle, supprimer_cle );
+	int hauteur;
+	res->root->avl_root = construire_arbre_avl(
+		res, cles, valeurs, 0, nb_cles, &hauteur
+	);
+	res->root->avl_count = nb_cles;
+	return res;
+}
+
+static void* copier_table_association_avl( void* asso, void* param ){
+	return copier_table_association( (Table_association*) asso );
+}
+
+Table* copier_table(
+	const Table* table, intptr_t (*copier_valeur)( const intptr_t valeur )
+){
+	Table* res = xmalloc( sizeof(Table) );
+	*res = *table;
+	atomic_init( &res->nb_references, 1 );
+	res->root = avl_copy(
+		table->root, copier_table_association_avl,
+		supprimer_table_association2, &allocateur_avl
+	);
+	if( res->root == NULL ){
+		ERREUR( "Espace insuffisant" );
+	}
+	if( copier_valeur ){
+		struct avl_traverser traverser;
+		void * item;
+		avl_t_init( &traverser, res->root );
+		while( (item = avl_t_next( &traverser )) ){
+			Table_association* asso = (Table_association *) item;
+			asso->valeur = copier_valeur( asso->valeur );
+		}
+	}
 	return res;
 }
 
+Table* partager_table( const Table* table ){
+	// Le compteur de références ne fait pas partie du contenu de la table.
+	Table* res = (Table*) table;
+	atomic_fetch_add_explicit( &res->nb_references, 1, memory_order_relaxed );
+	return res;
+}
+
+int table_est_partagee( const Table* table ){
+	return atomic_load_explicit(
+		&( (Table*) table )->nb_references, memory_order_acquire
+	) > 1;
+}
+
 void liberer_table( Table* table ){
 	assert( table );
+	if(
+		atomic_fetch_sub_explicit(
+			&table->nb_references, 1, memory_order_acq_rel
+		) > 1
+	){
+		return;
+	}
 	avl_destroy ( table->root, supprimer_table_association2 );
 	xfree( table );
 }
 
-void add_table( Table* table, const intptr_t cle, intptr_t valeur ) {
+int add_table( Table* table, const intptr_t cle, intptr_t valeur ) {
+	assert( ! table_est_partagee( table ) );
 	Table_association* asso = creer_table_association(table, cle, valeur);
+	COMPTER_OPERATION( sondes_arbres, 1 );
 	void* val = avl_probe ( table->root, (void*) asso );
 	if( val == NULL ){
 		ERREUR( "Espace insuffisant" );
@@ -144,25 +285,22 @@ void add_table( Table* table, const intptr_t cle, intptr_t valeur ) {
 	if( asso_tree != asso  ){
 		supprimer_table_association( asso );
 		asso_tree->valeur = valeur;
+		return 0;
 	}
+	return 1;
 }
 
 intptr_t delete_table( Table* table, intptr_t cle ){
+	assert( ! table_est_partagee( table ) );
 	intptr_t valeur = (intptr_t) NULL;
-	Table_association* asso_tree = NULL;
-	Table_association* asso = creer_table_association(
-		table, cle, (intptr_t) NULL
-	);
-	void* val = avl_find( table->root, (void*) asso );
-	if( val ){
-		asso_tree = ( Table_association* ) val; 
+	Table_association sonde;
+	initialiser_sonde( &sonde, table, cle );
+	COMPTER_OPERATION( sondes_arbres, 1 );
+	Table_association* asso_tree = avl_delete( table->root, (void*) &sonde );
+	if( asso_tree ){
 		valeur = asso_tree->valeur;
-	}
-	avl_delete( table->root, (void*) asso );
-	if(asso_tree){
 		supprimer_table_association( asso_tree );
 	}
-	supprimer_table_association( asso );
 	return valeur;
 }
 
@@ -199,8 +337,9 @@ void pour_toute_valeur_table(
 }
 
 void vider_table( Table* table ){
+	assert( ! table_est_partagee( table ) );
 	avl_destroy ( table->root, supprimer_table_association2 );
-	table->root = avl_create ( compare_table_association, NULL, NULL );
+	table->root = avl_create ( compare_table_association, NULL, &allocateur_avl );
 }
 
 typedef struct {
@@ -240,11 +379,10 @@ void print_table(
 
 Table_iterateur trouver_table( const Table* table, intptr_t cle ){
 	Table_iterateur it;
-	Table_association* asso = creer_table_association(
-		table, cle, (intptr_t) NULL
-	);
-	avl_t_find( &it, table->root, (void*) asso );
-	supprimer_table_association( asso );
+	Table_association sonde;
+	initialiser_sonde( &sonde, table, cle );
+	COMPTER_OPERATION( sondes_arbres, 1 );
+	avl_t_find( &it, table->root, (void*) &sonde );
 	return it;
 }
 
@@ -276,15 +414,6 @@ Table_iterateur iterateur_precedent_table( Table_iterateur iterateur ){
 	return iterateur;
 }
 
-int taille_table( Table* t ){
-	int res = 0;
-	Table_iterateur it1;
-	for(
-		it1 = premier_iterateur_table( t );
-		! iterateur_est_vide( it1 );
-		it1 = iterateur_suivant_table( it1 )
-	){
-		res += 1;
-	}
-	return res;
-};
+int taille_table( const Table* t ){
+	return avl_count( t->root );
+}
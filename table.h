@@ -26,6 +26,8 @@
 #include <stdint.h>
 #include "avl.h"
 
+#pragma GCC visibility push(default)
+
 /**
  * @brief Définit le type d'une table.
  * 
@@ -150,6 +152,22 @@ Table* creer_table(
 	void (*supprimer_cle)(intptr_t cle)
 );
 
+/**
+ * @brief
+ * Crée une table qui associe valeurs[i] à cles[i], pour i de 0 à nb_cles-1.
+ * Les clés doivent être strictement croissantes pour 'comparer_cle'. L'arbre
+ * de la table est alors construit directement, sans insérer les 
+ * associations une à une : sa complexité est linéaire. Si 'valeurs' vaut 
+ * NULL, toutes les valeurs sont NULL. Les autres paramètres sont ceux de 
+ * creer_table().
+ */
+Table* creer_table_depuis_cles_triees(
+	const intptr_t * cles, const intptr_t * valeurs, int nb_cles,
+	int (*comparer_cle)( const intptr_t cle1, const intptr_t cle2),
+	intptr_t (*copier_cle)( const intptr_t cle ),
+	void (*supprimer_cle)(intptr_t cle)
+);
+
 /**
  * @brief
  * Cette fonction détruit une table. La mémoire qui a été allouée par la table 
@@ -160,6 +178,39 @@ Table* creer_table(
  */
 void liberer_table( Table* table );
 
+/**
+ * @brief
+ * Renvoie une copie de la table passée en paramètre.
+ * La copie est faite en un seul parcours de l'arbre de la table, sans 
+ * réinsérer les associations une à une : sa complexité est linéaire.
+ * Les clés sont copiées avec la fonction de copie de clé de la table.
+ * Si 'copier_valeur' est différent de NULL, les valeurs de la copie sont
+ * obtenues en appelant 'copier_valeur' sur les valeurs de la table ;
+ * sinon, les valeurs sont recopiées telles quelles.
+ */
+Table* copier_table(
+	const Table* table, intptr_t (*copier_valeur)( const intptr_t valeur )
+);
+
+/**
+ * @brief
+ * Renvoie une nouvelle référence vers la table passée en paramètre, en temps
+ * constant. Chaque référence doit être abandonnée avec liberer_table().
+ * Tant qu'une table est partagée, elle ne doit pas être modifiée : pour
+ * écrire, il faut d'abord en faire une copie (voir copier_table()) et 
+ * abandonner la référence partagée. C'est ce que font les ensembles, qui sont
+ * ainsi copiés à l'écriture. Le compteur de références est atomique : les
+ * références d'une même table peuvent être prises et abandonnées par des 
+ * fils différents.
+ */
+Table* partager_table( const Table* table );
+
+/**
+ * @brief
+ * Renvoie 1 si la table possède plusieurs références, et 0 sinon.
+ */
+int table_est_partagee( const Table* table );
+
 /**
  * @brief
  * La fonction add_table() ajoute une association entre une clé et une valeur.
@@ -173,8 +224,9 @@ void liberer_table( Table* table );
  * l'ancienne valeur associée à la clé est remplacée par la nouvelle passée en 
  * paramètre à add_table().
  *
+ * La fonction renvoie 1 si la clé a été ajoutée, et 0 si elle existait déjà.
  */
-void add_table( Table* table, const intptr_t cle, const intptr_t valeur );
+int add_table( Table* table, const intptr_t cle, const intptr_t valeur );
 
 
 /**
@@ -319,8 +371,10 @@ intptr_t get_valeur( Table_iterateur it );
 
 /**
  * @brief
- * Renvoie la taille de la table.
+ * Renvoie la taille de la table, en temps constant.
  */
-int taille_table( Table* t );
+int taille_table( const Table* t );
+
+#pragma GCC visibility pop
 
 #endif
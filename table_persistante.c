@@ -0,0 +1,362 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define ETIQUETTE_ALLOCATIONS ETIQUETTE_TABLE
+
+#include "table_persistante.h"
+#include "outils.h"
+
+#include <stdlib.h>
+#include <stdatomic.h>
+
+#include <assert.h>
+
+/*
+ * Un noeud n'est modifié sur place que si la version qui le modifie en est
+ * le seul propriétaire (compteur de références égal à 1). Sinon, il est 
+ * d'abord copié : c'est la copie de chemin.
+ */
+struct Noeud_table_persistante {
+	intptr_t cle;
+	intptr_t valeur;
+	Noeud_table_persistante * gauche;
+	Noeud_table_persistante * droite;
+	int hauteur;
+	int taille;
+	atomic_int nb_references;
+};
+
+struct Table_persistante {
+	Noeud_table_persistante * racine;
+	intptr_t (*partager_valeur)( const intptr_t valeur );
+	void (*liberer_valeur)( intptr_t valeur );
+};
+
+typedef Noeud_table_persistante Noeud;
+
+static int hauteur( const Noeud * noeud ){
+	return noeud ? noeud->hauteur : 0;
+}
+
+static int taille( const Noeud * noeud ){
+	return noeud ? noeud->taille : 0;
+}
+
+static void mettre_a_jour( Noeud * noeud ){
+	int hg = hauteur( noeud->gauche );
+	int hd = hauteur( noeud->droite );
+	noeud->hauteur = 1 + ( hg > hd ? hg : hd );
+	noeud->taille = 1 + taille( noeud->gauche ) + taille( noeud->droite );
+}
+
+/*
+ * Crée un noeud. Le noeud créé prend possession de la valeur et des 
+ * références 'gauche' et 'droite'.
+ */
+static Noeud * creer_noeud(
+	intptr_t cle, intptr_t valeur, Noeud * gauche, Noeud * droite
+){
+	Noeud * res = xmalloc( sizeof(Noeud) );
+	res->cle = cle;
+	res->valeur = valeur;
+	res->gauche = gauche;
+	res->droite = droite;
+	mettre_a_jour( res );
+	atomic_init( &res->nb_references, 1 );
+	return res;
+}
+
+static Noeud * partager_noeud( Noeud * noeud ){
+	if( noeud ){
+		atomic_fetch_add_explicit(
+			&noeud->nb_references, 1, memory_order_relaxed
+		);
+	}
+	return noeud;
+}
+
+static void liberer_noeud( const Table_persistante * table, Noeud * noeud ){
+	while(
+		noeud
+		&& atomic_fetch_sub_explicit(
+			&noeud->nb_references, 1, memory_order_acq_rel
+		) == 1
+	){
+		Noeud * droite = noeud->droite;
+		liberer_noeud( table, noeud->gauche );
+		if( table->liberer_valeur ){
+			table->liberer_valeur( noeud->valeur );
+		}
+		xfree( noeud );
+		noeud = droite;
+	}
+}
+
+/*
+ * Renvoie un noeud de même contenu dont l'appelant est le seul 
+ * propriétaire. La fonction prend possession de la référence 'noeud'.
+ */
+static Noeud * rendre_unique( const Table_persistante * table, Noeud * noeud ){
+	if(
+		atomic_load_explicit( &noeud->nb_references, memory_order_acquire )
+		== 1
+	){
+		return noeud;
+	}
+	Noeud * copie = creer_noeud(
+		noeud->cle,
+		table->partager_valeur ?
+			table->partager_valeur( noeud->valeur ) : noeud->valeur,
+		partager_noeud( noeud->gauche ), partager_noeud( noeud->droite )
+	);
+	liberer_noeud( table, noeud );
+	return copie;
+}
+
+/*
+ * Les rotations s'appliquent à un noeud dont on est le seul propriétaire ;
+ * l'enfant qui remonte est rendu unique avant d'être modifié.
+ */
+static Noeud * rotation_droite( const Table_persistante * table, Noeud * noeud ){
+	Noeud * gauche = rendre_unique( table, noeud->gauche );
+	noeud->gauche = gauche->droite;
+	mettre_a_jour( noeud );
+	gauche->droite = noeud;
+	mettre_a_jour( gauche );
+	return gauche;
+}
+
+static Noeud * rotation_gauche( const Table_persistante * table, Noeud * noeud ){
+	Noeud * droite = rendre_unique( table, noeud->droite );
+	noeud->droite = droite->gauche;
+	mettre_a_jour( noeud );
+	droite->gauche = noeud;
+	mettre_a_jour( droite );
+	return droite;
+}
+
+/*
+ * Rééquilibre un noeud unique dont les sous-arbres sont des arbres AVL 
+ * dont les hauteurs diffèrent d'au plus 2.
+ */
+static Noeud * equilibrer( const Table_persistante * table, Noeud * noeud ){
+	mettre_a_jour( noeud );
+	if( hauteur( noeud->gauche ) > hauteur( noeud->droite ) + 1 ){
+		if( hauteur( noeud->gauche->gauche ) < hauteur( noeud->gauche->droite ) ){
+			noeud->gauche = rotation_gauche(
+				table, rendre_unique( table, noeud->gauche )
+			);
+		}
+		return rotation_droite( table, noeud );
+	}
+	if( hauteur( noeud->droite ) > hauteur( noeud->gauche ) + 1 ){
+		if( hauteur( noeud->droite->droite ) < hauteur( noeud->droite->gauche ) ){
+			noeud->droite = rotation_droite(
+				table, rendre_unique( table, noeud->droite )
+			);
+		}
+		return rotation_gauche( table, noeud );
+	}
+	return noeud;
+}
+
+static Noeud * inserer(
+	const Table_persistante * table, Noeud * noeud,
+	intptr_t cle, intptr_t valeur
+){
+	if( ! noeud ){
+		return creer_noeud( cle, valeur, NULL, NULL );
+	}
+	noeud = rendre_unique( table, noeud );
+	if( cle < noeud->cle ){
+		noeud->gauche = inserer( table, noeud->gauche, cle, valeur );
+	}else if( cle > noeud->cle ){
+		noeud->droite = inserer( table, noeud->droite, cle, valeur );
+	}else{
+		if( table->liberer_valeur ){
+			table->liberer_valeur( noeud->valeur );
+		}
+		noeud->valeur = valeur;
+		return noeud;
+	}
+	return equilibrer( table, noeud );
+}
+
+Table_persistante * creer_table_persistante(
+	intptr_t (*partager_valeur)( const intptr_t valeur ),
+	void (*liberer_valeur)( intptr_t valeur )
+){
+	Table_persistante * res = xmalloc( sizeof(Table_persistante) );
+	res->racine = NULL;
+	res->partager_valeur = partager_valeur;
+	res->liberer_valeur = liberer_valeur;
+	return res;
+}
+
+Table_persistante * partager_table_persistante(
+	const Table_persistante * table
+){
+	Table_persistante * res = xmalloc( sizeof(Table_persistante) );
+	*res = *table;
+	partager_noeud( res->racine );
+	return res;
+}
+
+/*
+ * Copie un sous-arbre noeud par noeud, avec la même forme : l'arbre copié 
+ * est déjà équilibré, sans aucune rotation.
+ */
+static Noeud * copier_noeud(
+	const Noeud * noeud, intptr_t (*copier_valeur)( const intptr_t valeur )
+){
+	if( ! noeud ){
+		return NULL;
+	}
+	Noeud * gauche = copier_noeud( noeud->gauche, copier_valeur );
+	Noeud * droite = copier_noeud( noeud->droite, copier_valeur );
+	return creer_noeud(
+		noeud->cle,
+		copier_valeur ? copier_valeur( noeud->valeur ) : noeud->valeur,
+		gauche, droite
+	);
+}
+
+Table_persistante * copier_table_persistante(
+	const Table_persistante * table,
+	intptr_t (*copier_valeur)( const intptr_t valeur )
+){
+	Table_persistante * res = xmalloc( sizeof(Table_persistante) );
+	*res = *table;
+	res->racine = copier_noeud(
+		table->racine,
+		copier_valeur ? copier_valeur : table->partager_valeur
+	);
+	return res;
+}
+
+void liberer_table_persistante( Table_persistante * table ){
+	if( table ){
+		liberer_noeud( table, table->racine );
+		xfree( table );
+	}
+}
+
+void ajouter_table_persistante(
+	Table_persistante * table, intptr_t cle, intptr_t valeur
+){
+	table->racine = inserer( table, table->racine, cle, valeur );
+}
+
+static const Noeud * chercher( const Noeud * noeud, intptr_t cle ){
+	while( noeud && noeud->cle != cle ){
+		noeud = ( cle < noeud->cle ) ? noeud->gauche : noeud->droite;
+	}
+	return noeud;
+}
+
+int trouver_table_persistante(
+	const Table_persistante * table, intptr_t cle, intptr_t * valeur
+){
+	const Noeud * noeud = chercher( table->racine, cle );
+	if( ! noeud ){
+		return 0;
+	}
+	*valeur = noeud->valeur;
+	return 1;
+}
+
+intptr_t * modifier_valeur_table_persistante(
+	Table_persistante * table, intptr_t cle
+){
+	// On ne copie pas le chemin d'une clé absente.
+	if( ! chercher( table->racine, cle ) ){
+		return NULL;
+	}
+	Noeud ** lien = &table->racine;
+	for( ;; ){
+		Noeud * noeud = rendre_unique( table, *lien );
+		*lien = noeud;
+		if( cle < noeud->cle ){
+			lien = &noeud->gauche;
+		}else if( cle > noeud->cle ){
+			lien = &noeud->droite;
+		}else{
+			return &noeud->valeur;
+		}
+	}
+}
+
+int taille_table_persistante( const Table_persistante * table ){
+	return taille( table->racine );
+}
+
+static void descendre(
+	Parcours_table_persistante * parcours, const Noeud * noeud
+){
+	while( noeud ){
+		assert( parcours->taille < HAUTEUR_MAX_TABLE_PERSISTANTE );
+		parcours->pile[ parcours->taille++ ] = noeud;
+		noeud = noeud->gauche;
+	}
+}
+
+void commencer_parcours_table_persistante(
+	Parcours_table_persistante * parcours, const Table_persistante * table
+){
+	parcours->taille = 0;
+	descendre( parcours, table->racine );
+}
+
+void commencer_parcours_table_persistante_au_rang(
+	Parcours_table_persistante * parcours, const Table_persistante * table,
+	int rang
+){
+	// La pile garde les noeuds dont on est descendu à gauche : ce sont les 
+	// entrées qui suivent celle de rang 'rang'.
+	parcours->taille = 0;
+	const Noeud * noeud = table->racine;
+	while( noeud ){
+		int taille_gauche = taille( noeud->gauche );
+		if( rang <= taille_gauche ){
+			assert( parcours->taille < HAUTEUR_MAX_TABLE_PERSISTANTE );
+			parcours->pile[ parcours->taille++ ] = noeud;
+			if( rang == taille_gauche ){
+				return;
+			}
+			noeud = noeud->gauche;
+		}else{
+			rang -= taille_gauche + 1;
+			noeud = noeud->droite;
+		}
+	}
+}
+
+int entree_suivante_table_persistante(
+	Parcours_table_persistante * parcours, intptr_t * cle, intptr_t * valeur
+){
+	if( parcours->taille == 0 ){
+		return 0;
+	}
+	const Noeud * noeud = parcours->pile[ --parcours->taille ];
+	descendre( parcours, noeud->droite );
+	*cle = noeud->cle;
+	*valeur = noeud->valeur;
+	return 1;
+}
@@ -0,0 +1,155 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux.
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __TABLE_PERSISTANTE_H__
+#define __TABLE_PERSISTANTE_H__
+
+#include <stdint.h>
+
+#pragma GCC visibility push(default)
+
+/*
+ * Définit le type d'une table persistante, qui associe des valeurs à des 
+ * clés entières.
+ *
+ * La table est un arbre AVL dont les noeuds comptent leurs références et 
+ * sont partagés entre les versions. partager_table_persistante() crée une 
+ * nouvelle version en temps constant. Modifier une version ne copie que les 
+ * noeuds partagés du chemin qui mène à la clé, soit O(log n) noeuds : les 
+ * autres versions ne changent pas. Une table qui n'est pas partagée est 
+ * modifiée sur place, sans allocation.
+ *
+ * Les valeurs appartiennent à la table. Quand un noeud partagé est copié,
+ * sa valeur est dupliquée par partager_valeur() ; quand un noeud est libéré,
+ * sa valeur l'est par liberer_valeur(). Si ces fonctions valent NULL, les 
+ * valeurs sont copiées telles quelles et ne sont pas libérées.
+ *
+ * Les compteurs de références sont atomiques : deux versions d'une même 
+ * table peuvent être utilisées et libérées par des fils différents.
+ */
+typedef struct Table_persistante Table_persistante;
+
+typedef struct Noeud_table_persistante Noeud_table_persistante;
+
+/*
+ * Crée une table persistante vide.
+ */
+Table_persistante * creer_table_persistante(
+	intptr_t (*partager_valeur)( const intptr_t valeur ),
+	void (*liberer_valeur)( intptr_t valeur )
+);
+
+/*
+ * Renvoie une nouvelle version de la table, en temps constant. Les deux 
+ * versions sont indépendantes et se libèrent séparément.
+ */
+Table_persistante * partager_table_persistante(
+	const Table_persistante * table
+);
+
+/*
+ * Renvoie une copie de la table qui ne partage aucun noeud avec elle. Les 
+ * noeuds sont copiés un à un avec la même forme, sans réinsertion : la 
+ * complexité est linéaire. Les valeurs de la copie sont obtenues par 
+ * copier_valeur(), ou par la fonction partager_valeur() de la table si 
+ * copier_valeur vaut NULL.
+ */
+Table_persistante * copier_table_persistante(
+	const Table_persistante * table,
+	intptr_t (*copier_valeur)( const intptr_t valeur )
+);
+
+/*
+ * Libère une version de la table. Les noeuds qui ne sont plus utilisés par
+ * aucune version sont libérés, ainsi que leurs valeurs.
+ */
+void liberer_table_persistante( Table_persistante * table );
+
+/*
+ * Associe une valeur à une clé dans cette version de la table, en 
+ * O(log n). L'ancienne valeur de la clé, s'il y en a une, est libérée.
+ * La table prend possession de la valeur.
+ */
+void ajouter_table_persistante(
+	Table_persistante * table, intptr_t cle, intptr_t valeur
+);
+
+/*
+ * Renvoie 1 et écrit la valeur associée à la clé dans 'valeur' si la clé 
+ * est présente, et renvoie 0 sinon.
+ */
+int trouver_table_persistante(
+	const Table_persistante * table, intptr_t cle, intptr_t * valeur
+);
+
+/*
+ * Renvoie l'adresse de la valeur associée à une clé, pour la modifier dans
+ * cette version de la table seulement, ou NULL si la clé est absente.
+ * Les noeuds partagés du chemin sont d'abord copiés. L'adresse n'est valide
+ * que jusqu'à la prochaine modification de la table.
+ */
+intptr_t * modifier_valeur_table_persistante(
+	Table_persistante * table, intptr_t cle
+);
+
+/*
+ * Renvoie le nombre de clés de la table, en temps constant.
+ */
+int taille_table_persistante( const Table_persistante * table );
+
+/*
+ * Une hauteur de 64 suffit pour tout arbre AVL de moins de 2^43 noeuds.
+ */
+#define HAUTEUR_MAX_TABLE_PERSISTANTE 64
+
+/*
+ * Un parcours des entrées d'une table, dans l'ordre croissant des clés.
+ * La table ne doit pas être modifiée pendant le parcours.
+ */
+typedef struct {
+	const Noeud_table_persistante * pile[HAUTEUR_MAX_TABLE_PERSISTANTE];
+	int taille;
+} Parcours_table_persistante;
+
+void commencer_parcours_table_persistante(
+	Parcours_table_persistante * parcours, const Table_persistante * table
+);
+
+/*
+ * Commence le parcours à l'entrée de rang 'rang' (la première a le rang 0),
+ * en O(log n) : des parcours commencés à des rangs différents permettent de
+ * se partager les entrées d'une table.
+ */
+void commencer_parcours_table_persistante_au_rang(
+	Parcours_table_persistante * parcours, const Table_persistante * table,
+	int rang
+);
+
+/*
+ * Renvoie 0 si le parcours est terminé. Sinon, écrit la clé et la valeur de
+ * l'entrée suivante et renvoie 1.
+ */
+int entree_suivante_table_persistante(
+	Parcours_table_persistante * parcours, intptr_t * cle, intptr_t * valeur
+);
+
+#pragma GCC visibility pop
+
+#endif
@@ -0,0 +1,42 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2014, 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file alea.h */
+
+#ifndef __ALEA_H__
+#define __ALEA_H__
+
+/*
+ * Générateur aléatoire commun aux tests : un générateur congruentiel 
+ * linéaire global, dont chaque test fixe la graine. Un test produit donc 
+ * toujours les mêmes données.
+ */
+
+/*
+ * Réinitialise le générateur aléatoire.
+ */
+void initialiser_alea( unsigned int graine );
+
+/*
+ * Renvoie un entier aléatoire dans [0, n[.
+ */
+int alea( int n );
+
+#endif
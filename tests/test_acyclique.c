@@ -0,0 +1,143 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "acyclique.h"
+#include "automate.h"
+#include "automate_compile.h"
+#include "langage.h"
+#include "outils.h"
+#include "alea.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static int comparer_mots( const void * a, const void * b ){
+	return strcmp( (const char *) a, (const char *) b );
+}
+
+/*
+ * Renvoie le nombre d'états de l'automate déterministe minimal (sans puits),
+ * obtenu par l'algorithme de Brzozowski.
+ */
+static int taille_minimale( const Automate * automate ){
+	Automate * m1 = miroir( automate );
+	Automate_compile * c1 = compiler_automate( m1 );
+	Automate * d1 = decompiler_automate( c1 );
+	Automate * m2 = miroir( d1 );
+	Automate_compile * c2 = compiler_automate( m2 );
+	int res = c2->nb_etats;
+	liberer_automate_compile( c2 );
+	liberer_automate( m2 );
+	liberer_automate( d1 );
+	liberer_automate_compile( c1 );
+	liberer_automate( m1 );
+	return res;
+}
+
+int test_acyclique(){
+	int result = 1;
+
+	{
+		Constructeur_acyclique * c = creer_constructeur_acyclique();
+		int ajouts = 1
+			&& ajouter_mot_acyclique( c, "tap" )
+			&& ajouter_mot_acyclique( c, "taps" )
+			&& ajouter_mot_acyclique( c, "top" )
+			&& ajouter_mot_acyclique( c, "tops" )
+			&& ! ajouter_mot_acyclique( c, "tap" );
+		Automate * automate = automate_acyclique( c );
+		TEST(
+			1
+			&& ajouts
+			&& taille_ensemble( get_etats( automate ) ) == 5
+			&& le_mot_est_reconnu( automate, "tops" )
+			&& ! le_mot_est_reconnu( automate, "to" )
+			&& nombre_etats_acyclique( c ) == 5
+			, result
+		);
+		liberer_automate( automate );
+		liberer_constructeur_acyclique( c );
+	}
+
+	{
+		// Les mots sont ajoutés triés puis dans le désordre, et l'automate
+		// obtenu est comparé à l'union des automates mot_to_automate().
+		int essai, i, j, identiques = 1;
+		for( essai=0; essai<40; essai++ ){
+			char mots[24][7];
+			int nb_mots = 1 + alea( 24 );
+			Automate * reference = creer_automate();
+			for( i=0; i<nb_mots; i++ ){
+				int longueur = alea( 7 );
+				for( j=0; j<longueur; j++ ){
+					mots[i][j] = 'a' + alea( 3 );
+				}
+				mots[i][longueur] = '\0';
+				Automate * mot = mot_to_automate( mots[i] );
+				Automate * u = creer_union_des_automates( reference, mot );
+				liberer_automate( mot );
+				liberer_automate( reference );
+				reference = u;
+			}
+			int minimale = taille_minimale( reference );
+
+			Constructeur_acyclique * desordre = creer_constructeur_acyclique();
+			for( i=0; i<nb_mots; i++ ){
+				ajouter_mot_acyclique( desordre, mots[i] );
+			}
+			qsort( mots, nb_mots, sizeof(mots[0]), comparer_mots );
+			Constructeur_acyclique * tries = creer_constructeur_acyclique();
+			for( i=0; i<nb_mots; i++ ){
+				ajouter_mot_acyclique( tries, mots[i] );
+			}
+
+			Automate * a1 = automate_acyclique( tries );
+			Automate * a2 = automate_acyclique( desordre );
+			if(
+				! sont_equivalents( a1, reference, NULL )
+				|| ! sont_equivalents( a2, reference, NULL )
+				|| (int) taille_ensemble( get_etats( a1 ) ) != minimale
+				|| (int) taille_ensemble( get_etats( a2 ) ) != minimale
+				|| nombre_etats_acyclique( desordre ) != minimale
+			){
+				identiques = 0;
+			}
+			liberer_automate( a1 );
+			liberer_automate( a2 );
+			liberer_constructeur_acyclique( tries );
+			liberer_constructeur_acyclique( desordre );
+			liberer_automate( reference );
+		}
+		TEST( identiques, result );
+	}
+
+	return result;
+}
+
+
+int main(){
+
+	initialiser_alea( 23 );
+	if( ! test_acyclique() ){ return 1; };
+
+	return 0;
+	
+}
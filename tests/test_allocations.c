@@ -0,0 +1,164 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate.h"
+#include "ensemble.h"
+#include "outils.h"
+
+#include <stdlib.h>
+
+/*
+ * Un allocateur qui compte les blocs vivants et délègue à malloc().
+ */
+static int blocs_vivants = 0;
+static int nb_appels = 0;
+
+static void* allouer_compte( size_t n, void* data ){
+	blocs_vivants++;
+	nb_appels++;
+	*(int*) data += 1;
+	return malloc( n );
+}
+
+static void* reallouer_compte( void* ptr, size_t n, void* data ){
+	if( ! ptr ){
+		blocs_vivants++;
+	}
+	nb_appels++;
+	return realloc( ptr, n );
+}
+
+static void liberer_compte( void* ptr, void* data ){
+	blocs_vivants--;
+	nb_appels++;
+	free( ptr );
+}
+
+int test_allocations(){
+	int result = 1;
+
+	{
+		// Branchement d'un allocateur.
+		int nb_allocations = 0;
+		Allocateur allocateur = {
+			allouer_compte, reallouer_compte, liberer_compte, &nb_allocations
+		};
+		definir_allocateur( &allocateur );
+		Automate * automate = mot_to_automate( "abba" );
+		Automate * copie = copier_automate( automate );
+		liberer_automate( automate );
+		liberer_automate( copie );
+		definir_allocateur( NULL );
+		TEST( nb_appels > 0, result );
+		TEST( nb_allocations > 0, result );
+		TEST( blocs_vivants == 0, result );
+	}
+
+	{
+		// Après la restauration, l'allocateur branché n'est plus appelé.
+		int avant = nb_appels;
+		Ensemble * ensemble = creer_ensemble( NULL, NULL, NULL );
+		ajouter_element( ensemble, 1 );
+		liberer_ensemble( ensemble );
+		TEST( nb_appels == avant, result );
+	}
+
+	{
+		// Comptabilité des allocations.
+		Statistiques_allocations avant, pendant, apres;
+		int instrumente = lire_statistiques_allocations( &avant );
+#ifdef INSTRUMENTER_ALLOCATIONS
+		TEST( instrumente, result );
+#else
+		TEST( ! instrumente, result );
+#endif
+		reinitialiser_pic_allocations();
+
+		Ensemble * ensemble = creer_ensemble( NULL, NULL, NULL );
+		for( int i = 0; i < 100; i++ ){
+			ajouter_element( ensemble, i );
+		}
+		char * bloc = xmalloc( 1000 );
+		bloc = xrealloc( bloc, 3000 );
+		lire_statistiques_allocations( &pendant );
+		xfree( bloc );
+		liberer_ensemble( ensemble );
+		lire_statistiques_allocations( &apres );
+
+		if( instrumente ){
+			unsigned long total = 0;
+			for( int i = 0; i < NB_CLASSES_ALLOCATIONS; i++ ){
+				total += pendant.histogramme[i] - avant.histogramme[i];
+			}
+			TEST(
+				1
+				&& pendant.octets_vivants >= avant.octets_vivants + 3000
+				&& pendant.pic_octets >= pendant.octets_vivants
+				&& pendant.nb_allocations >= avant.nb_allocations + 101
+				&& pendant.nb_reallocations == avant.nb_reallocations + 1
+				&& total == (
+					pendant.nb_allocations - avant.nb_allocations
+					+ pendant.nb_reallocations - avant.nb_reallocations
+				)
+				&& pendant.histogramme[11] > avant.histogramme[11]
+				&& pendant.octets_vivants_par_etiquette[ETIQUETTE_TABLE]
+					> avant.octets_vivants_par_etiquette[ETIQUETTE_TABLE]
+				&& pendant.octets_vivants_par_etiquette[ETIQUETTE_ENSEMBLE]
+					> avant.octets_vivants_par_etiquette[ETIQUETTE_ENSEMBLE]
+				&& pendant.octets_vivants_par_etiquette[ETIQUETTE_AUTRE]
+					== avant.octets_vivants_par_etiquette[ETIQUETTE_AUTRE] + 3000
+				, result
+			);
+			TEST(
+				1
+				&& apres.octets_vivants == avant.octets_vivants
+				&& apres.pic_octets == pendant.pic_octets
+				&& apres.nb_liberations - avant.nb_liberations
+					== apres.nb_allocations - avant.nb_allocations
+				, result
+			);
+			for( int i = 0; i < NB_ETIQUETTES; i++ ){
+				TEST(
+					apres.octets_vivants_par_etiquette[i]
+					== avant.octets_vivants_par_etiquette[i], result
+				);
+			}
+		}else{
+			TEST(
+				1
+				&& pendant.octets_vivants == 0
+				&& pendant.nb_allocations == 0
+				&& apres.pic_octets == 0
+				, result
+			);
+		}
+	}
+
+	return result;
+}
+
+
+int main(){
+
+	if( ! test_allocations() ){ return 1; };
+
+	return 0;
+	
+}
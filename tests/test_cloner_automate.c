@@ -0,0 +1,147 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "automate.h"
+#include "statistiques.h"
+#include "outils.h"
+
+int test_cloner_automate(){
+	int result = 1;
+
+	{
+		Automate * base = creer_automate();
+		ajouter_transition( base, 0, 'a', 1 );
+		ajouter_transition( base, 1, 'b', 2 );
+		ajouter_transition( base, 2, 'a', 0 );
+		ajouter_etat_initial( base, 0 );
+		ajouter_etat_final( base, 2 );
+
+		Automate * clone_1 = cloner_automate( base );
+		Automate * clone_2 = cloner_automate( base );
+		Automate * clone_de_clone = cloner_automate( clone_1 );
+
+		// Modifier un clone ne modifie ni l'automate cloné, ni les autres
+		// clones.
+		ajouter_transition( clone_1, 1, 'b', 3 );
+		ajouter_etat_final( clone_1, 3 );
+		ajouter_etat_final( clone_2, 1 );
+		ajouter_transition( base, 0, 'c', 2 );
+
+		TEST(
+			1
+			&& le_mot_est_reconnu( base, "ab" )
+			&& ! le_mot_est_reconnu( base, "a" )
+			&& le_mot_est_reconnu( base, "c" )
+			&& ! est_une_transition_de_l_automate( base, 1, 'b', 3 )
+			&& ! est_un_etat_de_l_automate( base, 3 )
+			&& ! est_un_etat_final_de_l_automate( base, 1 )
+
+			&& le_mot_est_reconnu( clone_1, "ab" )
+			&& est_une_transition_de_l_automate( clone_1, 1, 'b', 3 )
+			&& est_un_etat_final_de_l_automate( clone_1, 3 )
+			&& ! le_mot_est_reconnu( clone_1, "c" )
+
+			&& le_mot_est_reconnu( clone_2, "a" )
+			&& ! est_une_transition_de_l_automate( clone_2, 1, 'b', 3 )
+			&& ! le_mot_est_reconnu( clone_2, "c" )
+
+			&& ! est_une_transition_de_l_automate( clone_de_clone, 1, 'b', 3 )
+			&& ! est_un_etat_final_de_l_automate( clone_de_clone, 1 )
+			&& le_mot_est_reconnu( clone_de_clone, "ab" )
+			, result
+		);
+
+		// Un clone se libère indépendamment de l'automate cloné.
+		liberer_automate( base );
+		TEST(
+			1
+			&& le_mot_est_reconnu( clone_de_clone, "abaab" )
+			&& le_mot_est_reconnu( clone_2, "abaa" )
+			, result
+		);
+		Automate * copie = copier_automate( clone_de_clone );
+		liberer_automate( clone_de_clone );
+		liberer_automate( clone_1 );
+		ajouter_transition( clone_2, 2, 'b', 2 );
+		TEST(
+			1
+			&& le_mot_est_reconnu( clone_2, "abb" )
+			&& le_mot_est_reconnu( copie, "ab" )
+			&& ! le_mot_est_reconnu( copie, "abb" )
+			, result
+		);
+		liberer_automate( copie );
+		liberer_automate( clone_2 );
+	}
+
+	{
+		// Sur un clone, une écriture sans effet ne copie rien, et un ajout de
+		// transition ne copie que O(log n) noeuds et un ensemble d'arrivée.
+		Automate * base = creer_automate();
+		int i;
+		for( i=0; i<10000; i++ ){
+			ajouter_transition( base, i, 'a', i+1 );
+			ajouter_transition( base, i, 'b', 0 );
+		}
+		ajouter_etat_final( base, 10000 );
+		Automate * clone = cloner_automate( base );
+		Statistiques_operation s;
+		Mesure_operation mesure;
+		activer_statistiques( 1 );
+
+		debut_operation( &mesure, "sans effet" );
+		ajouter_transition( clone, 5000, 'a', 5001 );
+		ajouter_etat_final( clone, 10000 );
+		fin_operation( &mesure );
+		lire_statistiques_operation( &s );
+		unsigned long sans_effet = s.allocations;
+
+		debut_operation( &mesure, "ajout" );
+		ajouter_transition( clone, 5000, 'b', 7 );
+		fin_operation( &mesure );
+		lire_statistiques_operation( &s );
+		unsigned long ajout = s.allocations;
+		activer_statistiques( 0 );
+
+		TEST(
+			1
+			&& sans_effet == 0
+			&& ajout > 0 && ajout <= 100
+			&& est_une_transition_de_l_automate( clone, 5000, 'b', 7 )
+			&& ! est_une_transition_de_l_automate( base, 5000, 'b', 7 )
+			&& est_une_transition_de_l_automate( base, 5000, 'b', 0 )
+			, result
+		);
+		liberer_automate( clone );
+		liberer_automate( base );
+	}
+
+	return result;
+}
+
+
+int main(){
+
+	if( ! test_cloner_automate() ){ return 1; };
+
+	return 0;
+	
+}
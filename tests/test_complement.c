@@ -0,0 +1,147 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "automate.h"
+#include "automate_compile.h"
+#include "outils.h"
+
+int test_complement(){
+	int result = 1;
+
+	{
+		// Mots sur {a,b} contenant le facteur "ab" (non déterministe)
+		Automate * automate = creer_automate();
+
+		ajouter_transition( automate, 0, 'a', 0 );
+		ajouter_transition( automate, 0, 'b', 0 );
+		ajouter_transition( automate, 0, 'a', 1 );
+		ajouter_transition( automate, 1, 'b', 2 );
+		ajouter_transition( automate, 2, 'a', 2 );
+		ajouter_transition( automate, 2, 'b', 2 );
+		ajouter_etat_initial( automate, 0 );
+		ajouter_etat_final( automate, 2 );
+
+		Automate_compile * dfa = compiler_automate( automate );
+		Automate_compile * comp = complement( dfa );
+		Automate_compile * comp_comp = complement( comp );
+		Automate * aut_comp = decompiler_automate( comp );
+
+		const char * mots[] = {
+			"", "a", "b", "ab", "ba", "aab", "bba", "abab", "bbbb", "aaaa"
+		};
+		int i;
+		for( i=0; i<10; i++ ){
+			int reconnu = le_mot_est_reconnu( automate, mots[i] );
+			TEST(
+				1
+				&& le_mot_est_reconnu_compile( dfa, mots[i] ) == reconnu
+				&& le_mot_est_reconnu_compile( comp, mots[i] ) == ! reconnu
+				&& le_mot_est_reconnu_compile( comp_comp, mots[i] ) == reconnu
+				&& le_mot_est_reconnu( aut_comp, mots[i] ) == ! reconnu
+				, result
+			);
+		}
+
+		TEST(
+			1
+			&& dfa->nb_etats == comp->nb_etats
+			&& comp->complet
+			&& comp->puits_final == ! dfa->puits_final
+			&& ! le_mot_est_reconnu_compile( comp, "ac" )
+			&& ! le_mot_est_reconnu_compile( dfa, "abc" )
+			, result
+		);
+
+		liberer_automate( aut_comp );
+		liberer_automate_compile( comp_comp );
+		liberer_automate_compile( comp );
+		liberer_automate_compile( dfa );
+		liberer_automate( automate );
+	}
+
+	{
+		// Le puits implicite : l'automate "ab" n'est pas complet
+		Automate * automate = mot_to_automate( "ab" );
+		Automate_compile * dfa = compiler_automate( automate );
+		Automate_compile * complete = completer( dfa );
+		Automate * aut_complet = decompiler_automate( complete );
+		Automate * aut = decompiler_automate( dfa );
+
+		TEST(
+			1
+			&& dfa->nb_etats == 3
+			&& complete->nb_etats == 3
+			&& delta_compile( dfa, 0, 'b' ) == ETAT_PUITS
+			&& delta_compile( dfa, ETAT_PUITS, 'a' ) == ETAT_PUITS
+			&& taille_ensemble( get_etats( aut ) ) == 3
+			&& taille_ensemble( get_etats( aut_complet ) ) == 4
+			&& est_une_transition_de_l_automate( aut_complet, 0, 'b', 3 )
+			&& est_une_transition_de_l_automate( aut_complet, 3, 'a', 3 )
+			&& le_mot_est_reconnu( aut_complet, "ab" )
+			&& ! le_mot_est_reconnu( aut_complet, "abb" )
+			&& le_mot_est_reconnu_compile( complete, "ab" )
+			&& ! le_mot_est_reconnu_compile( complete, "a" )
+			, result
+		);
+
+		liberer_automate( aut );
+		liberer_automate( aut_complet );
+		liberer_automate_compile( complete );
+		liberer_automate_compile( dfa );
+		liberer_automate( automate );
+	}
+
+	{
+		// Le complémentaire de l'automate vide reconnaît tous les mots
+		Automate * automate = creer_automate();
+		ajouter_lettre( automate, 'a' );
+		Automate_compile * dfa = compiler_automate( automate );
+		Automate_compile * comp = complement( dfa );
+		Automate * aut_comp = decompiler_automate( comp );
+
+		TEST(
+			1
+			&& dfa->initial == ETAT_PUITS
+			&& ! le_mot_est_reconnu_compile( dfa, "" )
+			&& le_mot_est_reconnu_compile( comp, "" )
+			&& le_mot_est_reconnu_compile( comp, "aaa" )
+			&& le_mot_est_reconnu( aut_comp, "" )
+			&& le_mot_est_reconnu( aut_comp, "aa" )
+			, result
+		);
+
+		liberer_automate( aut_comp );
+		liberer_automate_compile( comp );
+		liberer_automate_compile( dfa );
+		liberer_automate( automate );
+	}
+
+	return result;
+}
+
+
+int main(){
+
+	if( ! test_complement() ){ return 1; };
+
+	return 0;
+	
+}
@@ -0,0 +1,205 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "automate.h"
+#include "automate_compile.h"
+#include "comptage.h"
+#include "outils.h"
+
+#include <string.h>
+#include <math.h>
+
+int test_compter_mots(){
+	int result = 1;
+
+	{
+		// Mots sur {a,b} contenant le facteur "ab" : 2^n - (n+1) mots de
+		// longueur n.
+		Automate * automate = creer_automate();
+		ajouter_transition( automate, 0, 'a', 0 );
+		ajouter_transition( automate, 0, 'b', 0 );
+		ajouter_transition( automate, 0, 'a', 1 );
+		ajouter_transition( automate, 1, 'b', 2 );
+		ajouter_transition( automate, 2, 'a', 2 );
+		ajouter_transition( automate, 2, 'b', 2 );
+		ajouter_etat_initial( automate, 0 );
+		ajouter_etat_final( automate, 2 );
+
+		Comptage_mots * comptage = creer_comptage_mots( automate, 20 );
+		int n;
+		for( n=0; n<=20; n++ ){
+			uint64_t attendu = ( UINT64_C(1) << n ) - ( n + 1 );
+			uint64_t compte = compter_mots( automate, n, 0 );
+			uint64_t compte_modulo = compter_mots( automate, n, 7 );
+			TEST(
+				1
+				&& compte == attendu
+				&& compte_modulo == attendu % 7
+				&& nombre_de_mots( comptage, n ) == (double) attendu
+				, result
+			);
+		}
+
+		// 2^70 - 71 modulo 1000003 et modulo 2^64
+		uint64_t grand = compter_mots( automate, 70, 0 );
+		uint64_t grand_modulo = compter_mots( automate, 70, 1000003 );
+		uint64_t attendu_modulo = 1;
+		for( n=0; n<70; n++ ){
+			attendu_modulo = ( attendu_modulo * 2 ) % 1000003;
+		}
+		attendu_modulo = ( attendu_modulo + 1000003 - 71 ) % 1000003;
+		TEST(
+			1
+			&& grand == (uint64_t) 0 - 71
+			&& grand_modulo == attendu_modulo
+			, result
+		);
+
+		// Tous les mots tirés sont reconnus et de la bonne longueur.
+		uint64_t graine = 42;
+		int i;
+		for( i=0; i<200; i++ ){
+			char * mot = echantillonner_mot( comptage, 15, &graine );
+			TEST(
+				mot && strlen( mot ) == 15 && le_mot_est_reconnu( automate, mot ),
+				result
+			);
+			xfree( mot );
+		}
+		char * aucun = echantillonner_mot( comptage, 1, &graine );
+		TEST( aucun == NULL, result );
+
+		liberer_comptage_mots( comptage );
+		liberer_automate( automate );
+	}
+
+	{
+		// Le tirage est uniforme : les 4 mots de longueur 3 contenant "ab"
+		// sont tirés à peu près aussi souvent.
+		Automate * automate = creer_automate();
+		ajouter_transition( automate, 0, 'a', 0 );
+		ajouter_transition( automate, 0, 'b', 0 );
+		ajouter_transition( automate, 0, 'a', 1 );
+		ajouter_transition( automate, 1, 'b', 2 );
+		ajouter_transition( automate, 2, 'a', 2 );
+		ajouter_transition( automate, 2, 'b', 2 );
+		ajouter_etat_initial( automate, 0 );
+		ajouter_etat_final( automate, 2 );
+
+		Comptage_mots * comptage = creer_comptage_mots( automate, 3 );
+		const char * mots[4] = { "aab", "aba", "abb", "bab" };
+		int occurrences[4] = { 0, 0, 0, 0 };
+		uint64_t graine = 12345;
+		int i, j;
+		for( i=0; i<8000; i++ ){
+			char * mot = echantillonner_mot( comptage, 3, &graine );
+			for( j=0; j<4; j++ ){
+				if( strcmp( mot, mots[j] ) == 0 ) occurrences[j]++;
+			}
+			xfree( mot );
+		}
+		for( j=0; j<4; j++ ){
+			TEST( occurrences[j] > 1800 && occurrences[j] < 2200, result );
+		}
+		liberer_comptage_mots( comptage );
+		liberer_automate( automate );
+	}
+
+	{
+		// Le complémentaire de "ab" a 2^n mots de longueur n, sauf pour
+		// n = 2.
+		Automate * ab = mot_to_automate( "ab" );
+		Automate_compile * compile = compiler_automate( ab );
+		Automate_compile * comp = complement( compile );
+		Automate * automate = decompiler_automate( comp );
+
+		Comptage_mots * comptage = creer_comptage_mots( automate, 5 );
+		TEST(
+			1
+			&& compter_mots( ab, 2, 0 ) == 1
+			&& compter_mots( ab, 3, 0 ) == 0
+			&& compter_mots( automate, 2, 0 ) == 3
+			&& compter_mots( automate, 5, 0 ) == 32
+			&& nombre_de_mots( comptage, 0 ) == 1
+			&& nombre_de_mots( comptage, 2 ) == 3
+			&& nombre_de_mots( comptage, 4 ) == 16
+			, result
+		);
+		liberer_comptage_mots( comptage );
+		liberer_automate( automate );
+		liberer_automate_compile( comp );
+		liberer_automate_compile( compile );
+		liberer_automate( ab );
+	}
+
+	{
+		// Σ* sur 26 lettres a 26^300 mots de longueur 300 : bien plus que
+		// le plus grand double. Le tirage reste uniforme.
+		Automate * automate = creer_automate();
+		char c;
+		for( c='a'; c<='z'; c++ ){
+			ajouter_transition( automate, 0, c, 0 );
+		}
+		ajouter_etat_initial( automate, 0 );
+		ajouter_etat_final( automate, 0 );
+
+		Comptage_mots * comptage = creer_comptage_mots( automate, 300 );
+		int occurrences[26] = { 0 };
+		uint64_t graine = 777;
+		int i, j;
+		for( i=0; i<20; i++ ){
+			char * mot = echantillonner_mot( comptage, 300, &graine );
+			for( j=0; j<300; j++ ){
+				occurrences[ mot[j] - 'a' ]++;
+			}
+			xfree( mot );
+		}
+		// 6000 lettres, soit environ 231 de chaque.
+		int uniforme = 1;
+		for( j=0; j<26; j++ ){
+			uniforme = uniforme && occurrences[j] > 150 && occurrences[j] < 320;
+		}
+		double attendu = 300 * log2( 26 );
+		double obtenu = log2_nombre_de_mots( comptage, 300 );
+		TEST(
+			1
+			&& uniforme
+			&& fabs( obtenu - attendu ) < 1e-9 * attendu
+			&& isinf( nombre_de_mots( comptage, 300 ) )
+			&& nombre_de_mots( comptage, 10 ) == pow( 26, 10 )
+			&& log2_nombre_de_mots( comptage, 0 ) == 0
+			, result
+		);
+		liberer_comptage_mots( comptage );
+		liberer_automate( automate );
+	}
+
+	return result;
+}
+
+
+int main(){
+
+	if( ! test_compter_mots() ){ return 1; };
+
+	return 0;
+	
+}
@@ -18,10 +18,13 @@
  *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#define _POSIX_C_SOURCE 200809L
 
 #include "automate.h"
 #include "outils.h"
 
+#include <pthread.h>
+
 
 int test_delta_delta_star(){
 
@@ -136,10 +139,112 @@ int test_delta_delta_star(){
 	return result;
 }
 
+int test_delta_star_tampons(){
+	int result = 1;
+
+	// Automate non déterministe : plusieurs chemins mènent aux mêmes états.
+	Automate* automate = creer_automate();
+	int i;
+	for( i=0; i<40; i++ ){
+		ajouter_transition( automate, 0, 'a', i );
+		ajouter_transition( automate, i, 'a', i );
+		ajouter_transition( automate, i, 'b', 100 + i % 3 );
+		ajouter_etat_final( automate, i );
+	}
+	ajouter_transition( automate, 100, 'c', 200 );
+	ajouter_etat_initial( automate, 0 );
+	ajouter_etat_final( automate, 200 );
+
+	Tampons_etats * tampons = creer_tampons_etats();
+	int nb;
+	const int * etats = delta_star_tampons(
+		automate, get_initiaux( automate ), "aab", tampons, &nb
+	);
+	TEST(
+		1
+		&& nb == 3
+		&& etats[0] == 100 && etats[1] == 101 && etats[2] == 102
+		, result
+	);
+
+	etats = delta_star_tampons(
+		automate, get_initiaux( automate ), "aaa", tampons, &nb
+	);
+	int tries = 1;
+	for( i=0; i<nb; i++ ){
+		if( etats[i] != i ) tries = 0;
+	}
+	TEST( nb == 40 && tries, result );
+
+	TEST(
+		1
+		&& le_mot_est_reconnu_tampons( automate, "aaaa", tampons )
+		&& le_mot_est_reconnu_tampons( automate, "abc", tampons )
+		&& ! le_mot_est_reconnu_tampons( automate, "ab", tampons )
+		&& ! le_mot_est_reconnu_tampons( automate, "abcc", tampons )
+		&& le_mot_est_reconnu_tampons( automate, "", tampons ) 
+			== le_mot_est_reconnu( automate, "" )
+		&& le_mot_est_reconnu( automate, "aabc" )
+		&& ! le_mot_est_reconnu( automate, "aabb" )
+		, result
+	);
+
+	liberer_tampons_etats( tampons );
+	liberer_automate( automate );
+	return result;
+}
+
+
+/*
+ * Chaque fil lit des mots avec ses propres tampons, qui sont libérés quand
+ * il se termine.
+ */
+static void * lire_dans_un_fil( void * data ){
+	const Automate * automate = (const Automate *) data;
+	intptr_t reconnus = 0;
+	int i;
+	for( i=0; i<100; i++ ){
+		reconnus += le_mot_est_reconnu( automate, i % 2 ? "aabc" : "aabb" );
+	}
+	return (void *) reconnus;
+}
+
+int test_tampons_des_fils(){
+	int result = 1;
+
+	Automate * automate = creer_automate();
+	int i;
+	for( i=0; i<40; i++ ){
+		ajouter_transition( automate, i, 'a', i+1 );
+		ajouter_transition( automate, i, 'a', i );
+		ajouter_transition( automate, i, 'b', 100 );
+	}
+	ajouter_transition( automate, 100, 'c', 101 );
+	ajouter_etat_initial( automate, 0 );
+	ajouter_etat_final( automate, 101 );
+
+	pthread_t fils[4];
+	for( i=0; i<4; i++ ){
+		pthread_create( &fils[i], NULL, lire_dans_un_fil, automate );
+	}
+	int corrects = 1;
+	for( i=0; i<4; i++ ){
+		void * reconnus;
+		pthread_join( fils[i], &reconnus );
+		corrects = corrects && (intptr_t) reconnus == 50;
+	}
+	TEST( corrects, result );
+
+	liberer_automate( automate );
+	return result;
+}
+
 
 int main(){
 
 	if( ! test_delta_delta_star() ){ return 1; }
+	if( ! test_delta_star_tampons() ){ return 1; }
+	if( ! test_tampons_des_fils() ){ return 1; }
 
 	return 0;
 }
@@ -0,0 +1,174 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "automate.h"
+#include "automate_compile.h"
+#include "dictionnaire.h"
+#include "langage.h"
+#include "outils.h"
+#include "alea.h"
+
+#include <string.h>
+
+typedef struct {
+	int nb;
+	int positions[16];
+	int mots[16];
+} Occurrences;
+
+static void noter_occurrence( int position, int mot, void * data ){
+	Occurrences * o = (Occurrences *) data;
+	o->positions[ o->nb ] = position;
+	o->mots[ o->nb ] = mot;
+	o->nb++;
+}
+
+int test_dictionnaire(){
+	int result = 1;
+
+	{
+		Dictionnaire * d = creer_dictionnaire();
+		int he = ajouter_mot_dictionnaire( d, "he" );
+		int she = ajouter_mot_dictionnaire( d, "she" );
+		int his = ajouter_mot_dictionnaire( d, "his" );
+		int hers = ajouter_mot_dictionnaire( d, "hers" );
+		int doublon = ajouter_mot_dictionnaire( d, "she" );
+
+		Occurrences o = { 0 };
+		int nb = rechercher_dictionnaire( d, "ushers", noter_occurrence, &o );
+		TEST(
+			1
+			&& he == 0 && she == 1 && his == 2 && hers == 3 && doublon == she
+			&& taille_dictionnaire( d ) == 4
+			&& trouver_mot_dictionnaire( d, "his" ) == his
+			&& trouver_mot_dictionnaire( d, "hi" ) == -1
+			&& trouver_mot_dictionnaire( d, "hersh" ) == -1
+			&& longueur_mot_dictionnaire( d, hers ) == 4
+			&& nb == 3 && o.nb == 3
+			&& o.positions[0] == 4 && o.mots[0] == she
+			&& o.positions[1] == 4 && o.mots[1] == he
+			&& o.positions[2] == 6 && o.mots[2] == hers
+			&& rechercher_dictionnaire( d, "", NULL, NULL ) == 0
+			, result
+		);
+
+		// L'automate compilé reconnaît les textes qui se terminent par un
+		// mot du dictionnaire.
+		Automate_compile * ac = compiler_dictionnaire( d );
+		int etat = ac->initial;
+		const char * texte = "hshe";
+		int i;
+		for( i=0; texte[i]; i++ ){
+			etat = delta_compile( ac, etat, texte[i] );
+		}
+		TEST(
+			1
+			&& le_mot_est_reconnu_compile( ac, "shers" )
+			&& le_mot_est_reconnu_compile( ac, "ushers" )
+			&& le_mot_est_reconnu_compile( ac, "xyz she" )
+			&& le_mot_est_reconnu_compile( ac, "hishe" )
+			&& ! le_mot_est_reconnu_compile( ac, "hersi" )
+			&& pour_tout_mot_de_l_etat( d, etat, NULL, NULL ) == 2
+			, result
+		);
+		liberer_automate_compile( ac );
+		liberer_dictionnaire( d );
+	}
+
+	{
+		// Comparaison avec l'union des automates mot_to_automate() et avec
+		// une recherche naïve, sur des dictionnaires aléatoires.
+		int essai, i, j, k, identiques = 1;
+		for( essai=0; essai<30; essai++ ){
+			Dictionnaire * d = creer_dictionnaire();
+			Automate * automate = creer_automate();
+			char mots[8][5];
+			int nb_mots = 1 + alea( 8 );
+			for( i=0; i<nb_mots; i++ ){
+				int longueur = 1 + alea( 4 );
+				for( j=0; j<longueur; j++ ){
+					mots[i][j] = 'a' + alea( 3 );
+				}
+				mots[i][longueur] = '\0';
+				ajouter_mot_dictionnaire( d, mots[i] );
+				Automate * mot = mot_to_automate( mots[i] );
+				Automate * u = creer_union_des_automates( automate, mot );
+				liberer_automate( mot );
+				liberer_automate( automate );
+				automate = u;
+			}
+
+			Automate * trie = dictionnaire_vers_automate( d );
+			if( ! sont_equivalents( trie, automate, NULL ) ) identiques = 0;
+			liberer_automate( trie );
+
+			Automate_compile * ac = compiler_dictionnaire( d );
+			for( k=0; k<20; k++ ){
+				char texte[13];
+				int longueur = alea( 13 );
+				for( j=0; j<longueur; j++ ){
+					// 'd' n'apparaît dans aucun mot du dictionnaire.
+					texte[j] = 'a' + alea( 4 );
+				}
+				texte[longueur] = '\0';
+
+				int attendu = 0, fin_reconnue = 0, p;
+				for( p=0; p<=longueur; p++ ){
+					for( i=0; i<nb_mots; i++ ){
+						int l = strlen( mots[i] ), doublon = 0;
+						for( j=0; j<i; j++ ){
+							if( strcmp( mots[j], mots[i] ) == 0 ) doublon = 1;
+						}
+						if(
+							! doublon
+							&& l <= p && strncmp( texte + p - l, mots[i], l ) == 0
+						){
+							attendu++;
+							if( p == longueur ) fin_reconnue = 1;
+						}
+					}
+				}
+				if( rechercher_dictionnaire( d, texte, NULL, NULL ) != attendu ){
+					identiques = 0;
+				}
+				if( le_mot_est_reconnu_compile( ac, texte ) != fin_reconnue ){
+					identiques = 0;
+				}
+			}
+			liberer_automate_compile( ac );
+			liberer_automate( automate );
+			liberer_dictionnaire( d );
+		}
+		TEST( identiques, result );
+	}
+
+	return result;
+}
+
+
+int main(){
+
+	initialiser_alea( 17 );
+	if( ! test_dictionnaire() ){ return 1; };
+
+	return 0;
+	
+}
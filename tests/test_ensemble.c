@@ -171,6 +171,42 @@ int test_creer_ensemble(){
 	return result;
 }
 
+int test_creer_ensemble_depuis_tableau(){
+	int result = 1;
+
+	intptr_t elements[100];
+	int n, i;
+	for( n=0; n<=100; n++ ){
+		Ensemble * attendu = creer_ensemble( NULL, NULL, NULL );
+		for( i=0; i<n; i++ ){
+			elements[i] = 3 * i - 50;
+			ajouter_element( attendu, elements[i] );
+		}
+		Ensemble * ens = creer_ensemble_depuis_tableau(
+			elements, n, NULL, NULL, NULL
+		);
+		TEST(
+			1
+			&& taille_ensemble( ens ) == n
+			&& comparer_ensemble( ens, attendu ) == 0
+			&& empreinte_ensemble( ens ) == empreinte_ensemble( attendu )
+			, result
+		);
+		// L'arbre construit d'un coup reste un arbre AVL valide.
+		for( i=0; i<n; i+=2 ){
+			retirer_element( ens, elements[i] );
+			retirer_element( attendu, elements[i] );
+			ajouter_element( ens, elements[i] + 1 );
+			ajouter_element( attendu, elements[i] + 1 );
+		}
+		TEST( comparer_ensemble( ens, attendu ) == 0, result );
+		liberer_ensemble( attendu );
+		liberer_ensemble( ens );
+	}
+
+	return result;
+}
+
 int test_liberer_ensemble(){
 	int result = 1;
 
@@ -943,6 +979,7 @@ int main(){
 
 	result &= general_tests();
 	result &= test_creer_ensemble();
+	result &= test_creer_ensemble_depuis_tableau();
 	result &= test_liberer_ensemble();
 	result &= test_ajouter_element();
 	result &= test_ajouter_elements();
@@ -0,0 +1,202 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "ensemble.h"
+#include "ensemble_persistant.h"
+#include "outils.h"
+#include "alea.h"
+
+#include <pthread.h>
+
+#define NB_VERSIONS 400
+#define NB_FILS 4
+
+/*
+ * Dérive des versions d'un ensemble partagé avec les autres fils, puis les
+ * libère ; renvoie l'ensemble si toutes les versions étaient correctes.
+ */
+static void * deriver_versions( void * data ){
+	const Ensemble_persistant * commun = data;
+	int i, correct = 1;
+	for( i=0; i<1000; i++ ){
+		Ensemble_persistant * partage = partager_ensemble_persistant( commun );
+		Ensemble_persistant * version = ajouter_element_persistant(
+			partage, 1000 + i
+		);
+		correct = correct
+			&& taille_ensemble_persistant( version ) == 101
+			&& est_dans_l_ensemble_persistant( version, 1000 + i );
+		liberer_ensemble_persistant( version );
+		liberer_ensemble_persistant( partage );
+	}
+	return correct ? data : NULL;
+}
+
+int test_ensemble_persistant(){
+	int result = 1;
+
+	{
+		// Chaque version est comparée à un ensemble ordinaire construit en
+		// parallèle. Les anciennes versions ne doivent pas changer.
+		Ensemble_persistant * versions[NB_VERSIONS];
+		Ensemble * references[NB_VERSIONS];
+		int i;
+		versions[0] = NULL;
+		references[0] = creer_ensemble( NULL, NULL, NULL );
+		for( i=1; i<NB_VERSIONS; i++ ){
+			int origine = alea( i );
+			int element = alea( 64 );
+			references[i] = copier_ensemble( references[origine] );
+			if( alea( 3 ) == 0 ){
+				versions[i] = retirer_element_persistant(
+					versions[origine], element
+				);
+				retirer_element( references[i], element );
+			}else{
+				versions[i] = ajouter_element_persistant(
+					versions[origine], element
+				);
+				ajouter_element( references[i], element );
+			}
+		}
+		int identiques = 1;
+		for( i=0; i<NB_VERSIONS; i++ ){
+			Ensemble * ens = creer_ensemble_depuis_persistant( versions[i] );
+			Ensemble_persistant * reconstruit =
+				creer_ensemble_persistant( references[i] );
+			if(
+				comparer_ensemble( ens, references[i] ) != 0
+				|| taille_ensemble_persistant( versions[i] )
+					!= taille_ensemble( references[i] )
+				|| ! sont_egaux_ensembles_persistants( versions[i], reconstruit )
+				|| empreinte_ensemble_persistant( versions[i] )
+					!= empreinte_ensemble_persistant( reconstruit )
+				|| comparer_ensemble_persistant( versions[i], reconstruit ) != 0
+			){
+				identiques = 0;
+			}
+			liberer_ensemble_persistant( reconstruit );
+			liberer_ensemble( ens );
+		}
+		TEST( identiques, result );
+
+		// L'ordre de comparer_ensemble_persistant() est celui de
+		// comparer_ensemble().
+		int ordre = 1;
+		for( i=1; i<NB_VERSIONS; i++ ){
+			if(
+				comparer_ensemble_persistant( versions[i-1], versions[i] )
+				!= comparer_ensemble( references[i-1], references[i] )
+			){
+				ordre = 0;
+			}
+		}
+		TEST( ordre, result );
+
+		for( i=0; i<NB_VERSIONS; i++ ){
+			liberer_ensemble_persistant( versions[i] );
+			liberer_ensemble( references[i] );
+		}
+	}
+
+	{
+		// Ajouter un élément présent renvoie la même version, et les
+		// versions partagent leurs noeuds.
+		Ensemble_persistant * ens = NULL;
+		int i;
+		for( i=0; i<1000; i++ ){
+			Ensemble_persistant * suivant = ajouter_element_persistant( ens, i );
+			liberer_ensemble_persistant( ens );
+			ens = suivant;
+		}
+		Ensemble_persistant * meme = ajouter_element_persistant( ens, 500 );
+		Ensemble_persistant * autre = ajouter_element_persistant( ens, 1000 );
+		Ensemble_persistant * moins = retirer_element_persistant( autre, 1000 );
+		TEST(
+			1
+			&& meme == ens
+			&& taille_ensemble_persistant( ens ) == 1000
+			&& taille_ensemble_persistant( autre ) == 1001
+			&& est_dans_l_ensemble_persistant( autre, 1000 )
+			&& ! est_dans_l_ensemble_persistant( ens, 1000 )
+			&& comparer_ensemble_persistant( ens, ens ) == 0
+			&& comparer_ensemble_persistant( ens, autre ) == -1
+			&& comparer_ensemble_persistant( autre, ens ) == 1
+			&& ! sont_egaux_ensembles_persistants( ens, autre )
+			&& sont_egaux_ensembles_persistants( ens, moins )
+			, result
+		);
+		liberer_ensemble_persistant( moins );
+		liberer_ensemble_persistant( autre );
+		liberer_ensemble_persistant( meme );
+		liberer_ensemble_persistant( ens );
+	}
+
+	{
+		// Un ensemble et sa copie partagée sont égaux en temps constant.
+		Ensemble * ens = creer_ensemble( NULL, NULL, NULL );
+		ajouter_element( ens, 3 );
+		Ensemble * partage = partager_ensemble( ens );
+		TEST( comparer_ensemble( ens, partage ) == 0, result );
+		ajouter_element( partage, 4 );
+		TEST( comparer_ensemble( ens, partage ) == -1, result );
+		liberer_ensemble( partage );
+		liberer_ensemble( ens );
+	}
+
+	{
+		// Les versions d'un même ensemble sont partagées et libérées par 
+		// plusieurs fils à la fois.
+		Ensemble_persistant * commun = NULL;
+		int i, corrects = 1;
+		for( i=0; i<100; i++ ){
+			Ensemble_persistant * suivant = ajouter_element_persistant(
+				commun, i
+			);
+			liberer_ensemble_persistant( commun );
+			commun = suivant;
+		}
+		pthread_t fils[NB_FILS];
+		for( i=0; i<NB_FILS; i++ ){
+			pthread_create( &fils[i], NULL, deriver_versions, commun );
+		}
+		for( i=0; i<NB_FILS; i++ ){
+			void * retour;
+			pthread_join( fils[i], &retour );
+			corrects = corrects && retour == commun;
+		}
+		TEST( corrects && taille_ensemble_persistant( commun ) == 100, result );
+		liberer_ensemble_persistant( commun );
+	}
+
+	return result;
+}
+
+
+int main(){
+
+	initialiser_alea( 7 );
+	if( ! test_ensemble_persistant() ){ return 1; };
+
+	return 0;
+	
+}
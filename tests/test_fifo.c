@@ -0,0 +1,93 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fifo.h"
+#include "outils.h"
+
+int test_fifo(){
+	int result = 1;
+
+	{
+		Fifo * fifo = creer_fifo();
+		TEST( est_vide( fifo ) && taille_fifo( fifo ) == 0, result );
+		ajouter_fifo( fifo, 1 );
+		ajouter_fifo( fifo, 2 );
+		ajouter_fifo( fifo, 3 );
+		TEST( ! est_vide( fifo ) && taille_fifo( fifo ) == 3, result );
+		TEST( obtenir_fifo( fifo ) == 1, result );
+		intptr_t a = retirer_fifo( fifo );
+		intptr_t b = retirer_fifo( fifo );
+		ajouter_fifo( fifo, 4 );
+		intptr_t c = retirer_fifo( fifo );
+		intptr_t d = retirer_fifo( fifo );
+		TEST( a == 1 && b == 2 && c == 3 && d == 4, result );
+		TEST( est_vide( fifo ), result );
+		liberer_fifo( fifo );
+	}
+
+	{
+		// Agrandissements alors que la file fait le tour de son tableau.
+		Fifo * fifo = creer_fifo();
+		int premier = 0, suivant = 0, ordre_respecte = 1;
+		for( int tour = 0; tour < 2000; tour++ ){
+			for( int i = 0; i < 3; i++ ){
+				ajouter_fifo( fifo, suivant++ );
+			}
+			for( int i = 0; i < 2; i++ ){
+				if( retirer_fifo( fifo ) != premier++ ){
+					ordre_respecte = 0;
+				}
+			}
+		}
+		TEST( taille_fifo( fifo ) == suivant - premier, result );
+		while( ! est_vide( fifo ) ){
+			if( retirer_fifo( fifo ) != premier++ ){
+				ordre_respecte = 0;
+			}
+		}
+		TEST( ordre_respecte && premier == suivant, result );
+
+		ajouter_fifo( fifo, 7 );
+		vider_fifo( fifo );
+		TEST( est_vide( fifo ), result );
+		liberer_fifo( fifo );
+	}
+
+	{
+		// La libération d'une grande file n'est pas récursive.
+		Fifo * fifo = creer_fifo();
+		for( int i = 0; i < 1000000; i++ ){
+			ajouter_fifo( fifo, i );
+		}
+		TEST( taille_fifo( fifo ) == 1000000, result );
+		liberer_fifo( fifo );
+	}
+
+	return result;
+}
+
+
+int main(){
+
+	if( ! test_fifo() ){ return 1; };
+
+	return 0;
+	
+}
@@ -0,0 +1,185 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "files_concurrentes.h"
+#include "outils.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+
+#define NB_ELEMENTS 100000
+#define NB_PRODUCTEURS 4
+#define NB_CONSOMMATEURS 3
+
+static void * producteur_spsc( void * data ){
+	File_spsc * file = (File_spsc *) data;
+	for( intptr_t i = 1; i <= NB_ELEMENTS; i++ ){
+		deposer_spsc_attendre( file, i );
+	}
+	return NULL;
+}
+
+typedef struct Partage_mpmc {
+	File_mpmc * file;
+	int numero;
+	atomic_int * vus;
+	atomic_int * nb_preleves;
+} Partage_mpmc;
+
+static void * producteur_mpmc( void * data ){
+	Partage_mpmc * partage = (Partage_mpmc *) data;
+	for( intptr_t i = 0; i < NB_ELEMENTS; i++ ){
+		deposer_mpmc_attendre(
+			partage->file, partage->numero * NB_ELEMENTS + i
+		);
+	}
+	return NULL;
+}
+
+static void * consommateur_mpmc( void * data ){
+	Partage_mpmc * partage = (Partage_mpmc *) data;
+	for( ;; ){
+		intptr_t element = prelever_mpmc_attendre( partage->file );
+		if( element < 0 ){
+			return NULL;
+		}
+		atomic_fetch_add( &partage->vus[element], 1 );
+		atomic_fetch_add( partage->nb_preleves, 1 );
+	}
+}
+
+int test_files_concurrentes(){
+	int result = 1;
+
+	{
+		// Un seul fil : capacité et ordre.
+		File_spsc * spsc = creer_file_spsc( 3 );
+		int i, nb_deposes = 0;
+		for( i = 0; i < 10; i++ ){
+			nb_deposes += deposer_spsc( spsc, i );
+		}
+		TEST( nb_deposes == 4, result );
+		intptr_t element;
+		int ordre = 1;
+		for( i = 0; i < 4; i++ ){
+			if( ! prelever_spsc( spsc, &element ) || element != i ){
+				ordre = 0;
+			}
+		}
+		TEST( ordre, result );
+		TEST( ! prelever_spsc( spsc, &element ), result );
+		liberer_file_spsc( spsc );
+
+		File_mpmc * mpmc = creer_file_mpmc( 5 );
+		nb_deposes = 0;
+		for( i = 0; i < 20; i++ ){
+			nb_deposes += deposer_mpmc( mpmc, i );
+		}
+		TEST( nb_deposes == 8, result );
+		ordre = 1;
+		for( int tour = 0; tour < 3; tour++ ){
+			// La file fait plusieurs fois le tour de son tableau.
+			for( i = 0; i < 8; i++ ){
+				if( ! prelever_mpmc( mpmc, &element ) || element != i ){
+					ordre = 0;
+				}
+				deposer_mpmc( mpmc, i );
+			}
+		}
+		TEST( ordre, result );
+		liberer_file_mpmc( mpmc );
+	}
+
+	{
+		// Un producteur et un consommateur : ordre préservé.
+		File_spsc * file = creer_file_spsc( 64 );
+		pthread_t producteur;
+		pthread_create( &producteur, NULL, producteur_spsc, file );
+		int ordre = 1;
+		for( intptr_t i = 1; i <= NB_ELEMENTS; i++ ){
+			if( prelever_spsc_attendre( file ) != i ){
+				ordre = 0;
+			}
+		}
+		pthread_join( producteur, NULL );
+		TEST( ordre, result );
+		liberer_file_spsc( file );
+	}
+
+	{
+		// Plusieurs producteurs et consommateurs : chaque élément est
+		// prélevé exactement une fois.
+		int nb_total = NB_PRODUCTEURS * NB_ELEMENTS;
+		atomic_int * vus = xmalloc( sizeof(atomic_int) * nb_total );
+		for( int i = 0; i < nb_total; i++ ){
+			atomic_init( &vus[i], 0 );
+		}
+		atomic_int nb_preleves;
+		atomic_init( &nb_preleves, 0 );
+		File_mpmc * file = creer_file_mpmc( 128 );
+		Partage_mpmc producteurs[NB_PRODUCTEURS];
+		Partage_mpmc consommateur = { file, 0, vus, &nb_preleves };
+		pthread_t fils_producteurs[NB_PRODUCTEURS];
+		pthread_t fils_consommateurs[NB_CONSOMMATEURS];
+		for( int i = 0; i < NB_CONSOMMATEURS; i++ ){
+			pthread_create(
+				&fils_consommateurs[i], NULL, consommateur_mpmc, &consommateur
+			);
+		}
+		for( int i = 0; i < NB_PRODUCTEURS; i++ ){
+			producteurs[i] = consommateur;
+			producteurs[i].numero = i;
+			pthread_create(
+				&fils_producteurs[i], NULL, producteur_mpmc, &producteurs[i]
+			);
+		}
+		for( int i = 0; i < NB_PRODUCTEURS; i++ ){
+			pthread_join( fils_producteurs[i], NULL );
+		}
+		for( int i = 0; i < NB_CONSOMMATEURS; i++ ){
+			deposer_mpmc_attendre( file, -1 );
+		}
+		for( int i = 0; i < NB_CONSOMMATEURS; i++ ){
+			pthread_join( fils_consommateurs[i], NULL );
+		}
+		int une_fois = 1;
+		for( int i = 0; i < nb_total; i++ ){
+			if( atomic_load( &vus[i] ) != 1 ){
+				une_fois = 0;
+			}
+		}
+		TEST( une_fois && atomic_load( &nb_preleves ) == nb_total, result );
+		liberer_file_mpmc( file );
+		xfree( vus );
+	}
+
+	return result;
+}
+
+
+int main(){
+
+	if( ! test_files_concurrentes() ){ return 1; };
+
+	return 0;
+	
+}
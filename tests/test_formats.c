@@ -0,0 +1,193 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "automate.h"
+#include "formats.h"
+#include "langage.h"
+#include "outils.h"
+#include "alea.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+/*
+ * Lit un automate dans une chaîne de caractères.
+ */
+static Automate * lire_chaine(
+	Format_automate format, const char * texte, int * ligne_erreur
+){
+	FILE * flux = fmemopen( (void *) texte, strlen( texte ), "r" );
+	Automate * res = lire_automate( format, flux, ligne_erreur );
+	fclose( flux );
+	return res;
+}
+
+/*
+ * Écrit un automate dans un fichier temporaire, puis le relit.
+ */
+static Automate * ecrire_et_relire( const Automate * automate, Format_automate format ){
+	FILE * flux = tmpfile();
+	Automate * res = NULL;
+	if( ecrire_automate( automate, format, flux ) ){
+		rewind( flux );
+		res = lire_automate( format, flux, NULL );
+	}
+	fclose( flux );
+	return res;
+}
+
+int test_formats(){
+	int result = 1;
+
+	{
+		int ligne = -1;
+		Automate * att = lire_chaine(
+			FORMAT_ATT,
+			"0\t1\ta\n"
+			"1 1 b b 0.5\n"
+			"\n"
+			"1\t2\t\\x20\n"
+			"2\n"
+			"1 0.25\n",
+			&ligne
+		);
+		TEST(
+			1
+			&& att && ligne == 0
+			&& est_un_etat_initial_de_l_automate( att, 0 )
+			&& taille_ensemble( get_initiaux( att ) ) == 1
+			&& le_mot_est_reconnu( att, "abb" )
+			&& le_mot_est_reconnu( att, "ab " )
+			&& le_mot_est_reconnu( att, "a" )
+			&& ! le_mot_est_reconnu( att, "" )
+			, result
+		);
+		if( att ) liberer_automate( att );
+
+		Automate * ba = lire_chaine(
+			FORMAT_BA,
+			"[0]\n"
+			"[5]\n"
+			"a,[0]->[1]\n"
+			",,[5]->[1]\n"
+			"b,[1]->[1]\n"
+			"[1]\n",
+			&ligne
+		);
+		TEST(
+			1
+			&& ba && ligne == 0
+			&& taille_ensemble( get_initiaux( ba ) ) == 2
+			&& le_mot_est_reconnu( ba, "abb" )
+			&& le_mot_est_reconnu( ba, ",b" )
+			&& ! le_mot_est_reconnu( ba, "b" )
+			, result
+		);
+		if( ba ) liberer_automate( ba );
+
+		// Sans état final, tous les états sont finaux.
+		ba = lire_chaine( FORMAT_BA, "[0]\na,[0]->[1]\n", NULL );
+		TEST(
+			ba && le_mot_est_reconnu( ba, "" ) && le_mot_est_reconnu( ba, "a" ),
+			result
+		);
+		if( ba ) liberer_automate( ba );
+
+		TEST( lire_chaine( FORMAT_ATT, "0 1 a\n0 x b\n", &ligne ) == NULL, result );
+		TEST( ligne == 2, result );
+		TEST( lire_chaine( FORMAT_ATT, "0 1 ab\n", &ligne ) == NULL, result );
+		TEST( lire_chaine( FORMAT_BA, "[0]\na,[0]->1\n", &ligne ) == NULL, result );
+		TEST( ligne == 2, result );
+		TEST( lire_chaine( FORMAT_DOT, "", NULL ) == NULL, result );
+	}
+
+	{
+		// Écriture puis relecture d'automates aléatoires, dont les lettres
+		// ne sont pas toutes imprimables.
+		static const char lettres[] = "a,[ \n\\";
+		int essai, i, identiques = 1;
+		for( essai=0; essai<30; essai++ ){
+			Automate * automate = creer_automate();
+			int n = 1 + alea( 6 );
+			for( i=0; i<2*n; i++ ){
+				ajouter_transition(
+					automate, alea( n ) - 2, lettres[ alea( 6 ) ], alea( n ) - 2
+				);
+			}
+			ajouter_etat_initial( automate, alea( n ) - 2 );
+			if( alea( 2 ) ) ajouter_etat_initial( automate, alea( n ) - 2 );
+			if( alea( 4 ) ) ajouter_etat_final( automate, alea( n ) - 2 );
+
+			Automate * ba = ecrire_et_relire( automate, FORMAT_BA );
+			if( ! ba || ! sont_equivalents( ba, automate, NULL ) ) identiques = 0;
+			if( ba ) liberer_automate( ba );
+
+			Automate * att = ecrire_et_relire( automate, FORMAT_ATT );
+			if( taille_ensemble( get_initiaux( automate ) ) == 1 ){
+				if( ! att || ! sont_equivalents( att, automate, NULL ) ){
+					identiques = 0;
+				}
+			}else if( att ){
+				identiques = 0;
+			}
+			if( att ) liberer_automate( att );
+			liberer_automate( automate );
+		}
+		TEST( identiques, result );
+	}
+
+	{
+		// Écriture dans un descripteur de fichier.
+		Automate * automate = mot_to_automate( "a\"b" );
+		int tube[2];
+		char sortie[512];
+		TEST( pipe( tube ) == 0, result );
+		int ecrit = ecrire_automate_fd( automate, FORMAT_DOT, tube[1] );
+		close( tube[1] );
+		int n = read( tube[0], sortie, sizeof(sortie) - 1 );
+		close( tube[0] );
+		sortie[ n > 0 ? n : 0 ] = '\0';
+		TEST(
+			1
+			&& ecrit
+			&& strstr( sortie, "digraph" )
+			&& strstr( sortie, "1 -> 2 [label=\"\\\"\"];" )
+			&& strstr( sortie, "3 [shape=doublecircle];" )
+			, result
+		);
+		liberer_automate( automate );
+	}
+
+	return result;
+}
+
+
+int main(){
+
+	initialiser_alea( 31 );
+	if( ! test_formats() ){ return 1; };
+
+	return 0;
+	
+}
@@ -0,0 +1,199 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "automate.h"
+#include "automate_compile.h"
+#include "langage.h"
+#include "outils.h"
+#include "alea.h"
+
+#include <string.h>
+
+static Automate * automate_aleatoire( int nb_etats, int nb_transitions ){
+	Automate * automate = creer_automate();
+	int i;
+	for( i=0; i<nb_etats; i++ ){
+		ajouter_etat( automate, i );
+	}
+	for( i=0; i<nb_transitions; i++ ){
+		ajouter_transition(
+			automate, alea( nb_etats ), 'a' + alea( 2 ), alea( nb_etats )
+		);
+	}
+	ajouter_etat_initial( automate, 0 );
+	for( i=0; i<nb_etats; i++ ){
+		if( alea( 3 ) == 0 ){
+			ajouter_etat_final( automate, i );
+		}
+	}
+	return automate;
+}
+
+int test_inclusion(){
+	int result = 1;
+
+	{
+		// L1 = a(a+b)*b  est inclus dans  L2 = (a+b)*b
+		Automate * auto1 = creer_automate();
+		ajouter_transition( auto1, 0, 'a', 1 );
+		ajouter_transition( auto1, 1, 'a', 1 );
+		ajouter_transition( auto1, 1, 'b', 1 );
+		ajouter_transition( auto1, 1, 'b', 2 );
+		ajouter_etat_initial( auto1, 0 );
+		ajouter_etat_final( auto1, 2 );
+
+		Automate * auto2 = creer_automate();
+		ajouter_transition( auto2, 0, 'a', 0 );
+		ajouter_transition( auto2, 0, 'b', 0 );
+		ajouter_transition( auto2, 0, 'b', 1 );
+		ajouter_etat_initial( auto2, 0 );
+		ajouter_etat_final( auto2, 1 );
+
+		char * mot = NULL;
+		char * mot_equivalent = NULL;
+		char * mot_vide = NULL;
+		int inclus_1_2 = est_inclus( auto1, auto2, NULL );
+		int inclus_2_1 = est_inclus( auto2, auto1, &mot );
+		int equivalents = sont_equivalents( auto1, auto2, &mot_equivalent );
+		int equivalents_1_1 = sont_equivalents( auto1, auto1, NULL );
+		int vide = est_vide_langage( auto1, &mot_vide );
+		TEST(
+			1
+			&& inclus_1_2
+			&& ! inclus_2_1
+			&& mot
+			&& le_mot_est_reconnu( auto2, mot )
+			&& ! le_mot_est_reconnu( auto1, mot )
+			&& ! equivalents
+			&& mot_equivalent
+			&& equivalents_1_1
+			&& ! vide
+			&& mot_vide
+			&& le_mot_est_reconnu( auto1, mot_vide )
+			, result
+		);
+		xfree( mot );
+		xfree( mot_equivalent );
+		xfree( mot_vide );
+		liberer_automate( auto1 );
+		liberer_automate( auto2 );
+	}
+
+	{
+		// Langage vide et lettres absentes du second alphabet
+		Automate * vide = creer_automate();
+		ajouter_transition( vide, 0, 'a', 1 );
+		ajouter_etat_initial( vide, 0 );
+		Automate * mot_c = mot_to_automate( "c" );
+		char * mot_vide = NULL;
+		char * mot = NULL;
+		int est_vide = est_vide_langage( vide, &mot_vide );
+		int inclus_vide = est_inclus( vide, mot_c, NULL );
+		int inclus_c = est_inclus( mot_c, vide, &mot );
+		TEST(
+			1
+			&& est_vide
+			&& mot_vide == NULL
+			&& inclus_vide
+			&& ! inclus_c
+			&& mot && mot[0] == 'c' && mot[1] == '\0'
+			, result
+		);
+		xfree( mot );
+		liberer_automate( vide );
+		liberer_automate( mot_c );
+	}
+
+	{
+		// Comparaison avec l'algorithme naïf sur des automates aléatoires
+		int i;
+		for( i=0; i<200; i++ ){
+			Automate * auto1 = automate_aleatoire( 4, 8 );
+			Automate * auto2 = automate_aleatoire( 4, 8 );
+			Automate_compile * dfa1 = compiler_automate( auto1 );
+			Automate_compile * dfa2 = compiler_automate( auto2 );
+			char * mot = NULL;
+			char * mot_naif = NULL;
+
+			int inclus = est_inclus( auto1, auto2, &mot );
+			int inclus_naif = est_inclus_compile( dfa1, dfa2, &mot_naif );
+			TEST( inclus == inclus_naif, result );
+			if( ! inclus ){
+				TEST(
+					1
+					&& mot && mot_naif
+					&& le_mot_est_reconnu( auto1, mot )
+					&& ! le_mot_est_reconnu( auto2, mot )
+					&& le_mot_est_reconnu( auto1, mot_naif )
+					&& ! le_mot_est_reconnu( auto2, mot_naif )
+					, result
+				);
+			}
+			xfree( mot );
+			xfree( mot_naif );
+			liberer_automate_compile( dfa1 );
+			liberer_automate_compile( dfa2 );
+			liberer_automate( auto1 );
+			liberer_automate( auto2 );
+		}
+	}
+
+	{
+		// Le produit de deux chaînes de 50000 et 50001 états a plus de 2^31
+		// couples, mais seuls les 50002 couples accessibles sont visités.
+		Automate * chaines[2];
+		Automate_compile * dfa[2];
+		int c, i;
+		for( c=0; c<2; c++ ){
+			chaines[c] = creer_automate();
+			for( i=0; i<50000+c; i++ ){
+				ajouter_transition( chaines[c], i, 'a', i+1 );
+			}
+			ajouter_etat_initial( chaines[c], 0 );
+			ajouter_etat_final( chaines[c], 50000+c );
+			dfa[c] = compiler_automate( chaines[c] );
+		}
+		char * mot = NULL;
+		int inclus = est_inclus_compile( dfa[0], dfa[1], &mot );
+		TEST(
+			! inclus && mot && strlen( mot ) == 50000
+			&& strspn( mot, "a" ) == 50000
+			, result
+		);
+		xfree( mot );
+		for( c=0; c<2; c++ ){
+			liberer_automate_compile( dfa[c] );
+			liberer_automate( chaines[c] );
+		}
+	}
+
+	return result;
+}
+
+
+int main(){
+
+	initialiser_alea( 42 );
+	if( ! test_inclusion() ){ return 1; };
+
+	return 0;
+	
+}
@@ -20,6 +20,7 @@
 
 
 #include "automate.h"
+#include "automate_compile.h"
 #include "outils.h"
 
 int test_automate_accessible(){
@@ -57,10 +58,85 @@ int test_automate_accessible(){
 	return result;
 }
 
+int test_miroir_indexe(){
+	int result = 1;
+
+	{
+		Automate * automate = creer_automate();
+
+		ajouter_transition( automate, 1, 'a', 1 );
+		ajouter_transition( automate, 1, 'b', 2 );
+		ajouter_transition( automate, 1, 'b', 3 );
+		ajouter_transition( automate, 3, 'a', 1 );
+		ajouter_transition( automate, 4, 'a', 2 );
+		ajouter_transition( automate, 5, 'b', 5 );
+		ajouter_etat_initial( automate, 1);
+		ajouter_etat_final( automate, 2);
+
+		Automate * aut = miroir( automate );
+		Automate_indexe * index = indexer_automate( automate );
+		Automate_indexe * index_miroir = indexer_automate( aut );
+		Automate_indexe vue = miroir_indexe( index );
+
+		// La vue a les mêmes transitions que l'index du miroir.
+		int identiques = 1;
+		int k, t;
+		int nb_cases = vue.nb_etats * vue.nb_lettres;
+		for( k=0; k<nb_cases; k++ ){
+			int taille = vue.debut[k+1] - vue.debut[k];
+			if( taille != index_miroir->debut[k+1] - index_miroir->debut[k] ){
+				identiques = 0;
+				continue;
+			}
+			for( t=0; t<taille; t++ ){
+				if(
+					vue.fins[ vue.debut[k] + t ]
+					!= index_miroir->fins[ index_miroir->debut[k] + t ]
+				){
+					identiques = 0;
+				}
+			}
+		}
+		TEST(
+			1
+			&& identiques
+			&& vue.nb_etats == index_miroir->nb_etats
+			&& vue.nb_transitions == index_miroir->nb_transitions
+			&& vue.nb_initiaux == 1
+			&& vue.etats[ vue.initiaux[0] ] == 2
+			&& vue.finaux[ indice_etat( &vue, 1 ) ]
+			&& ! vue.finaux[ indice_etat( &vue, 2 ) ]
+			&& vue.fins == index->origines
+			, result
+		);
+
+		// Les états accessibles du miroir sont les co-accessibles.
+		unsigned char marques[5];
+		marquer_accessibles_indexe( &vue, marques );
+		TEST(
+			1
+			&& marques[ indice_etat( index, 1 ) ]
+			&& marques[ indice_etat( index, 2 ) ]
+			&& marques[ indice_etat( index, 3 ) ]
+			&& marques[ indice_etat( index, 4 ) ]
+			&& ! marques[ indice_etat( index, 5 ) ]
+			, result
+		);
+
+		liberer_automate_indexe( index_miroir );
+		liberer_automate_indexe( index );
+		liberer_automate( aut );
+		liberer_automate( automate );
+	}
+
+	return result;
+}
+
 
 int main(){
 
 	if( ! test_automate_accessible() ){ return 1; };
+	if( ! test_miroir_indexe() ){ return 1; };
 
 	return 0;
 	
@@ -0,0 +1,133 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "automate.h"
+#include "langage.h"
+#include "outils.h"
+
+#include <string.h>
+
+int test_mot_le_plus_court(){
+	int result = 1;
+
+	{
+		// Mots sur {a,b} contenant le facteur "abb"
+		Automate * automate = creer_automate();
+		ajouter_transition( automate, 0, 'a', 0 );
+		ajouter_transition( automate, 0, 'b', 0 );
+		ajouter_transition( automate, 0, 'a', 1 );
+		ajouter_transition( automate, 1, 'b', 2 );
+		ajouter_transition( automate, 2, 'b', 3 );
+		ajouter_transition( automate, 3, 'a', 3 );
+		ajouter_transition( automate, 3, 'b', 3 );
+		ajouter_etat_initial( automate, 0 );
+		ajouter_etat_final( automate, 3 );
+
+		char * mot = mot_le_plus_court( automate );
+		TEST( mot && strcmp( mot, "abb" ) == 0, result );
+		xfree( mot );
+
+		int nb_mots, i;
+		char ** mots = mots_les_plus_courts( automate, 7, &nb_mots );
+		TEST( nb_mots == 7, result );
+		TEST( strcmp( mots[0], "abb" ) == 0, result );
+		for( i=1; i<nb_mots; i++ ){
+			// Longueurs croissantes, mots distincts et reconnus
+			TEST( strlen( mots[i-1] ) <= strlen( mots[i] ), result );
+			TEST( strcmp( mots[i-1], mots[i] ) != 0, result );
+		}
+		for( i=0; i<nb_mots; i++ ){
+			TEST( le_mot_est_reconnu( automate, mots[i] ), result );
+		}
+		// Il y a 4 mots de longueur 4 contenant "abb" : les 5 premiers mots
+		// sont "abb" et ces 4 mots.
+		for( i=1; i<5; i++ ){
+			TEST( strlen( mots[i] ) == 4, result );
+		}
+		TEST( strlen( mots[5] ) == 5, result );
+		for( i=0; i<nb_mots; i++ ){
+			xfree( mots[i] );
+		}
+		xfree( mots );
+
+		Automate * aab = mot_to_automate( "aab" );
+		Automate * abb = mot_to_automate( "abb" );
+		char * distinguant = mot_distinguant( automate, abb );
+		char * distinguant_egaux = mot_distinguant( aab, aab );
+		char * distinguant_mots = mot_distinguant( aab, abb );
+		TEST(
+			1
+			&& distinguant && strlen( distinguant ) == 4
+			&& distinguant_egaux == NULL
+			&& distinguant_mots && strcmp( distinguant_mots, "aab" ) == 0
+			, result
+		);
+		xfree( distinguant );
+		xfree( distinguant_mots );
+		liberer_automate( aab );
+		liberer_automate( abb );
+		liberer_automate( automate );
+	}
+
+	{
+		// Langage fini et langage vide
+		Automate * automate = mot_to_automate( "ab" );
+		Automate * vide = creer_automate();
+		ajouter_transition( vide, 0, 'a', 1 );
+		ajouter_etat_initial( vide, 0 );
+
+		int nb_mots, nb_mots_vide;
+		char ** mots = mots_les_plus_courts( automate, 3, &nb_mots );
+		char ** mots_vide = mots_les_plus_courts( vide, 3, &nb_mots_vide );
+		char * mot_vide = mot_le_plus_court( vide );
+		int nb_mots_negatif = -1;
+		char ** mots_negatif = mots_les_plus_courts(
+			automate, -5, &nb_mots_negatif
+		);
+		TEST(
+			1
+			&& nb_mots == 1
+			&& strcmp( mots[0], "ab" ) == 0
+			&& nb_mots_vide == 0
+			&& mot_vide == NULL
+			&& mots_negatif != NULL
+			&& nb_mots_negatif == 0
+			, result
+		);
+		xfree( mots[0] );
+		xfree( mots );
+		xfree( mots_vide );
+		xfree( mots_negatif );
+		liberer_automate( vide );
+		liberer_automate( automate );
+	}
+
+	return result;
+}
+
+
+int main(){
+
+	if( ! test_mot_le_plus_court() ){ return 1; };
+
+	return 0;
+	
+}
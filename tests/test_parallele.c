@@ -0,0 +1,232 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate.h"
+#include "automate_compile.h"
+#include "parallele.h"
+#include "outils.h"
+#include "alea.h"
+
+#include <string.h>
+
+static Automate * automate_aleatoire( int nb_etats, int nb_transitions ){
+	Automate * automate = creer_automate();
+	for( int i = 0; i < nb_etats; i++ ){
+		ajouter_etat( automate, i );
+	}
+	for( int i = 0; i < nb_transitions; i++ ){
+		ajouter_transition(
+			automate, alea( nb_etats ), 'a' + alea( 3 ), alea( nb_etats )
+		);
+	}
+	ajouter_etat_initial( automate, 0 );
+	ajouter_etat_initial( automate, alea( nb_etats ) );
+	for( int i = 0; i < nb_etats; i += 3 ){
+		ajouter_etat_final( automate, i );
+	}
+	return automate;
+}
+
+/*
+ * Un automate indexé en forme de peigne : une longue chaîne d'états dont
+ * chacun a de nombreux successeurs, pour obtenir beaucoup de niveaux et de
+ * grandes frontières.
+ */
+static Automate_indexe * peigne( int nb_etats, int degre ){
+	Automate_indexe * automate = xmalloc( sizeof(Automate_indexe) );
+	memset( automate, 0, sizeof(Automate_indexe) );
+	automate->nb_etats = nb_etats;
+	automate->nb_lettres = 1;
+	automate->etats = xmalloc( sizeof(int) * nb_etats );
+	automate->debut = xmalloc( sizeof(int) * ( nb_etats + 1 ) );
+	automate->fins = xmalloc( sizeof(int) * nb_etats * degre );
+	int t = 0;
+	for( int e = 0; e < nb_etats; e++ ){
+		automate->etats[e] = e;
+		automate->debut[e] = t;
+		// Les états impairs à partir de la moitié ne sont pas atteints.
+		if( e + 1 < nb_etats / 2 ){
+			automate->fins[t++] = e + 1;
+		}
+		for( int d = 1; d < degre && e < nb_etats / 2; d++ ){
+			int f = alea( nb_etats / 2 ) * 2;
+			automate->fins[t++] = f < nb_etats ? f : 0;
+		}
+	}
+	automate->debut[nb_etats] = t;
+	automate->nb_transitions = t;
+	automate->nb_initiaux = 1;
+	automate->initiaux = xmalloc( sizeof(int) );
+	automate->initiaux[0] = 0;
+	automate->finaux = xmalloc( nb_etats );
+	automate->liste_finaux = xmalloc( sizeof(int) );
+	automate->est_initial = xmalloc( nb_etats );
+	return automate;
+}
+
+int test_parallele(){
+	int result = 1;
+
+	for( int essai = 0; essai < 20; essai++ ){
+		int nb_etats = 1 + alea( 200 );
+		Automate * automate = automate_aleatoire(
+			nb_etats, alea( 2 * nb_etats + 1 )
+		);
+		Ensemble * sequentiel = accessibles( automate );
+		int identiques = 1;
+		for( int nb_fils = 1; nb_fils <= 5; nb_fils++ ){
+			Ensemble * parallele = accessibles_parallele( automate, nb_fils );
+			if( comparer_ensemble( sequentiel, parallele ) != 0 ){
+				identiques = 0;
+			}
+			liberer_ensemble( parallele );
+		}
+		TEST( identiques, result );
+
+		// L'index construit en parallèle est le même.
+		Automate_indexe * index = indexer_automate( automate );
+		identiques = 1;
+		for( int nb_fils = 2; nb_fils <= 5; nb_fils++ ){
+			Automate_indexe * obtenu = indexer_automate_parallele(
+				automate, nb_fils
+			);
+			int nb_cases = index->nb_etats * index->nb_lettres;
+			if(
+				obtenu->nb_etats != index->nb_etats
+				|| obtenu->nb_transitions != index->nb_transitions
+				|| memcmp(
+					obtenu->etats, index->etats, sizeof(int) * index->nb_etats
+				)
+				|| memcmp(
+					obtenu->debut, index->debut, sizeof(int) * ( nb_cases + 1 )
+				)
+				|| memcmp(
+					obtenu->fins, index->fins,
+					sizeof(int) * index->nb_transitions
+				)
+			){
+				identiques = 0;
+			}
+			liberer_automate_indexe( obtenu );
+		}
+		TEST( identiques, result );
+		liberer_automate_indexe( index );
+
+		Automate * a1 = automate_accessible( automate );
+		Automate * a2 = automate_accessible_parallele( automate, 3 );
+		// Mêmes transitions : les états accessibles des miroirs coïncident.
+		Automate * m1 = miroir( a1 );
+		Automate * m2 = miroir( a2 );
+		Ensemble * c1 = accessibles( m1 );
+		Ensemble * c2 = accessibles( m2 );
+		TEST(
+			1
+			&& comparer_ensemble( get_etats( a1 ), get_etats( a2 ) ) == 0
+			&& comparer_ensemble( get_finaux( a1 ), get_finaux( a2 ) ) == 0
+			&& comparer_ensemble( get_initiaux( a1 ), get_initiaux( a2 ) ) == 0
+			&& comparer_ensemble( c1, c2 ) == 0
+			, result
+		);
+		liberer_ensemble( c1 );
+		liberer_ensemble( c2 );
+		liberer_automate( m1 );
+		liberer_automate( m2 );
+		liberer_automate( a1 );
+		liberer_automate( a2 );
+		liberer_ensemble( sequentiel );
+		liberer_automate( automate );
+	}
+
+	{
+		int nb_etats = 200000;
+		Automate_indexe * automate = peigne( nb_etats, 6 );
+		unsigned char * attendues = xmalloc( nb_etats );
+		unsigned char * marques = xmalloc( nb_etats );
+		marquer_accessibles_indexe( automate, attendues );
+		int identiques = 1;
+		for( int nb_fils = 1; nb_fils <= 8; nb_fils *= 2 ){
+			memset( marques, 2, nb_etats );
+			marquer_accessibles_indexe_parallele( automate, marques, nb_fils );
+			if( memcmp( marques, attendues, nb_etats ) ){
+				identiques = 0;
+			}
+		}
+		TEST( identiques, result );
+		xfree( marques );
+		xfree( attendues );
+		liberer_automate_indexe( automate );
+	}
+
+	for( int essai = 0; essai < 30; essai++ ){
+		// Construction des sous-ensembles : même numérotation que
+		// compiler_automate(), quel que soit le nombre de fils.
+		int nb_etats = 1 + alea( 12 );
+		Automate * automate = automate_aleatoire(
+			nb_etats, alea( 3 * nb_etats + 1 )
+		);
+		Automate_compile * attendu = compiler_automate( automate );
+		int identiques = 1;
+		for( int nb_fils = 1; nb_fils <= 6; nb_fils++ ){
+			Automate_compile * obtenu = compiler_automate_parallele(
+				automate, nb_fils
+			);
+			if(
+				obtenu->nb_etats != attendu->nb_etats
+				|| obtenu->nb_lettres != attendu->nb_lettres
+				|| obtenu->initial != attendu->initial
+				|| memcmp(
+					obtenu->transitions, attendu->transitions,
+					sizeof(int) * attendu->nb_etats * attendu->nb_lettres
+				)
+				|| memcmp( obtenu->finaux, attendu->finaux, attendu->nb_etats )
+			){
+				identiques = 0;
+			}
+			liberer_automate_compile( obtenu );
+		}
+		TEST( identiques, result );
+		liberer_automate_compile( attendu );
+		liberer_automate( automate );
+	}
+
+	{
+		// Sans état initial, l'automate compilé est vide.
+		Automate * automate = creer_automate();
+		ajouter_transition( automate, 1, 'a', 2 );
+		Automate_compile * compile = compiler_automate_parallele( automate, 2 );
+		TEST(
+			compile->nb_etats == 0 && compile->initial == ETAT_PUITS, result
+		);
+		liberer_automate_compile( compile );
+		liberer_automate( automate );
+	}
+
+	return result;
+}
+
+
+int main(){
+
+	initialiser_alea( 7 );
+	if( ! test_parallele() ){ return 1; };
+
+	return 0;
+	
+}
@@ -0,0 +1,143 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate.h"
+#include "automate_compile.h"
+#include "pipeline.h"
+#include "outils.h"
+#include "alea.h"
+
+#include <stdio.h>
+
+#define NB_MOTS 5000
+
+typedef struct Flot {
+	char ** mots;
+	int nb_mots;
+	int suivant;
+} Flot;
+
+static const char * lire_mot( void * data ){
+	Flot * flot = (Flot *) data;
+	if( flot->suivant == flot->nb_mots ){
+		return NULL;
+	}
+	return flot->mots[ flot->suivant++ ];
+}
+
+typedef struct Resultats {
+	int * reconnus;
+	char ** mots;
+	int nb_emis;
+	int coherent;
+} Resultats;
+
+static void noter_resultat( long indice, const char * mot, int reconnu, void * data ){
+	Resultats * resultats = (Resultats *) data;
+	if( resultats->reconnus[indice] != -1 || resultats->mots[indice] != mot ){
+		resultats->coherent = 0;
+	}
+	resultats->reconnus[indice] = reconnu;
+	resultats->nb_emis++;
+}
+
+int test_pipeline(){
+	int result = 1;
+
+	// Mots sur {a,b,c} dont le nombre de 'a' est pair.
+	Automate * automate = creer_automate();
+	ajouter_transition( automate, 0, 'a', 1 );
+	ajouter_transition( automate, 1, 'a', 0 );
+	ajouter_transition( automate, 0, 'b', 0 );
+	ajouter_transition( automate, 1, 'b', 1 );
+	ajouter_transition( automate, 0, 'c', 0 );
+	ajouter_transition( automate, 1, 'c', 1 );
+	ajouter_etat_initial( automate, 0 );
+	ajouter_etat_final( automate, 0 );
+	Automate_compile * compile = compiler_automate( automate );
+
+	char ** mots = xmalloc( sizeof(char *) * NB_MOTS );
+	int i;
+	for( i = 0; i < NB_MOTS; i++ ){
+		int longueur = alea( 12 );
+		mots[i] = xmalloc( longueur + 1 );
+		for( int j = 0; j < longueur; j++ ){
+			mots[i][j] = 'a' + alea( 3 );
+		}
+		mots[i][longueur] = '\0';
+	}
+	int * reconnus = xmalloc( sizeof(int) * NB_MOTS );
+
+	int nb_fils;
+	for( nb_fils = 1; nb_fils <= 4; nb_fils *= 2 ){
+		Flot flot = { mots, NB_MOTS, 0 };
+		Resultats resultats = { reconnus, mots, 0, 1 };
+		for( i = 0; i < NB_MOTS; i++ ){
+			reconnus[i] = -1;
+		}
+		long nb_traites = reconnaitre_en_pipeline(
+			compile, lire_mot, &flot, noter_resultat, &resultats, nb_fils
+		);
+		int corrects = 1;
+		for( i = 0; i < NB_MOTS; i++ ){
+			if( reconnus[i] != le_mot_est_reconnu( automate, mots[i] ) ){
+				corrects = 0;
+			}
+		}
+		TEST(
+			1
+			&& nb_traites == NB_MOTS
+			&& resultats.nb_emis == NB_MOTS
+			&& resultats.coherent
+			&& corrects
+			, result
+		);
+	}
+
+	{
+		// Flot vide.
+		Flot flot = { mots, 0, 0 };
+		Resultats resultats = { reconnus, mots, 0, 1 };
+		long nb_traites = reconnaitre_en_pipeline(
+			compile, lire_mot, &flot, noter_resultat, &resultats, 3
+		);
+		TEST( nb_traites == 0 && resultats.nb_emis == 0, result );
+	}
+
+	for( i = 0; i < NB_MOTS; i++ ){
+		xfree( mots[i] );
+	}
+	xfree( mots );
+	xfree( reconnus );
+	liberer_automate_compile( compile );
+	liberer_automate( automate );
+
+	return result;
+}
+
+
+int main(){
+
+	initialiser_alea( 17 );
+	if( ! test_pipeline() ){ return 1; };
+
+	return 0;
+	
+}
@@ -0,0 +1,144 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "ensemble.h"
+#include "ensemble_persistant.h"
+#include "pool_ensembles.h"
+#include "outils.h"
+
+int test_empreinte_ensemble(){
+	int result = 1;
+
+	{
+		// L'empreinte ne dépend que du contenu de l'ensemble.
+		Ensemble * ens1 = creer_ensemble( NULL, NULL, NULL );
+		Ensemble * ens2 = creer_ensemble( NULL, NULL, NULL );
+		int i;
+		for( i=0; i<50; i++ ){
+			ajouter_element( ens1, i );
+			ajouter_element( ens2, 49 - i );
+		}
+		ajouter_element( ens1, 10 );
+		ajouter_element( ens2, 100 );
+		retirer_element( ens2, 100 );
+		retirer_element( ens2, 1000 );
+		Ensemble_persistant * persistant = creer_ensemble_persistant( ens1 );
+		TEST(
+			1
+			&& empreinte_ensemble( ens1 ) == empreinte_ensemble( ens2 )
+			&& empreinte_ensemble( ens1 )
+				== empreinte_ensemble_persistant( persistant )
+			&& taille_ensemble( ens1 ) == 50
+			, result
+		);
+		liberer_ensemble_persistant( persistant );
+
+		Ensemble * vide = creer_ensemble( NULL, NULL, NULL );
+		retirer_element( ens2, 3 );
+		TEST( empreinte_ensemble( ens1 ) != empreinte_ensemble( ens2 ), result );
+		swap_ensemble( ens2, vide );
+		TEST(
+			1
+			&& empreinte_ensemble( ens2 ) == 0
+			&& taille_ensemble( ens2 ) == 0
+			&& taille_ensemble( vide ) == 49
+			, result
+		);
+		vider_ensemble( ens1 );
+		TEST( empreinte_ensemble( ens1 ) == 0, result );
+
+		liberer_ensemble( vide );
+		liberer_ensemble( ens1 );
+		liberer_ensemble( ens2 );
+	}
+
+	return result;
+}
+
+int test_pool_ensembles(){
+	int result = 1;
+
+	{
+		Pool_ensembles * pool = creer_pool_ensembles();
+		Ensemble * ens = creer_ensemble( NULL, NULL, NULL );
+		int nouveau;
+
+		int id_vide = interner_ensemble( pool, ens, &nouveau );
+		TEST( id_vide == 0 && nouveau, result );
+
+		// Les sous-ensembles de {0, ..., 9} de la forme {0, ..., i}, puis
+		// les mêmes ensembles construits dans l'autre sens.
+		int i, j;
+		for( i=0; i<10; i++ ){
+			ajouter_element( ens, i );
+			int id = interner_ensemble( pool, ens, &nouveau );
+			TEST( id == i + 1 && nouveau, result );
+		}
+		int identiques = 1;
+		for( i=0; i<10; i++ ){
+			Ensemble * autre = creer_ensemble( NULL, NULL, NULL );
+			for( j=i; j>=0; j-- ){
+				ajouter_element( autre, j );
+			}
+			int id = interner_ensemble( pool, autre, &nouveau );
+			if( id != i + 1 || nouveau || trouver_ensemble_pool( pool, autre ) != id ){
+				identiques = 0;
+			}
+			liberer_ensemble( autre );
+		}
+		TEST( identiques && taille_pool_ensembles( pool ) == 11, result );
+
+		// Le pool n'est pas affecté par les modifications de l'ensemble
+		// interné.
+		vider_ensemble( ens );
+		TEST(
+			1
+			&& trouver_ensemble_pool( pool, ens ) == id_vide
+			&& taille_ensemble( get_ensemble_pool( pool, 10 ) ) == 10
+			&& taille_ensemble( get_ensemble_pool( pool, id_vide ) ) == 0
+			, result
+		);
+		ajouter_element( ens, 42 );
+		TEST( trouver_ensemble_pool( pool, ens ) == -1, result );
+
+		// Beaucoup d'ensembles, pour agrandir la table.
+		for( i=0; i<1000; i++ ){
+			ajouter_element( ens, i );
+			interner_ensemble( pool, ens, NULL );
+		}
+		TEST( taille_pool_ensembles( pool ) == 11 + 1000 - 1, result );
+
+		liberer_ensemble( ens );
+		liberer_pool_ensembles( pool );
+	}
+
+	return result;
+}
+
+
+int main(){
+
+	if( ! test_empreinte_ensemble() ){ return 1; };
+	if( ! test_pool_ensembles() ){ return 1; };
+
+	return 0;
+	
+}
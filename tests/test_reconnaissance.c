@@ -0,0 +1,175 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "automate.h"
+#include "reconnaissance.h"
+#include "outils.h"
+#include "alea.h"
+
+typedef struct {
+	int nb;
+	int positions[32];
+} Positions;
+
+static void noter_position( int position, void * data ){
+	Positions * p = (Positions *) data;
+	p->positions[ p->nb++ ] = position;
+}
+
+int test_reconnaissance(){
+	int result = 1;
+
+	{
+		// Mots contenant "ab", avec un état mort (4) qui n'est pas
+		// co-accessible.
+		Automate * automate = creer_automate();
+		ajouter_transition( automate, 0, 'a', 0 );
+		ajouter_transition( automate, 0, 'b', 0 );
+		ajouter_transition( automate, 0, 'a', 1 );
+		ajouter_transition( automate, 1, 'b', 2 );
+		ajouter_transition( automate, 2, 'a', 2 );
+		ajouter_transition( automate, 2, 'b', 2 );
+		ajouter_transition( automate, 0, 'c', 4 );
+		ajouter_transition( automate, 4, 'a', 4 );
+		ajouter_etat_initial( automate, 0 );
+		ajouter_etat_final( automate, 2 );
+
+		Reconnaisseur * r = creer_reconnaisseur( automate );
+		int longueur = -1;
+		TEST(
+			1
+			&& reconnaitre_mot( r, "ab" )
+			&& reconnaitre_mot( r, "bbabaa" )
+			&& ! reconnaitre_mot( r, "ba" )
+			&& ! reconnaitre_mot( r, "" )
+			&& ! reconnaitre_mot( r, "caab" )
+			&& ! reconnaitre_mot( r, "abd" )
+			&& reconnaitre_prefixe( r, "bbabxyz", &longueur )
+			&& longueur == 4
+			&& ! reconnaitre_prefixe( r, "bba", NULL )
+			, result
+		);
+
+		Positions fins = { 0 }, debuts = { 0 };
+		int nb_fins = rechercher_fins( r, "xabaybab", noter_position, &fins );
+		int nb_debuts = rechercher_debuts( r, "xabaybab", noter_position, &debuts );
+		TEST(
+			1
+			&& nb_fins == 3 && fins.nb == 3
+			&& fins.positions[0] == 3
+			&& fins.positions[1] == 4
+			&& fins.positions[2] == 8
+			&& nb_debuts == 3 && debuts.nb == 3
+			&& debuts.positions[0] == 6
+			&& debuts.positions[1] == 5
+			&& debuts.positions[2] == 1
+			&& rechercher_fins( r, "xyz", NULL, NULL ) == 0
+			&& rechercher_debuts( r, "", NULL, NULL ) == 0
+			, result
+		);
+		liberer_reconnaisseur( r );
+		liberer_automate( automate );
+	}
+
+	{
+		// Comparaison avec le_mot_est_reconnu() sur des automates et des mots
+		// aléatoires.
+		int essai, i, identiques = 1;
+		for( essai=0; essai<50; essai++ ){
+			Automate * automate = creer_automate();
+			int n = 2 + alea( 8 );
+			for( i=0; i<2*n; i++ ){
+				ajouter_transition( automate, alea( n ), 'a' + alea( 3 ), alea( n ) );
+			}
+			ajouter_etat_initial( automate, alea( n ) );
+			ajouter_etat_initial( automate, alea( n ) );
+			ajouter_etat_final( automate, alea( n ) );
+			Reconnaisseur * r = creer_reconnaisseur( automate );
+			for( i=0; i<40; i++ ){
+				char mot[8];
+				int longueur = alea( 8 ), j;
+				for( j=0; j<longueur; j++ ){
+					mot[j] = 'a' + alea( 3 );
+				}
+				mot[longueur] = '\0';
+				if( reconnaitre_mot( r, mot ) != le_mot_est_reconnu( automate, mot ) ){
+					identiques = 0;
+				}
+				// Le plus court préfixe reconnu.
+				int attendu = -1, obtenu = -1;
+				for( j=0; j<=longueur && attendu == -1; j++ ){
+					char c = mot[j];
+					mot[j] = '\0';
+					if( le_mot_est_reconnu( automate, mot ) ) attendu = j;
+					mot[j] = c;
+				}
+				if( ! reconnaitre_prefixe( r, mot, &obtenu ) ) obtenu = -1;
+				if( obtenu != attendu ) identiques = 0;
+				// Les positions de fin et de début d'occurrence, comparées
+				// à une recherche naïve sur tous les facteurs du mot.
+				Positions fins = { 0 }, debuts = { 0 };
+				int fin[8] = { 0 }, debut[8] = { 0 }, d, f, k;
+				for( d=0; d<=longueur; d++ ){
+					for( f=d; f<=longueur; f++ ){
+						char facteur[8];
+						for( k=d; k<f; k++ ) facteur[k-d] = mot[k];
+						facteur[f-d] = '\0';
+						if( le_mot_est_reconnu( automate, facteur ) ){
+							fin[f] = 1;
+							debut[d] = 1;
+						}
+					}
+				}
+				rechercher_fins( r, mot, noter_position, &fins );
+				rechercher_debuts( r, mot, noter_position, &debuts );
+				k = 0;
+				for( f=0; f<=longueur; f++ ){
+					if( fin[f] && ( k >= fins.nb || fins.positions[k++] != f ) ){
+						identiques = 0;
+					}
+				}
+				if( k != fins.nb ) identiques = 0;
+				k = 0;
+				for( d=longueur; d>=0; d-- ){
+					if( debut[d] && ( k >= debuts.nb || debuts.positions[k++] != d ) ){
+						identiques = 0;
+					}
+				}
+				if( k != debuts.nb ) identiques = 0;
+			}
+			liberer_reconnaisseur( r );
+			liberer_automate( automate );
+		}
+		TEST( identiques, result );
+	}
+
+	return result;
+}
+
+
+int main(){
+
+	initialiser_alea( 11 );
+	if( ! test_reconnaissance() ){ return 1; };
+
+	return 0;
+	
+}
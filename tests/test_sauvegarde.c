@@ -0,0 +1,182 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "automate.h"
+#include "reconnaissance.h"
+#include "sauvegarde.h"
+#include "outils.h"
+#include "alea.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+/*
+ * Modifie l'octet d'un fichier qui se trouve à la position donnée, comptée
+ * comme pour fseek() à partir de 'origine'.
+ */
+static void corrompre( const char * fichier, long position, int origine ){
+	FILE * f = fopen( fichier, "r+b" );
+	fseek( f, position, origine );
+	int c = fgetc( f );
+	fseek( f, position, origine );
+	fputc( c ^ 0xFF, f );
+	fclose( f );
+}
+
+/*
+ * Positions, en partant du début, de champs de l'en-tête : lettres[] est à 
+ * l'octet 128 et indice_lettre[] à l'octet 384.
+ */
+#define POSITION_LETTRES 128
+#define POSITION_INDICE_LETTRE 384
+
+int test_sauvegarde(){
+	int result = 1;
+	char fichier[] = "/tmp/test_sauvegardeXXXXXX";
+	int fd = mkstemp( fichier );
+	close( fd );
+
+	{
+		Automate * automate = creer_automate();
+		int i, j, identiques = 1;
+		for( i=0; i<60; i++ ){
+			ajouter_transition( automate, 2 * alea( 20 ), 'a' + alea( 4 ), 2 * alea( 20 ) );
+		}
+		ajouter_etat_initial( automate, 0 );
+		ajouter_etat_initial( automate, 4 );
+		ajouter_etat_final( automate, 6 );
+		ajouter_etat_final( automate, 8 );
+
+		int sauve = sauver_automate( automate, fichier );
+		Automate_charge * charge = charger_automate( fichier );
+		TEST( sauve && charge, result );
+		if( ! charge ){
+			liberer_automate( automate );
+			unlink( fichier );
+			return result;
+		}
+
+		Automate_indexe * index = indexer_automate( automate );
+		indexer_inverse( index );
+		const Automate_indexe * vue = index_automate_charge( charge );
+		int nb_cases = index->nb_etats * index->nb_lettres;
+		TEST(
+			1
+			&& verifier_automate_charge( charge )
+			&& vue->nb_etats == index->nb_etats
+			&& vue->nb_transitions == index->nb_transitions
+			&& vue->nb_lettres == index->nb_lettres
+			&& memcmp( vue->lettres, index->lettres, index->nb_lettres ) == 0
+			&& memcmp( vue->etats, index->etats, sizeof(int) * index->nb_etats ) == 0
+			&& memcmp( vue->debut, index->debut, sizeof(int) * ( nb_cases + 1 ) ) == 0
+			&& memcmp( vue->fins, index->fins, sizeof(int) * index->nb_transitions ) == 0
+			&& memcmp( vue->origines, index->origines, sizeof(int) * index->nb_transitions ) == 0
+			&& memcmp( vue->finaux, index->finaux, index->nb_etats ) == 0
+			, result
+		);
+		liberer_automate_indexe( index );
+
+		// Le reconnaisseur de l'automate chargé reconnaît les mêmes mots.
+		Reconnaisseur * r = creer_reconnaisseur_indexe( vue );
+		for( i=0; i<200; i++ ){
+			char mot[8];
+			int longueur = alea( 8 );
+			for( j=0; j<longueur; j++ ){
+				mot[j] = 'a' + alea( 5 );
+			}
+			mot[longueur] = '\0';
+			if( reconnaitre_mot( r, mot ) != le_mot_est_reconnu( automate, mot ) ){
+				identiques = 0;
+			}
+		}
+		TEST( identiques, result );
+		liberer_reconnaisseur( r );
+		liberer_automate_charge( charge );
+
+		// Un octet modifié dans les tableaux est détecté par la somme de
+		// contrôle ; un fichier tronqué est refusé.
+		corrompre( fichier, -1, SEEK_END );
+		charge = charger_automate( fichier );
+		TEST( charge && ! verifier_automate_charge( charge ), result );
+		if( charge ) liberer_automate_charge( charge );
+		TEST( truncate( fichier, 100 ) == 0, result );
+		charge = charger_automate( fichier );
+		TEST( charge == NULL, result );
+
+		// La dernière borne de l'index inverse, qui précède le tableau des
+		// origines, doit valoir le nombre de transitions.
+		Automate_indexe * index_sauve = indexer_automate( automate );
+		long nb_transitions = index_sauve->nb_transitions;
+		long position =
+			( ( 4 * nb_transitions + 7 ) / 8 ) * 8
+			+ ( ( 4 * ( nb_cases + 1 ) + 7 ) / 8 ) * 8
+			- 4 * nb_cases;
+		liberer_automate_indexe( index_sauve );
+		TEST( sauver_automate( automate, fichier ), result );
+		corrompre( fichier, -position, SEEK_END );
+		charge = charger_automate( fichier );
+		TEST( charge == NULL, result );
+
+		// Un indice de lettre hors bornes est refusé au chargement ; l'en-tête
+		// est couvert par la somme de contrôle.
+		TEST( sauver_automate( automate, fichier ), result );
+		corrompre( fichier, POSITION_INDICE_LETTRE + 4 * 'a', SEEK_SET );
+		charge = charger_automate( fichier );
+		TEST( charge == NULL, result );
+		TEST( sauver_automate( automate, fichier ), result );
+		corrompre( fichier, POSITION_LETTRES + 200, SEEK_SET );
+		charge = charger_automate( fichier );
+		TEST( charge && ! verifier_automate_charge( charge ), result );
+		if( charge ) liberer_automate_charge( charge );
+		liberer_automate( automate );
+	}
+
+	{
+		// Un automate vide.
+		Automate * automate = creer_automate();
+		int sauve = sauver_automate( automate, fichier );
+		Automate_charge * charge = charger_automate( fichier );
+		TEST(
+			sauve && charge && verifier_automate_charge( charge )
+			&& index_automate_charge( charge )->nb_etats == 0
+			, result
+		);
+		if( charge ) liberer_automate_charge( charge );
+		liberer_automate( automate );
+	}
+
+	TEST( charger_automate( "/inexistant/automate" ) == NULL, result );
+	unlink( fichier );
+	return result;
+}
+
+
+int main(){
+
+	initialiser_alea( 29 );
+	if( ! test_sauvegarde() ){ return 1; };
+
+	return 0;
+	
+}
@@ -0,0 +1,213 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "automate.h"
+#include "automate_compile.h"
+#include "parallele.h"
+#include "statistiques.h"
+#include "outils.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * Une fonction de trace qui vérifie que les événements sont bien
+ * parenthésés.
+ */
+typedef struct Evenements {
+	int profondeur;
+	int profondeur_max;
+	int nb_debuts;
+	int nb_fins;
+	int bien_parenthese;
+} Evenements;
+
+static void compter_evenements(
+	const char * nom, char phase, uint64_t horodatage_ns,
+	const Statistiques_operation * statistiques, void * data
+){
+	Evenements * evenements = (Evenements *) data;
+	if( phase == 'B' ){
+		evenements->nb_debuts++;
+		evenements->profondeur++;
+		if( evenements->profondeur > evenements->profondeur_max ){
+			evenements->profondeur_max = evenements->profondeur;
+		}
+		if( statistiques ){
+			evenements->bien_parenthese = 0;
+		}
+	}else{
+		evenements->nb_fins++;
+		evenements->profondeur--;
+		if( ! statistiques || strcmp( statistiques->nom, nom ) ){
+			evenements->bien_parenthese = 0;
+		}
+	}
+	if( evenements->profondeur < 0 ){
+		evenements->bien_parenthese = 0;
+	}
+}
+
+static Automate * exemple(){
+	Automate * automate = creer_automate();
+	ajouter_transition( automate, 1, 'a', 2 );
+	ajouter_transition( automate, 2, 'b', 3 );
+	ajouter_transition( automate, 3, 'a', 1 );
+	ajouter_transition( automate, 4, 'a', 1 );
+	ajouter_etat_initial( automate, 1 );
+	ajouter_etat_final( automate, 3 );
+	return automate;
+}
+
+int test_statistiques(){
+	int result = 1;
+
+	Automate * automate = exemple();
+
+	{
+		// Sans activation, rien n'est mesuré.
+		Statistiques_operation s;
+		Automate * accessible = automate_accessible( automate );
+		lire_statistiques_operation( &s );
+		TEST( s.nom == NULL && s.etats_visites == 0, result );
+		liberer_automate( accessible );
+	}
+
+	{
+		activer_statistiques( 1 );
+		Statistiques_operation s;
+		Automate * accessible = automate_accessible( automate );
+		lire_statistiques_operation( &s );
+		TEST(
+			1
+			&& s.nom && strcmp( s.nom, "automate_accessible" ) == 0
+			&& s.etats_visites >= 3
+			&& s.transitions_parcourues >= 4
+			&& s.operations_ensembles > 0
+			&& s.sondes_arbres > 0
+			&& s.allocations > 0
+			, result
+		);
+		liberer_automate( accessible );
+
+		Automate * melange = creer_automate_du_melange( automate, automate );
+		lire_statistiques_operation( &s );
+		TEST(
+			1
+			&& strcmp( s.nom, "creer_automate_du_melange" ) == 0
+			&& s.etats_visites == 16
+			&& s.allocations > 0
+			, result
+		);
+		liberer_automate( melange );
+
+		Automate_compile * compile = compiler_automate( automate );
+		lire_statistiques_operation( &s );
+		TEST(
+			1
+			&& strcmp( s.nom, "compiler_automate" ) == 0
+			&& s.etats_visites == compile->nb_etats
+			, result
+		);
+		liberer_automate_compile( compile );
+
+		// Les compteurs des fils de travail s'ajoutent à ceux du fil
+		// appelant : chaque état de l'automate compilé est compté une fois.
+		Automate * n_ieme = creer_automate();
+		int i;
+		ajouter_transition( n_ieme, 0, 'a', 0 );
+		ajouter_transition( n_ieme, 0, 'b', 0 );
+		ajouter_transition( n_ieme, 0, 'a', 1 );
+		for( i=1; i<12; i++ ){
+			ajouter_transition( n_ieme, i, 'a', i+1 );
+			ajouter_transition( n_ieme, i, 'b', i+1 );
+		}
+		ajouter_etat_initial( n_ieme, 0 );
+		ajouter_etat_final( n_ieme, 12 );
+		compile = compiler_automate_parallele( n_ieme, 4 );
+		lire_statistiques_operation( &s );
+		TEST(
+			1
+			&& strcmp( s.nom, "compiler_automate_parallele" ) == 0
+			&& compile->nb_etats == 4096
+			&& s.etats_visites == compile->nb_etats
+			, result
+		);
+		liberer_automate_compile( compile );
+		liberer_automate( n_ieme );
+		activer_statistiques( 0 );
+	}
+
+	{
+		// Trace : les opérations imbriquées produisent des événements
+		// bien parenthésés.
+		Evenements evenements = { 0, 0, 0, 0, 1 };
+		definir_trace( compter_evenements, &evenements );
+		Automate * accessible = automate_accessible( automate );
+		definir_trace( NULL, NULL );
+		TEST(
+			1
+			&& evenements.bien_parenthese
+			&& evenements.profondeur == 0
+			&& evenements.profondeur_max == 2
+			&& evenements.nb_debuts == 2
+			&& evenements.nb_fins == 2
+			, result
+		);
+		liberer_automate( accessible );
+	}
+
+	{
+		// Trace au format de Chrome.
+		char * texte = NULL;
+		size_t taille = 0;
+		FILE * fichier = open_memstream( &texte, &taille );
+		commencer_trace_chrome( fichier );
+		Automate * m = miroir( automate );
+		terminer_trace_chrome();
+		fclose( fichier );
+		TEST(
+			1
+			&& texte[0] == '['
+			&& strstr( texte, "{\"name\":\"miroir\",\"ph\":\"B\"" )
+			&& strstr( texte, "{\"name\":\"miroir\",\"ph\":\"E\"" )
+			&& strstr( texte, "\"transitions_parcourues\":4" )
+			&& strstr( texte, "}\n]\n" )
+			, result
+		);
+		free( texte );
+		liberer_automate( m );
+	}
+
+	liberer_automate( automate );
+
+	return result;
+}
+
+
+int main(){
+
+	if( ! test_statistiques() ){ return 1; };
+
+	return 0;
+	
+}
@@ -395,6 +395,75 @@ int test_trouver_table(){
 	return result;
 }
 
+Valeur * copier_valeur( const Valeur * valeur ){
+	return creer_valeur( valeur->valeur );
+}
+
+int test_copier_table(){
+	int result = 1;
+	Table * table = creer_table(
+		( int(*)(const intptr_t, const intptr_t) ) comparer_cle,
+		( intptr_t (*)( const intptr_t ) ) copier_cle,
+		( void(*)(intptr_t) ) supprimer_cle
+	);
+	Cle cle;
+	int i;
+	for( i=0; i<100; i++ ){
+		initialiser_cle( &cle, (i*37)%100 );
+		add_table( table, (intptr_t) &cle, (intptr_t) creer_valeur( i ) );
+	}
+
+	Table * copie = copier_table(
+		table, ( intptr_t (*)( const intptr_t ) ) copier_valeur
+	);
+	Table * copie_simple = copier_table( table, NULL );
+
+	// La copie a les mêmes associations, et ses clés et valeurs sont
+	// indépendantes de celles de la table.
+	Table_iterateur it1, it2, it3;
+	int nb = 0;
+	for(
+		it1 = premier_iterateur_table( table ),
+		it2 = premier_iterateur_table( copie ),
+		it3 = premier_iterateur_table( copie_simple );
+		! iterateur_est_vide( it1 ) && ! iterateur_est_vide( it2 )
+		&& ! iterateur_est_vide( it3 );
+		it1 = iterateur_suivant_table( it1 ),
+		it2 = iterateur_suivant_table( it2 ),
+		it3 = iterateur_suivant_table( it3 )
+	){
+		const Cle * c1 = (const Cle *) get_cle( it1 );
+		const Cle * c2 = (const Cle *) get_cle( it2 );
+		const Valeur * v1 = (const Valeur *) get_valeur( it1 );
+		const Valeur * v2 = (const Valeur *) get_valeur( it2 );
+		TEST(
+			1
+			&& c1 != c2 && c1->cle == c2->cle && c1->cle == nb
+			&& v1 != v2 && v1->valeur == v2->valeur
+			&& get_valeur( it3 ) == (intptr_t) v1
+			, result
+		);
+		nb++;
+	}
+	TEST( nb == 100 && iterateur_est_vide( it2 ), result );
+
+	initialiser_cle( &cle, 1000 );
+	add_table( copie_simple, (intptr_t) &cle, (intptr_t) NULL );
+	TEST(
+		1
+		&& iterateur_est_vide( trouver_table( table, (intptr_t) &cle ) )
+		&& taille_table( copie_simple ) == 101
+		, result
+	);
+
+	pour_toute_valeur_table( table, ( void(*)(intptr_t) ) supprimer_valeur );
+	pour_toute_valeur_table( copie, ( void(*)(intptr_t) ) supprimer_valeur );
+	liberer_table( table );
+	liberer_table( copie );
+	liberer_table( copie_simple );
+	return result;
+}
+
 int test_get_cle(){
 	// Voir general_test
 	return 1;
@@ -420,6 +489,7 @@ int main(){
 	result &= test_pour_toute_valeur_table();
 	result &= test_pour_toute_cle_valeur_table();
 	result &= test_trouver_table();
+	result &= test_copier_table();
 	result &= test_get_cle();
 	result &= test_get_valeur();
 
@@ -0,0 +1,231 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "table_persistante.h"
+#include "statistiques.h"
+#include "outils.h"
+#include "alea.h"
+
+#define NB_VERSIONS 300
+#define NB_CLES 64
+
+/*
+ * Les valeurs sont des entiers alloués, pour vérifier que chaque valeur est
+ * libérée une seule fois.
+ */
+static intptr_t allouer_valeur( int n ){
+	int * res = xmalloc( sizeof(int) );
+	*res = n;
+	return (intptr_t) res;
+}
+
+static intptr_t copier_valeur( const intptr_t valeur ){
+	return allouer_valeur( *(int *) valeur );
+}
+
+static void liberer_valeur( intptr_t valeur ){
+	xfree( (int *) valeur );
+}
+
+/*
+ * Renvoie 1 si la version contient exactement les associations de 
+ * 'reference', où -1 signifie que la clé est absente.
+ */
+static int est_conforme( const Table_persistante * table, const int * reference ){
+	int i, n = 0;
+	for( i=0; i<NB_CLES; i++ ){
+		intptr_t valeur;
+		int present = trouver_table_persistante( table, i, &valeur );
+		if( present != ( reference[i] >= 0 ) ) return 0;
+		if( present && *(int *) valeur != reference[i] ) return 0;
+		n += present;
+	}
+	if( taille_table_persistante( table ) != n ) return 0;
+
+	Parcours_table_persistante parcours;
+	intptr_t cle, valeur, precedente = -1;
+	commencer_parcours_table_persistante( &parcours, table );
+	while( entree_suivante_table_persistante( &parcours, &cle, &valeur ) ){
+		if( cle <= precedente || *(int *) valeur != reference[cle] ) return 0;
+		precedente = cle;
+		n--;
+	}
+	if( n != 0 ) return 0;
+
+	// Un parcours commencé au rang r donne les entrées à partir de la 
+	// (r+1)-ième.
+	int rang;
+	for( rang=0; rang<=taille_table_persistante( table ); rang++ ){
+		commencer_parcours_table_persistante_au_rang( &parcours, table, rang );
+		n = rang;
+		for( i=0; i<NB_CLES; i++ ){
+			if( reference[i] < 0 ) continue;
+			if( n > 0 ){
+				n--;
+				continue;
+			}
+			if( 
+				! entree_suivante_table_persistante( &parcours, &cle, &valeur )
+				|| cle != i
+			) return 0;
+		}
+		if( entree_suivante_table_persistante( &parcours, &cle, &valeur ) ){
+			return 0;
+		}
+	}
+	return 1;
+}
+
+int test_table_persistante(){
+	int result = 1;
+
+	{
+		// Chaque version est dérivée d'une version plus ancienne, qui ne doit
+		// pas changer.
+		Table_persistante * versions[NB_VERSIONS];
+		int references[NB_VERSIONS][NB_CLES];
+		int i, j;
+		versions[0] = creer_table_persistante( copier_valeur, liberer_valeur );
+		for( j=0; j<NB_CLES; j++ ){
+			references[0][j] = -1;
+		}
+		for( i=1; i<NB_VERSIONS; i++ ){
+			int origine = alea( i );
+			int cle = alea( NB_CLES );
+			versions[i] = partager_table_persistante( versions[origine] );
+			for( j=0; j<NB_CLES; j++ ){
+				references[i][j] = references[origine][j];
+			}
+			intptr_t * valeur = modifier_valeur_table_persistante(
+				versions[i], cle
+			);
+			if( valeur && alea( 2 ) ){
+				*(int *) *valeur = i;
+			}else{
+				ajouter_table_persistante( versions[i], cle, allouer_valeur( i ) );
+			}
+			references[i][cle] = i;
+		}
+		int conformes = 1;
+		for( i=0; i<NB_VERSIONS; i++ ){
+			conformes = conformes && est_conforme( versions[i], references[i] );
+		}
+		TEST( conformes, result );
+		for( i=0; i<NB_VERSIONS; i++ ){
+			liberer_table_persistante( versions[i] );
+		}
+	}
+
+	{
+		// Une table qui n'est pas partagée est modifiée sur place ; une 
+		// écriture sur une version partagée ne copie que son chemin.
+		Table_persistante * table = creer_table_persistante( NULL, NULL );
+		int i;
+		for( i=0; i<10000; i++ ){
+			ajouter_table_persistante( table, i, i );
+		}
+		Statistiques_operation s;
+		Mesure_operation mesure;
+		activer_statistiques( 1 );
+
+		debut_operation( &mesure, "modifier" );
+		*modifier_valeur_table_persistante( table, 5000 ) = -1;
+		ajouter_table_persistante( table, 7000, -2 );
+		fin_operation( &mesure );
+		lire_statistiques_operation( &s );
+		unsigned long sur_place = s.allocations;
+
+		Table_persistante * version = partager_table_persistante( table );
+		debut_operation( &mesure, "copier" );
+		ajouter_table_persistante( version, 10000, 10000 );
+		fin_operation( &mesure );
+		lire_statistiques_operation( &s );
+		unsigned long copie = s.allocations;
+		activer_statistiques( 0 );
+
+		intptr_t v5000, v7000, v10000;
+		int present = trouver_table_persistante( table, 10000, &v10000 );
+		TEST(
+			1
+			&& sur_place == 0
+			&& copie > 0 && copie <= 2 * 16
+			&& ! present
+			&& trouver_table_persistante( version, 10000, &v10000 )
+			&& trouver_table_persistante( version, 5000, &v5000 )
+			&& trouver_table_persistante( version, 7000, &v7000 )
+			&& v5000 == -1 && v7000 == -2 && v10000 == 10000
+			&& taille_table_persistante( table ) == 10000
+			&& taille_table_persistante( version ) == 10001
+			&& modifier_valeur_table_persistante( version, -5 ) == NULL
+			, result
+		);
+		liberer_table_persistante( table );
+		liberer_table_persistante( version );
+	}
+
+	{
+		// Une copie ne partage aucun noeud : elle se modifie sur place, sans
+		// toucher à l'original.
+		Table_persistante * table = creer_table_persistante(
+			copier_valeur, liberer_valeur
+		);
+		int reference[NB_CLES];
+		int i;
+		for( i=0; i<NB_CLES; i++ ){
+			reference[i] = -1;
+		}
+		for( i=0; i<NB_CLES; i+=3 ){
+			ajouter_table_persistante( table, i, allouer_valeur( i ) );
+			reference[i] = i;
+		}
+		Table_persistante * copie = copier_table_persistante( table, NULL );
+		int conforme = est_conforme( copie, reference );
+
+		Statistiques_operation s;
+		Mesure_operation mesure;
+		activer_statistiques( 1 );
+		debut_operation( &mesure, "modifier_copie" );
+		*(int *) *modifier_valeur_table_persistante( copie, 3 ) = -3;
+		fin_operation( &mesure );
+		lire_statistiques_operation( &s );
+		activer_statistiques( 0 );
+
+		TEST(
+			1
+			&& conforme
+			&& s.allocations == 0
+			&& est_conforme( table, reference )
+			, result
+		);
+		liberer_table_persistante( table );
+		liberer_table_persistante( copie );
+	}
+
+	return result;
+}
+
+int main(){
+
+	initialiser_alea( 11 );
+	if( ! test_table_persistante() ){ return 1; };
+
+	return 0;
+	
+}
@@ -0,0 +1,111 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "automate.h"
+#include "outils.h"
+
+#include <limits.h>
+
+typedef struct {
+	const Automate * translate;
+	int nb_transitions;
+	int nb_trouvees;
+} Comptage_transitions;
+
+static void action_compter_transitions(
+	int origine, char lettre, int fin, void * data
+){
+	Comptage_transitions * comptage = (Comptage_transitions *) data;
+	comptage->nb_transitions++;
+	if(
+		est_une_transition_de_l_automate(
+			comptage->translate, origine, lettre, fin
+		)
+	){
+		comptage->nb_trouvees++;
+	}
+}
+
+int test_vue_automate(){
+	int result = 1;
+
+	{
+		Automate * automate = creer_automate();
+		ajouter_transition( automate, 1, 'a', 1 );
+		ajouter_transition( automate, 1, 'b', 2 );
+		ajouter_transition( automate, 2, 'a', 3 );
+		ajouter_etat_initial( automate, 1 );
+		ajouter_etat_final( automate, 3 );
+
+		Automate * autre = mot_to_automate( "abc" );
+		Vue_automate vue = vue_translatee( automate, autre );
+		Automate * translate = translater_automate( automate, autre );
+
+		TEST(
+			1
+			&& vue.automate == automate
+			&& vue.translation == 3
+			&& get_min_etat_vue( vue ) == get_min_etat( translate )
+			&& get_max_etat_vue( vue ) == get_max_etat( translate )
+			, result
+		);
+
+		Ensemble * depart = creer_ensemble( NULL, NULL, NULL );
+		ajouter_element( depart, 4 );
+		Ensemble * arrivee_vue = delta_vue( vue, depart, 'b' );
+		Ensemble * arrivee = delta( translate, depart, 'b' );
+		TEST( comparer_ensemble( arrivee_vue, arrivee ) == 0, result );
+		liberer_ensemble( arrivee_vue );
+		liberer_ensemble( arrivee );
+		liberer_ensemble( depart );
+
+		// Les transitions de la vue sont celles de la copie translatée.
+		Comptage_transitions comptage = { translate, 0, 0 };
+		pour_toute_transition_vue( vue, action_compter_transitions, &comptage );
+		TEST(
+			comptage.nb_transitions == 3 && comptage.nb_trouvees == 3, result
+		);
+
+		Vue_automate vue_vide = vue_automate( creer_automate(), 5 );
+		TEST(
+			1
+			&& get_max_etat_vue( vue_vide ) == INT_MIN
+			&& get_min_etat_vue( vue_vide ) == INT_MAX
+			, result
+		);
+		liberer_automate( (Automate *) vue_vide.automate );
+
+		liberer_automate( translate );
+		liberer_automate( autre );
+		liberer_automate( automate );
+	}
+
+	return result;
+}
+
+
+int main(){
+
+	if( ! test_vue_automate() ){ return 1; };
+
+	return 0;
+	
+}